@@ -0,0 +1,69 @@
+; Highlights (@keyword, @string, @function, ...), following the tree-sitter highlights conventions. When several
+; patterns capture the same node, the first one wins.
+
+(function_declarator declarator: (identifier) @function)
+(call_expression function: (identifier) @function)
+(call_expression function: (field_expression field: (field_identifier) @function.method))
+(preproc_function_def name: (identifier) @function.macro)
+(preproc_def name: (identifier) @constant.macro)
+
+[
+  (primitive_type)
+  (sized_type_specifier)
+  (type_identifier)
+] @type
+
+(field_identifier) @property
+(statement_identifier) @label
+
+(comment) @comment
+
+[
+  (string_literal)
+  (system_lib_string)
+  (char_literal)
+] @string
+
+(escape_sequence) @string.escape
+(number_literal) @number
+
+[
+  (true)
+  (false)
+] @boolean
+
+[
+  "#define"
+  "#elif"
+  "#else"
+  "#endif"
+  "#if"
+  "#ifdef"
+  "#ifndef"
+  "#include"
+] @keyword.directive
+
+[
+  "break"
+  "case"
+  "const"
+  "continue"
+  "default"
+  "do"
+  "else"
+  "enum"
+  "extern"
+  "for"
+  "goto"
+  "if"
+  "inline"
+  "return"
+  "sizeof"
+  "static"
+  "struct"
+  "switch"
+  "typedef"
+  "union"
+  "volatile"
+  "while"
+] @keyword
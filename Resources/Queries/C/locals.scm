@@ -0,0 +1,16 @@
+; Scopes, local definitions and references (@local.scope, @local.definition, @local.reference), following the
+; tree-sitter locals conventions.
+
+[
+  (function_definition)
+  (compound_statement)
+  (for_statement)
+] @local.scope
+
+(parameter_declaration declarator: (identifier) @local.definition)
+(parameter_declaration declarator: (pointer_declarator declarator: (identifier) @local.definition))
+(init_declarator declarator: (identifier) @local.definition)
+(init_declarator declarator: (pointer_declarator declarator: (identifier) @local.definition))
+(declaration declarator: (identifier) @local.definition)
+
+(identifier) @local.reference
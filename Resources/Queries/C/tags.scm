@@ -0,0 +1,22 @@
+; Symbol definitions, following the tree-sitter tagging conventions (@name + @definition.<kind>). Adapted from
+; tree-sitter-c.
+
+(struct_specifier
+  name: (type_identifier) @name
+  body: (_)) @definition.class
+
+(union_specifier
+  name: (type_identifier) @name
+  body: (_)) @definition.class
+
+(function_declarator
+  declarator: (identifier) @name) @definition.function
+
+(type_definition
+  declarator: (type_identifier) @name) @definition.type
+
+(enum_specifier
+  name: (type_identifier) @name) @definition.type
+
+(call_expression
+  function: (identifier) @name) @reference.call
@@ -0,0 +1,22 @@
+; Scopes, local definitions and references (@local.scope, @local.definition, @local.reference), following the
+; tree-sitter locals conventions.
+
+[
+  (function_definition)
+  (compound_statement)
+  (for_statement)
+  (for_range_loop)
+  (lambda_expression)
+] @local.scope
+
+(parameter_declaration declarator: (identifier) @local.definition)
+(parameter_declaration declarator: (pointer_declarator declarator: (identifier) @local.definition))
+(parameter_declaration declarator: (reference_declarator (identifier) @local.definition))
+(init_declarator declarator: (identifier) @local.definition)
+(init_declarator declarator: (pointer_declarator declarator: (identifier) @local.definition))
+(init_declarator declarator: (reference_declarator (identifier) @local.definition))
+(declaration declarator: (identifier) @local.definition)
+(for_range_loop declarator: (identifier) @local.definition)
+(for_range_loop declarator: (reference_declarator (identifier) @local.definition))
+
+(identifier) @local.reference
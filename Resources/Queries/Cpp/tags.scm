@@ -0,0 +1,33 @@
+; Symbol definitions and references, following the tree-sitter tagging conventions (@name + @definition.<kind> or
+; @reference.<kind>). Adapted from tree-sitter-cpp.
+
+(struct_specifier
+  name: (type_identifier) @name
+  body: (_)) @definition.class
+
+(class_specifier
+  name: (type_identifier) @name
+  body: (_)) @definition.class
+
+(function_declarator
+  declarator: (identifier) @name) @definition.function
+
+(function_declarator
+  declarator: (field_identifier) @name) @definition.function
+
+(function_declarator
+  declarator: (qualified_identifier
+    name: (identifier) @name)) @definition.method
+
+(type_definition
+  declarator: (type_identifier) @name) @definition.type
+
+(enum_specifier
+  name: (type_identifier) @name) @definition.type
+
+(call_expression
+  function: (identifier) @name) @reference.call
+
+(call_expression
+  function: (field_expression
+    field: (field_identifier) @name)) @reference.call
@@ -0,0 +1,76 @@
+; Highlights (@keyword, @string, @function, ...), following the tree-sitter highlights conventions. When several
+; patterns capture the same node, the first one wins.
+
+(function_declaration name: (identifier) @function)
+(generator_function_declaration name: (identifier) @function)
+(method_definition name: (property_identifier) @function.method)
+(call_expression function: (identifier) @function)
+(call_expression function: (member_expression property: (property_identifier) @function.method))
+
+(class_declaration name: (identifier) @type)
+(new_expression constructor: (identifier) @type)
+
+(property_identifier) @property
+
+[
+  (this)
+  (super)
+] @variable.builtin
+
+(comment) @comment
+
+[
+  (string)
+  (template_string)
+] @string
+
+(escape_sequence) @string.escape
+(regex) @string.regex
+(number) @number
+
+[
+  (true)
+  (false)
+] @boolean
+
+[
+  (null)
+  (undefined)
+] @constant.builtin
+
+[
+  "async"
+  "await"
+  "break"
+  "case"
+  "catch"
+  "class"
+  "const"
+  "continue"
+  "default"
+  "delete"
+  "do"
+  "else"
+  "export"
+  "extends"
+  "finally"
+  "for"
+  "function"
+  "if"
+  "import"
+  "in"
+  "instanceof"
+  "let"
+  "new"
+  "of"
+  "return"
+  "static"
+  "switch"
+  "throw"
+  "try"
+  "typeof"
+  "var"
+  "void"
+  "while"
+  "yield"
+] @keyword
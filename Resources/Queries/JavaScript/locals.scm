@@ -0,0 +1,26 @@
+; Scopes, local definitions and references (@local.scope, @local.definition, @local.reference), following the
+; tree-sitter locals conventions. Function and class names are left to tags.scm, being visible outside their scope.
+
+[
+  (statement_block)
+  (function_expression)
+  (arrow_function)
+  (function_declaration)
+  (generator_function_declaration)
+  (method_definition)
+  (for_statement)
+  (for_in_statement)
+  (catch_clause)
+] @local.scope
+
+(formal_parameters (identifier) @local.definition)
+(formal_parameters (assignment_pattern left: (identifier) @local.definition))
+(formal_parameters (rest_pattern (identifier) @local.definition))
+(arrow_function parameter: (identifier) @local.definition)
+(catch_clause parameter: (identifier) @local.definition)
+(variable_declarator name: (identifier) @local.definition)
+(import_clause (identifier) @local.definition)
+(namespace_import (identifier) @local.definition)
+(import_specifier (identifier) @local.definition)
+
+(identifier) @local.reference
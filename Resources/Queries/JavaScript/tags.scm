@@ -0,0 +1,39 @@
+; Symbol definitions and references, following the tree-sitter tagging conventions (@name + @definition.<kind> or
+; @reference.<kind>). Adapted from tree-sitter-javascript, predicates removed as they are not evaluated.
+
+(method_definition
+  name: (property_identifier) @name) @definition.method
+
+(class_declaration
+  name: (_) @name) @definition.class
+
+(function_declaration
+  name: (identifier) @name) @definition.function
+
+(generator_function_declaration
+  name: (identifier) @name) @definition.function
+
+(lexical_declaration
+  (variable_declarator
+    name: (identifier) @name
+    value: (arrow_function))) @definition.function
+
+(variable_declaration
+  (variable_declarator
+    name: (identifier) @name
+    value: (arrow_function))) @definition.function
+
+(assignment_expression
+  left: (member_expression
+    property: (property_identifier) @name)
+  right: (arrow_function)) @definition.function
+
+(call_expression
+  function: (identifier) @name) @reference.call
+
+(call_expression
+  function: (member_expression
+    property: (property_identifier) @name)) @reference.call
+
+(new_expression
+  constructor: (identifier) @name) @reference.class
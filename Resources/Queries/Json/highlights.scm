@@ -0,0 +1,17 @@
+; Highlights (@keyword, @string, @function, ...), following the tree-sitter highlights conventions. When several
+; patterns capture the same node, the first one wins.
+
+(pair key: (string) @property)
+
+(string) @string
+(escape_sequence) @string.escape
+(number) @number
+
+[
+  (true)
+  (false)
+] @boolean
+
+(null) @constant.builtin
+
+(comment) @comment
@@ -0,0 +1,8 @@
+; Same injections nvim-treesitter declares for markdown, minus the ones we have no grammar for
+
+(fenced_code_block
+  (info_string (language) @language)
+  (code_fence_content) @code)
+
+(inline) @inline
+(pipe_table_cell) @inline
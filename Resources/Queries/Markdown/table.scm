@@ -0,0 +1,6 @@
+; Pipe table cells, for FTreeSitterMarkdownTable. Rows are listed first, so that a row is captured before a cell
+; starting at the same byte.
+
+(pipe_table_header) @header
+(pipe_table_row) @row
+(pipe_table_cell) @cell
@@ -0,0 +1,62 @@
+; Highlights (@keyword, @string, @function, ...), following the tree-sitter highlights conventions. When several
+; patterns capture the same node, the first one wins.
+
+(function_definition name: (identifier) @function)
+(call function: (identifier) @function)
+(call function: (attribute attribute: (identifier) @function.method))
+(decorator) @function.decorator
+
+(class_definition name: (identifier) @type)
+
+(attribute attribute: (identifier) @property)
+
+(comment) @comment
+(string) @string
+(escape_sequence) @string.escape
+
+[
+  (integer)
+  (float)
+] @number
+
+[
+  (true)
+  (false)
+] @boolean
+
+(none) @constant.builtin
+
+[
+  "and"
+  "as"
+  "assert"
+  "async"
+  "await"
+  "break"
+  "class"
+  "continue"
+  "def"
+  "del"
+  "elif"
+  "else"
+  "except"
+  "finally"
+  "for"
+  "from"
+  "global"
+  "if"
+  "import"
+  "in"
+  "is"
+  "lambda"
+  "nonlocal"
+  "not"
+  "or"
+  "pass"
+  "raise"
+  "return"
+  "try"
+  "while"
+  "with"
+  "yield"
+] @keyword
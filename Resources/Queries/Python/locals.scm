@@ -0,0 +1,26 @@
+; Scopes, local definitions and references (@local.scope, @local.definition, @local.reference), following the
+; tree-sitter locals conventions. Function and class names are left to tags.scm, being visible outside their scope.
+
+[
+  (function_definition)
+  (lambda)
+  (class_definition)
+  (list_comprehension)
+  (set_comprehension)
+  (dictionary_comprehension)
+  (generator_expression)
+] @local.scope
+
+(parameters (identifier) @local.definition)
+(default_parameter name: (identifier) @local.definition)
+(typed_parameter (identifier) @local.definition)
+(typed_default_parameter name: (identifier) @local.definition)
+(list_splat_pattern (identifier) @local.definition)
+(dictionary_splat_pattern (identifier) @local.definition)
+(lambda_parameters (identifier) @local.definition)
+(assignment left: (identifier) @local.definition)
+(for_statement left: (identifier) @local.definition)
+(for_in_clause left: (identifier) @local.definition)
+(aliased_import alias: (identifier) @local.definition)
+
+(identifier) @local.reference
@@ -0,0 +1,15 @@
+; Symbol definitions and references, following the tree-sitter tagging conventions (@name + @definition.<kind> or
+; @reference.<kind>). Adapted from tree-sitter-python.
+
+(class_definition
+  name: (identifier) @name) @definition.class
+
+(function_definition
+  name: (identifier) @name) @definition.function
+
+(call
+  function: (identifier) @name) @reference.call
+
+(call
+  function: (attribute
+    attribute: (identifier) @name)) @reference.call
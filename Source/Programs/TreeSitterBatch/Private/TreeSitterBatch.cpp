@@ -0,0 +1,538 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformTime.h"
+#include "ITreeSitterModule.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "RequiredProgramMainCPPInclude.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryWriter.h"
+#include "TreeSitterFlatTree.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterMemory.h"
+#include "TreeSitterNode.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterTreeCache.h"
+#include "tree_sitter/api.h"
+
+IMPLEMENT_APPLICATION(TreeSitterBatch, "TreeSitterBatch");
+
+namespace UE::TreeSitter::Batch
+{
+	/** Exit codes, so that CI can tell invalid files apart from a broken invocation */
+	static constexpr int32 ExitSuccess = 0;
+	static constexpr int32 ExitSyntaxErrors = 1;
+	static constexpr int32 ExitFailure = 2;
+
+	/** Header of binary tree dumps, followed by the language name and one record per node in pre-order */
+	static constexpr uint32 BinaryDumpMagic = 0x54425354; // "TSBT"
+	static constexpr uint32 BinaryDumpVersion = 1;
+
+	enum class EDumpFormat : uint8
+	{
+		None,
+		SExpression,
+		Binary,
+	};
+
+	struct FBatchFile
+	{
+		FString Path;
+
+		/** Path relative to the directory it was found in, mirrored under the dump directory */
+		FString RelativePath;
+
+		ETreeSitterLanguage Language = ETreeSitterLanguage::Json;
+	};
+
+	struct FBatchSettings
+	{
+		TArray<FBatchFile> Files;
+		EDumpFormat DumpFormat = EDumpFormat::None;
+		FString DumpDirectory;
+		FString OutputPath;
+
+		/** Parse results cache, skipping the parse of files unchanged since a previous run */
+		FString CacheDirectory;
+
+		int32 MaxErrorsPerFile = 100;
+		bool bSingleThread = false;
+		bool bQuiet = false;
+	};
+
+	struct FSyntaxError
+	{
+		/** 1-based, column in characters */
+		int32 Line = 0;
+		int32 Column = 0;
+		FString Message;
+	};
+
+	struct FBatchResult
+	{
+		bool bRead = false;
+		bool bParsed = false;
+		bool bCached = false;
+		uint32 Bytes = 0;
+		uint32 NodeCount = 0;
+		double ParseMs = 0.0;
+
+		/** Capped to MaxErrorsPerFile, ErrorCount being the total */
+		TArray<FSyntaxError> Errors;
+		int32 ErrorCount = 0;
+	};
+
+	static void PrintUsage()
+	{
+		UE_LOG(LogTemp, Display, TEXT("Usage: TreeSitterBatch <files or directories...> [options]"));
+		UE_LOG(LogTemp, Display, TEXT("  -FileList=<path>      Text file with one path per line"));
+		UE_LOG(LogTemp, Display, TEXT("  -Language=<name>      Parse every file as the given language (Json, Cpp, Python...) instead of by extension"));
+		UE_LOG(LogTemp, Display, TEXT("  -Output=<path.json>   Writes per-file stats and error locations"));
+		UE_LOG(LogTemp, Display, TEXT("  -Dump=SExpression|Binary -DumpDir=<path>   Writes the tree of every file"));
+		UE_LOG(LogTemp, Display, TEXT("  -Cache=<path>         Reuses the trees of files parsed by a previous run (not for S-expression dumps)"));
+		UE_LOG(LogTemp, Display, TEXT("  -MaxErrors=<count>    Error locations reported per file (100)"));
+		UE_LOG(LogTemp, Display, TEXT("  -SingleThread -Quiet"));
+	}
+
+	static void AddFile(FBatchSettings& InOutSettings, const FString& InPath, const FString& InRelativePath, const TOptional<ETreeSitterLanguage>& InLanguage)
+	{
+		FBatchFile File;
+		File.Path = InPath;
+		File.RelativePath = InRelativePath;
+
+		if (InLanguage.IsSet())
+		{
+			File.Language = InLanguage.GetValue();
+		}
+		else if (!FindLanguageForExtension(FPaths::GetExtension(InPath), File.Language))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: unknown language, skipped"), *InPath);
+			return;
+		}
+
+		InOutSettings.Files.Add(MoveTemp(File));
+	}
+
+	static void AddPath(FBatchSettings& InOutSettings, const FString& InPath, const TOptional<ETreeSitterLanguage>& InLanguage)
+	{
+		if (!IFileManager::Get().DirectoryExists(*InPath))
+		{
+			AddFile(InOutSettings, InPath, FPaths::GetCleanFilename(InPath), InLanguage);
+			return;
+		}
+
+		TArray<FString> Found;
+		IFileManager::Get().FindFilesRecursive(Found, *InPath, TEXT("*.*"), true, false);
+		Found.Sort();
+
+		for (const FString& Path : Found)
+		{
+			// Directories are always filtered by extension, a forced language only restricts them
+			ETreeSitterLanguage Language;
+			if (!FindLanguageForExtension(FPaths::GetExtension(Path), Language) || (InLanguage.IsSet() && InLanguage.GetValue() != Language))
+			{
+				continue;
+			}
+
+			FString RelativePath = Path;
+			FPaths::MakePathRelativeTo(RelativePath, *(InPath / TEXT("")));
+			AddFile(InOutSettings, Path, RelativePath, Language);
+		}
+	}
+
+	static bool ParseSettings(const TCHAR* InCommandLine, FBatchSettings& OutSettings)
+	{
+		TOptional<ETreeSitterLanguage> ForcedLanguage;
+		FString LanguageName;
+		if (FParse::Value(InCommandLine, TEXT("Language="), LanguageName))
+		{
+			ETreeSitterLanguage Language;
+			if (!FindLanguageByName(LanguageName, Language))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Unknown language '%s'"), *LanguageName);
+				return false;
+			}
+			ForcedLanguage = Language;
+		}
+
+		FString DumpFormat;
+		if (FParse::Value(InCommandLine, TEXT("Dump="), DumpFormat))
+		{
+			if (DumpFormat.Equals(TEXT("SExpression"), ESearchCase::IgnoreCase))
+			{
+				OutSettings.DumpFormat = EDumpFormat::SExpression;
+			}
+			else if (DumpFormat.Equals(TEXT("Binary"), ESearchCase::IgnoreCase))
+			{
+				OutSettings.DumpFormat = EDumpFormat::Binary;
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("Unknown dump format '%s'"), *DumpFormat);
+				return false;
+			}
+
+			if (!FParse::Value(InCommandLine, TEXT("DumpDir="), OutSettings.DumpDirectory))
+			{
+				UE_LOG(LogTemp, Error, TEXT("-Dump requires -DumpDir"));
+				return false;
+			}
+		}
+
+		FParse::Value(InCommandLine, TEXT("Output="), OutSettings.OutputPath);
+		FParse::Value(InCommandLine, TEXT("Cache="), OutSettings.CacheDirectory);
+		FParse::Value(InCommandLine, TEXT("MaxErrors="), OutSettings.MaxErrorsPerFile);
+		OutSettings.bSingleThread = FParse::Param(InCommandLine, TEXT("SingleThread"));
+		OutSettings.bQuiet = FParse::Param(InCommandLine, TEXT("Quiet"));
+
+		TArray<FString> Tokens;
+		TArray<FString> Switches;
+		FCommandLine::Parse(InCommandLine, Tokens, Switches);
+
+		FString FileList;
+		if (FParse::Value(InCommandLine, TEXT("FileList="), FileList))
+		{
+			TArray<FString> Lines;
+			if (!FFileHelper::LoadFileToStringArray(Lines, *FileList))
+			{
+				UE_LOG(LogTemp, Error, TEXT("Failed to read file list %s"), *FileList);
+				return false;
+			}
+
+			for (const FString& Line : Lines)
+			{
+				const FString Path = Line.TrimStartAndEnd();
+				if (!Path.IsEmpty())
+				{
+					Tokens.Add(Path);
+				}
+			}
+		}
+
+		for (const FString& Token : Tokens)
+		{
+			AddPath(OutSettings, Token, ForcedLanguage);
+		}
+
+		return !OutSettings.Files.IsEmpty();
+	}
+
+	static FSyntaxError MakeSyntaxError(const uint32 InStartByte, const uint32 InEndByte, const TSPoint InStartPoint, const bool bInMissing, const char* InType, const FTreeSitterSource& InSource)
+	{
+		FSyntaxError Error;
+		Error.Line = static_cast<int32>(InStartPoint.row) + 1;
+		Error.Column = InSource.GetCharIndex(InStartByte) - InSource.GetCharIndex(InStartByte - InStartPoint.column) + 1;
+
+		if (bInMissing)
+		{
+			Error.Message = FString::Printf(TEXT("missing %s"), UTF8_TO_TCHAR(InType));
+		}
+		else
+		{
+			FString Unexpected(InSource.GetView(InStartByte, InEndByte).Left(32));
+			Unexpected.ReplaceCharWithEscapedCharInline();
+			Error.Message = FString::Printf(TEXT("unexpected '%s'"), *Unexpected);
+		}
+
+		return Error;
+	}
+
+	static FSyntaxError MakeSyntaxError(const TSNode& InNode, const FTreeSitterSource& InSource)
+	{
+		return MakeSyntaxError(ts_node_start_byte(InNode), ts_node_end_byte(InNode), ts_node_start_point(InNode), ts_node_is_missing(InNode), ts_node_type(InNode), InSource);
+	}
+
+	static FSyntaxError MakeSyntaxError(const FTreeSitterFlatNode& InNode, const FTreeSitterFlatTree& InTree, const FTreeSitterSource& InSource)
+	{
+		const TSPoint StartPoint = { InNode.StartRow, InNode.StartColumn };
+		return MakeSyntaxError(InNode.StartByte, InNode.EndByte, StartPoint, InNode.IsMissing(), InTree.GetNodeType(InNode), InSource);
+	}
+
+	static bool WriteBinaryDump(const FTreeSitterFlatTree& InTree, const ETreeSitterLanguage InLanguage, const FString& InPath)
+	{
+		const TConstArrayView<FTreeSitterFlatNode> Nodes = InTree.GetNodes();
+
+		TArray<uint8> Buffer;
+		FMemoryWriter Writer(Buffer);
+
+		uint32 Magic = BinaryDumpMagic;
+		uint32 Version = BinaryDumpVersion;
+		uint32 NodeCount = Nodes.Num();
+		FString LanguageName = GetLanguageName(InLanguage);
+		Writer << Magic << Version << NodeCount << LanguageName;
+
+		for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+		{
+			const FTreeSitterFlatNode& Node = Nodes[Index];
+
+			// Children follow their parent, each one after the subtree of the previous
+			uint32 ChildCount = 0;
+			for (int32 ChildIndex = Index + 1; ChildIndex < Index + static_cast<int32>(Node.SubtreeSize); ChildIndex += Nodes[ChildIndex].SubtreeSize)
+			{
+				++ChildCount;
+			}
+
+			uint16 Symbol = Node.Symbol;
+			uint16 FieldId = Node.FieldId;
+			uint8 Flags = static_cast<uint8>(Node.Flags & (ETreeSitterFlatNodeFlags::Named | ETreeSitterFlatNodeFlags::Missing | ETreeSitterFlatNodeFlags::Extra | ETreeSitterFlatNodeFlags::Error));
+			uint32 StartByte = Node.StartByte;
+			uint32 EndByte = Node.EndByte;
+			Writer << Symbol << FieldId << Flags << StartByte << EndByte << ChildCount;
+		}
+
+		return FFileHelper::SaveArrayToFile(Buffer, *InPath);
+	}
+
+	static bool WriteDump(const TSTree* InTree, const FTreeSitterFlatTree* InFlatTree, const FTreeSitterSource& InSource, const FBatchFile& InFile, const FBatchSettings& InSettings)
+	{
+		if (InSettings.DumpFormat == EDumpFormat::SExpression)
+		{
+			char* SExpression = ts_node_string(ts_tree_root_node(InTree));
+			const bool bSaved = FFileHelper::SaveStringToFile(
+				FString(UTF8_TO_TCHAR(SExpression)),
+				*(InSettings.DumpDirectory / InFile.RelativePath + TEXT(".sexp")),
+				FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM
+			);
+			UE::TreeSitter::Free(SExpression);
+			return bSaved;
+		}
+
+		if (InSettings.DumpFormat == EDumpFormat::Binary)
+		{
+			return WriteBinaryDump(InFlatTree ? *InFlatTree : *FTreeSitterFlatTree::Build(InTree, InSource), InFile.Language, InSettings.DumpDirectory / InFile.RelativePath + TEXT(".tsbt"));
+		}
+
+		return true;
+	}
+
+	static void ParseFile(const FBatchFile& InFile, const TSLanguage* InLanguage, const FBatchSettings& InSettings, const FTreeSitterTreeCache* InCache, FBatchResult& OutResult)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *InFile.Path))
+		{
+			return;
+		}
+		OutResult.bRead = true;
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(MoveTemp(Text));
+		OutResult.Bytes = Source->GetUTF8Length();
+
+		// S-expressions are printed by tree-sitter, out of a real tree
+		const bool bUseCache = InCache && InSettings.DumpFormat != EDumpFormat::SExpression;
+		const uint64 ContentHash = bUseCache ? FTreeSitterTreeCache::HashContent(*Source) : 0;
+
+		const double StartTime = FPlatformTime::Seconds();
+		TSharedPtr<const FTreeSitterFlatTree> FlatTree = bUseCache ? InCache->Find(InFile.Language, ContentHash) : nullptr;
+		OutResult.bCached = FlatTree.IsValid();
+
+		TSTree* Tree = nullptr;
+		if (!FlatTree.IsValid())
+		{
+			const FTreeSitterPooledParser Parser(InLanguage);
+			Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+			if (!Tree)
+			{
+				return;
+			}
+
+			if (bUseCache)
+			{
+				FlatTree = FTreeSitterFlatTree::Build(Tree, *Source);
+				if (!InCache->Store(InFile.Language, ContentHash, *FlatTree))
+				{
+					UE_LOG(LogTemp, Warning, TEXT("%s: failed to store the tree in the cache"), *InFile.Path);
+				}
+			}
+		}
+		OutResult.ParseMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		OutResult.bParsed = true;
+
+		if (FlatTree.IsValid())
+		{
+			OutResult.NodeCount = FlatTree->GetNodes().Num();
+			FlatTree->ForEachSyntaxError([&FlatTree, &Source, &InSettings, &OutResult](const FTreeSitterFlatNode& InNode)
+			{
+				if (OutResult.ErrorCount++ < InSettings.MaxErrorsPerFile)
+				{
+					OutResult.Errors.Add(MakeSyntaxError(InNode, *FlatTree, *Source));
+				}
+			});
+		}
+		else
+		{
+			const TSNode Root = ts_tree_root_node(Tree);
+			OutResult.NodeCount = ts_node_descendant_count(Root);
+			ForEachSyntaxError(Root, [&Source, &InSettings, &OutResult](const TSNode& InNode)
+			{
+				if (OutResult.ErrorCount++ < InSettings.MaxErrorsPerFile)
+				{
+					OutResult.Errors.Add(MakeSyntaxError(InNode, *Source));
+				}
+			});
+		}
+
+		if (!WriteDump(Tree, FlatTree.Get(), *Source, InFile, InSettings))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s: failed to write the tree dump"), *InFile.Path);
+		}
+
+		if (Tree)
+		{
+			ts_tree_delete(Tree);
+		}
+	}
+
+	static bool WriteReport(const FBatchSettings& InSettings, const TArray<FBatchResult>& InResults, const double InTotalSeconds)
+	{
+		TArray<TSharedPtr<FJsonValue>> Files;
+		for (int32 Index = 0; Index < InResults.Num(); ++Index)
+		{
+			const FBatchFile& File = InSettings.Files[Index];
+			const FBatchResult& Result = InResults[Index];
+
+			const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("Path"), File.Path);
+			Object->SetStringField(TEXT("Language"), GetLanguageName(File.Language));
+			Object->SetBoolField(TEXT("Parsed"), Result.bParsed);
+			Object->SetBoolField(TEXT("Cached"), Result.bCached);
+			Object->SetNumberField(TEXT("Bytes"), Result.Bytes);
+			Object->SetNumberField(TEXT("Nodes"), Result.NodeCount);
+			Object->SetNumberField(TEXT("ParseMs"), Result.ParseMs);
+			Object->SetNumberField(TEXT("ErrorCount"), Result.ErrorCount);
+
+			TArray<TSharedPtr<FJsonValue>> Errors;
+			for (const FSyntaxError& Error : Result.Errors)
+			{
+				const TSharedRef<FJsonObject> ErrorObject = MakeShared<FJsonObject>();
+				ErrorObject->SetNumberField(TEXT("Line"), Error.Line);
+				ErrorObject->SetNumberField(TEXT("Column"), Error.Column);
+				ErrorObject->SetStringField(TEXT("Message"), Error.Message);
+				Errors.Add(MakeShared<FJsonValueObject>(ErrorObject));
+			}
+			Object->SetArrayField(TEXT("Errors"), Errors);
+
+			Files.Add(MakeShared<FJsonValueObject>(Object));
+		}
+
+		const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("TotalSeconds"), InTotalSeconds);
+		Root->SetArrayField(TEXT("Files"), Files);
+
+		FString Output;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		return FJsonSerializer::Serialize(Root, Writer) && FFileHelper::SaveStringToFile(Output, *InSettings.OutputPath);
+	}
+
+	static int32 Run(const TCHAR* InCommandLine)
+	{
+		FBatchSettings Settings;
+		if (!ParseSettings(InCommandLine, Settings))
+		{
+			PrintUsage();
+			return ExitFailure;
+		}
+
+		// Grammars are loaded up front on this thread, workers only borrow parsers
+		TMap<ETreeSitterLanguage, const TSLanguage*> Languages;
+		for (const FBatchFile& File : Settings.Files)
+		{
+			if (!Languages.Contains(File.Language))
+			{
+				ITreeSitterModule::FGetLanguageParser* GetLanguage = ITreeSitterModule::Get().GetLanguageParser(File.Language);
+				Languages.Add(File.Language, GetLanguage ? GetLanguage() : nullptr);
+			}
+		}
+
+		TOptional<FTreeSitterTreeCache> Cache;
+		if (!Settings.CacheDirectory.IsEmpty())
+		{
+			Cache.Emplace(Settings.CacheDirectory);
+		}
+
+		TArray<FBatchResult> Results;
+		Results.SetNum(Settings.Files.Num());
+
+		const double StartTime = FPlatformTime::Seconds();
+		ParallelFor(Settings.Files.Num(), [&Settings, &Languages, &Cache, &Results](const int32 Index)
+		{
+			if (const TSLanguage* Language = Languages.FindRef(Settings.Files[Index].Language))
+			{
+				ParseFile(Settings.Files[Index], Language, Settings, Cache.GetPtrOrNull(), Results[Index]);
+			}
+		}, Settings.bSingleThread ? EParallelForFlags::ForceSingleThread : EParallelForFlags::Unbalanced);
+		const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+		int32 ExitCode = ExitSuccess;
+		int64 TotalBytes = 0;
+		int32 InvalidFileCount = 0;
+		int32 CachedFileCount = 0;
+		for (int32 Index = 0; Index < Results.Num(); ++Index)
+		{
+			const FBatchFile& File = Settings.Files[Index];
+			const FBatchResult& Result = Results[Index];
+			TotalBytes += Result.Bytes;
+			CachedFileCount += Result.bCached ? 1 : 0;
+
+			if (!Result.bParsed)
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s: %s"), *File.Path, Result.bRead ? TEXT("failed to parse") : TEXT("failed to read"));
+				ExitCode = ExitFailure;
+				continue;
+			}
+
+			if (!Settings.bQuiet)
+			{
+				UE_LOG(LogTemp, Display, TEXT("%s: %s, %u bytes, %u nodes, %.3f ms%s, %d errors"), *File.Path, GetLanguageName(File.Language), Result.Bytes, Result.NodeCount, Result.ParseMs, Result.bCached ? TEXT(" (cached)") : TEXT(""), Result.ErrorCount);
+			}
+
+			// file:line:column: error: message, as compilers report them so that CI annotates the files
+			for (const FSyntaxError& Error : Result.Errors)
+			{
+				UE_LOG(LogTemp, Display, TEXT("%s:%d:%d: error: %s"), *File.Path, Error.Line, Error.Column, *Error.Message);
+			}
+
+			if (Result.ErrorCount > 0)
+			{
+				++InvalidFileCount;
+				ExitCode = FMath::Max(ExitCode, ExitSyntaxErrors);
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("Parsed %d files (%lld bytes, %d from cache) in %.3f s, %d with syntax errors"), Results.Num(), TotalBytes, CachedFileCount, TotalSeconds, InvalidFileCount);
+
+		if (!Settings.OutputPath.IsEmpty() && !WriteReport(Settings, Results, TotalSeconds))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write report %s"), *Settings.OutputPath);
+			ExitCode = ExitFailure;
+		}
+
+		return ExitCode;
+	}
+}
+
+INT32_MAIN_INT32_ARGC_TCHAR_ARGV()
+{
+	FTaskTagScope Scope(ETaskTag::EGameThread);
+	ON_SCOPE_EXIT
+	{
+		RequestEngineExit(TEXT("TreeSitterBatch exiting"));
+		FEngineLoop::AppPreExit();
+		FModuleManager::Get().UnloadModulesAtShutdown();
+		FEngineLoop::AppExit();
+	};
+
+	if (const int32 Result = GEngineLoop.PreInit(ArgC, ArgV))
+	{
+		return Result;
+	}
+
+	UE::TreeSitter::InstallAllocator();
+	return UE::TreeSitter::Batch::Run(FCommandLine::Get());
+}
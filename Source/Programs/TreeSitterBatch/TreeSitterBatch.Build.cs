@@ -0,0 +1,23 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class TreeSitterBatch : ModuleRules
+{
+	public TreeSitterBatch(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicIncludePathModuleNames.Add("Launch");
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Json",
+				"Projects",
+				"TreeSitter",
+				"TreeSitterLibrary",
+			}
+		);
+	}
+}
@@ -0,0 +1,27 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+using UnrealBuildTool;
+
+[SupportedPlatforms(UnrealPlatformClass.Desktop)]
+public class TreeSitterBatchTarget : TargetRules
+{
+	public TreeSitterBatchTarget(TargetInfo Target) : base(Target)
+	{
+		Type = TargetType.Program;
+		LinkType = TargetLinkType.Monolithic;
+		LaunchModuleName = "TreeSitterBatch";
+
+		DefaultBuildSettings = BuildSettingsVersion.Latest;
+		IncludeOrderVersion = EngineIncludeOrderVersion.Latest;
+
+		// Headless console program: only Core, CoreUObject (for the language enum) and the TreeSitter runtime core
+		bIsBuildingConsoleApplication = true;
+		bBuildDeveloperTools = false;
+		bCompileAgainstEngine = false;
+		bCompileAgainstCoreUObject = true;
+		bCompileAgainstApplicationCore = false;
+		bCompileICU = false;
+		bCompileWithPluginSupport = false;
+		bUseLoggingInShipping = true;
+	}
+}
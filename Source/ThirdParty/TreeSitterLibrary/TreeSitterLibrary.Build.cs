@@ -36,18 +36,38 @@ public class TreeSitterLibrary : ModuleRules
 		{
 			PublicAdditionalLibraries.Add(Path.Combine(ModuleDirectory, "Win64", "static", "lib", "tree-sitter.lib"));
 		}
+		else if (Target.Platform == UnrealTargetPlatform.Linux)
+		{
+			// Built from the same tree-sitter version with the engine clang toolchain (see readme), not checked in
+			PublicAdditionalLibraries.Add(Path.Combine(ModuleDirectory, "Linux", "static", "lib", "libtree-sitter.a"));
+		}
 		
 		// Load additional parsers libraries
 		if (Target.Platform == UnrealTargetPlatform.Win64)
 		{
 			// Ensure that the DLL is staged along with the executable
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-c.dll"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-cpp.dll"));
 			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-javascript.dll"));
 			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-json.dll"));
 			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-markdown-inline.dll"));
 			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-markdown.dll"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-python.dll"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Win64", "languages", "libtree-sitter-yaml.dll"));
 			
 			// Delay-load the DLL, so we can load it from the right place first
 			// PublicDelayLoadDLLs.Add("libtree-sitter-markdown.dll");
 		}
+		else if (Target.Platform == UnrealTargetPlatform.Linux)
+		{
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-c.so"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-cpp.so"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-javascript.so"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-json.so"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-markdown-inline.so"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-markdown.so"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-python.so"));
+			RuntimeDependencies.Add(Path.Combine(ModuleDirectory, "Linux", "languages", "libtree-sitter-yaml.so"));
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterDiff.h"
+#include "TreeSitterFlatTree.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterDiffSpec, "TreeSitter.TreeSitterDiff", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TSharedPtr<FTreeSitterParser> Parser;
+
+	void RunDiff(const FString& InOldText, const FString& InNewText, FTreeSitterTreeDiff& OutDiff) const
+	{
+		const TSharedRef<const FTreeSitterSource> OldSource = FTreeSitterSource::Create(InOldText);
+		const TSharedRef<const FTreeSitterSource> NewSource = FTreeSitterSource::Create(InNewText);
+		TSTree* OldTree = Parser->Parse(OldSource->GetUTF8(), OldSource->GetUTF8Length());
+		TSTree* NewTree = Parser->Parse(NewSource->GetUTF8(), NewSource->GetUTF8Length());
+
+		UE::TreeSitter::DiffTrees(OldTree, *OldSource, NewTree, *NewSource, OutDiff);
+
+		ts_tree_delete(OldTree);
+		ts_tree_delete(NewTree);
+	}
+
+	/** Checks for a single edit of the given operation, on a node of the given type */
+	void TestSingleEdit(const FTreeSitterTreeDiff& InDiff, const ETreeSitterDiffOperation InOperation, const char* InNodeType)
+	{
+		if (!TestEqual("Edit count", InDiff.Edits.Num(), 1))
+		{
+			return;
+		}
+
+		const FTreeSitterDiffEdit& Edit = InDiff.Edits[0];
+		TestTrue("Operation", Edit.Operation == InOperation);
+
+		const bool bInOldTree = InOperation == ETreeSitterDiffOperation::Delete;
+		const FTreeSitterFlatTree& Tree = bInOldTree ? *InDiff.OldTree : *InDiff.NewTree;
+		const int32 NodeIndex = bInOldTree ? Edit.OldNode : Edit.NewNode;
+		TestEqual("Node type", FString(UTF8_TO_TCHAR(Tree.GetNodeType(Tree.GetNodes()[NodeIndex]))), FString(UTF8_TO_TCHAR(InNodeType)));
+	}
+
+END_DEFINE_SPEC(FTreeSitterDiffSpec)
+
+void FTreeSitterDiffSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Parser = MakeShared<FTreeSitterParser>();
+		Parser->SetLanguage(ETreeSitterLanguage::Json);
+	});
+
+	AfterEach([this]()
+	{
+		Parser.Reset();
+	});
+
+	It("should report nothing for reformatted documents", [this]()
+	{
+		FTreeSitterTreeDiff Diff;
+		RunDiff(TEXT("{\"a\": [1, 2], \"b\": {\"c\": null}}"), TEXT("{\n  \"a\": [1,2],\n  \"b\": {\"c\": null}\n}\n"), Diff);
+		TestEqual("Edit count", Diff.Edits.Num(), 0);
+	});
+
+	It("should update changed values", [this]()
+	{
+		FTreeSitterTreeDiff Diff;
+		RunDiff(TEXT("{\"a\": 1, \"b\": [1, 2]}"), TEXT("{\"a\": 2, \"b\": [1, 2]}"), Diff);
+		TestSingleEdit(Diff, ETreeSitterDiffOperation::Update, "number");
+	});
+
+	It("should insert new subtrees as a whole", [this]()
+	{
+		FTreeSitterTreeDiff Diff;
+		RunDiff(TEXT("[1, 2]"), TEXT("[1, 2, {\"x\": [3]}]"), Diff);
+		TestSingleEdit(Diff, ETreeSitterDiffOperation::Insert, "object");
+	});
+
+	It("should delete removed subtrees as a whole", [this]()
+	{
+		FTreeSitterTreeDiff Diff;
+		RunDiff(TEXT("[1, {\"x\": [3]}, 2]"), TEXT("[1, 2]"), Diff);
+		TestSingleEdit(Diff, ETreeSitterDiffOperation::Delete, "object");
+	});
+
+	It("should not split a subtree to match a copy of one of its descendants", [this]()
+	{
+		FTreeSitterTreeDiff Diff;
+		RunDiff(TEXT("{\"x\": [[1, 2], [3]]}"), TEXT("{\"y\": [1, 2], \"x\": [[1, 2], [3]]}"), Diff);
+		TestSingleEdit(Diff, ETreeSitterDiffOperation::Insert, "pair");
+	});
+
+	It("should move reordered subtrees only", [this]()
+	{
+		FTreeSitterTreeDiff Diff;
+		RunDiff(TEXT("[[1, 2], [3, 4], [5, 6]]"), TEXT("[[5, 6], [1, 2], [3, 4]]"), Diff);
+		TestSingleEdit(Diff, ETreeSitterDiffOperation::Move, "array");
+	});
+}
+
+#endif
@@ -0,0 +1,131 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterFlatTree.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterFlatTreeSpec, "TreeSitter.TreeSitterFlatTree", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TSharedPtr<FTreeSitterParser> Parser;
+
+	TSharedRef<FTreeSitterFlatTree> Flatten(const FString& InText) const
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(InText);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		const TSharedRef<FTreeSitterFlatTree> FlatTree = FTreeSitterFlatTree::Build(Tree, *Source);
+		ts_tree_delete(Tree);
+		return FlatTree;
+	}
+
+	/** Index of the first node of a type, in pre-order */
+	static int32 FindNode(const FTreeSitterFlatTree& InTree, const char* InType, const int32 InStartIndex = 0)
+	{
+		const TConstArrayView<FTreeSitterFlatNode> Nodes = InTree.GetNodes();
+		for (int32 Index = InStartIndex; Index < Nodes.Num(); ++Index)
+		{
+			if (FCStringAnsi::Strcmp(InTree.GetNodeType(Nodes[Index]), InType) == 0)
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+
+END_DEFINE_SPEC(FTreeSitterFlatTreeSpec)
+
+void FTreeSitterFlatTreeSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Parser = MakeShared<FTreeSitterParser>();
+		Parser->SetLanguage(ETreeSitterLanguage::Json);
+	});
+
+	AfterEach([this]()
+	{
+		Parser.Reset();
+	});
+
+	Describe("Build", [this]()
+	{
+		It("should flatten every node in pre-order", [this]()
+		{
+			const FString Text = TEXT("{\"a\": [1, 2], \"b\": null}");
+			const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(Text);
+			TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+			const TSharedRef<FTreeSitterFlatTree> FlatTree = FTreeSitterFlatTree::Build(Tree, *Source);
+
+			const TConstArrayView<FTreeSitterFlatNode> Nodes = FlatTree->GetNodes();
+			TestEqual("Node count", static_cast<uint32>(Nodes.Num()), ts_node_descendant_count(ts_tree_root_node(Tree)));
+			TestEqual("Root subtree", static_cast<int32>(Nodes[0].SubtreeSize), Nodes.Num());
+			TestEqual("Root parent", Nodes[0].Parent, INDEX_NONE);
+			ts_tree_delete(Tree);
+
+			for (int32 Index = 1; Index < Nodes.Num(); ++Index)
+			{
+				const FTreeSitterFlatNode& Parent = Nodes[Nodes[Index].Parent];
+				TestTrue(FString::Printf(TEXT("Node %d is within its parent"), Index), Nodes[Index].Parent < Index && Index < Nodes[Index].Parent + static_cast<int32>(Parent.SubtreeSize));
+			}
+		});
+
+		It("should report syntax errors", [this]()
+		{
+			const TSharedRef<FTreeSitterFlatTree> FlatTree = Flatten(TEXT("{\"a\": [1, 2}"));
+
+			int32 ErrorCount = 0;
+			FlatTree->ForEachSyntaxError([&ErrorCount](const FTreeSitterFlatNode&) { ++ErrorCount; });
+			TestTrue("Errors", ErrorCount > 0);
+			TestTrue("Root has error", FlatTree->GetNodes()[0].HasError());
+		});
+	});
+
+	Describe("Hash", [this]()
+	{
+		It("should match identical subtrees wherever they are", [this]()
+		{
+			const TSharedRef<FTreeSitterFlatTree> FlatTree = Flatten(TEXT("[[1, {\"a\": true}], [1,   {\"a\":true}], [2, {\"a\": true}]]"));
+			const TConstArrayView<FTreeSitterFlatNode> Nodes = FlatTree->GetNodes();
+
+			const int32 First = FindNode(*FlatTree, "array", 2);
+			const int32 Second = FindNode(*FlatTree, "array", First + Nodes[First].SubtreeSize);
+			const int32 Third = FindNode(*FlatTree, "array", Second + Nodes[Second].SubtreeSize);
+			if (!TestTrue("Nested arrays", First != INDEX_NONE && Second != INDEX_NONE && Third != INDEX_NONE))
+			{
+				return;
+			}
+
+			TestEqual("Same structure and tokens, different spacing", Nodes[First].Hash, Nodes[Second].Hash);
+			TestNotEqual("Different leaf", Nodes[First].Hash, Nodes[Third].Hash);
+		});
+
+		It("should only change along the path of an edit", [this]()
+		{
+			const TSharedRef<FTreeSitterFlatTree> Before = Flatten(TEXT("{\"a\": [1, 2], \"b\": [3, 4]}"));
+			const TSharedRef<FTreeSitterFlatTree> After = Flatten(TEXT("{\"a\": [1, 2], \"b\": [3, 5]}"));
+
+			const int32 BeforeArray = FindNode(*Before, "array");
+			const int32 AfterArray = FindNode(*After, "array");
+			TestEqual("Untouched subtree", Before->GetNodes()[BeforeArray].Hash, After->GetNodes()[AfterArray].Hash);
+			TestNotEqual("Root", Before->GetNodes()[0].Hash, After->GetNodes()[0].Hash);
+		});
+
+		It("should include text between children", [this]()
+		{
+			Parser->SetLanguage(ETreeSitterLanguage::MarkdownInline);
+			const TSharedRef<FTreeSitterFlatTree> Hello = Flatten(TEXT("Hello *a* world"));
+			const TSharedRef<FTreeSitterFlatTree> Bye = Flatten(TEXT("Bye *a* world"));
+			const TSharedRef<FTreeSitterFlatTree> Spaced = Flatten(TEXT("Hello  *a*\tworld "));
+
+			TestNotEqual("Different text", Hello->GetNodes()[0].Hash, Bye->GetNodes()[0].Hash);
+			TestEqual("Different spacing", Hello->GetNodes()[0].Hash, Spaced->GetNodes()[0].Hash);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,120 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterHighlighter.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterHighlighterSpec, "TreeSitter.TreeSitterHighlighter", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TSharedPtr<FTreeSitterParser> Parser;
+	TSharedPtr<const FTreeSitterQuery> Query;
+
+	/** One declaration per line, spanning several highlight blocks */
+	static FString MakeCode(const int32 InLineCount)
+	{
+		FString Code;
+		for (int32 Line = 0; Line < InLineCount; ++Line)
+		{
+			Code += FString::Printf(TEXT("const value%d = %d; // line %d\n"), Line, Line, Line);
+		}
+		return Code;
+	}
+
+	/** Capture names of the spans of a line, as "name:start-end" */
+	static FString DescribeLine(const FTreeSitterHighlighter& InHighlighter, const TArray<FTreeSitterHighlightSpan>& InSpans)
+	{
+		TArray<FString> Descriptions;
+		for (const FTreeSitterHighlightSpan& Span : InSpans)
+		{
+			Descriptions.Add(FString::Printf(TEXT("%s:%d-%d"), *InHighlighter.GetCaptureName(Span.Capture).ToString(), Span.StartColumn, Span.EndColumn));
+		}
+		return FString::Join(Descriptions, TEXT(" "));
+	}
+
+END_DEFINE_SPEC(FTreeSitterHighlighterSpec)
+
+void FTreeSitterHighlighterSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Parser = MakeShared<FTreeSitterParser>();
+		Parser->SetLanguage(ETreeSitterLanguage::JavaScript);
+		Query = ITreeSitterModule::Get().FindQuery(ETreeSitterLanguage::JavaScript, TEXT("highlights"));
+	});
+
+	AfterEach([this]()
+	{
+		Parser.Reset();
+		Query.Reset();
+	});
+
+	It("should only query the blocks of the requested lines", [this]()
+	{
+		if (!TestTrue("Highlights query", Query.IsValid() && Query->IsValid()))
+		{
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(MakeCode(300));
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+
+		FTreeSitterHighlighter Highlighter(Query.ToSharedRef());
+		Highlighter.SetTree(Tree, Source);
+		ts_tree_delete(Tree);
+
+		TestEqual("Nothing queried before a request", Highlighter.GetCachedBlockCount(), 0);
+
+		TArray<TArray<FTreeSitterHighlightSpan>> LineSpans;
+		Highlighter.GetLineSpans(200, 210, LineSpans);
+		TestEqual("Requested line count", LineSpans.Num(), 10);
+		TestEqual("Only the visible block was queried", Highlighter.GetCachedBlockCount(), 1);
+		TestEqual("Line spans", DescribeLine(Highlighter, LineSpans[5]), TEXT("keyword:0-5 number:17-20 comment:22-33"));
+
+		Highlighter.GetLineSpans(60, 70, LineSpans);
+		TestEqual("Lines over two blocks", Highlighter.GetCachedBlockCount(), 3);
+		TestEqual("Spans across a block boundary", DescribeLine(Highlighter, LineSpans[4]), TEXT("keyword:0-5 number:16-18 comment:20-30"));
+	});
+
+	It("should only drop the blocks reached by an edit", [this]()
+	{
+		if (!TestTrue("Highlights query", Query.IsValid() && Query->IsValid()))
+		{
+			return;
+		}
+
+		const FString Code = MakeCode(300);
+		const TSharedRef<const FTreeSitterSource> OldSource = FTreeSitterSource::Create(Code);
+		TSTree* OldTree = Parser->Parse(OldSource->GetUTF8(), OldSource->GetUTF8Length());
+
+		FTreeSitterHighlighter Highlighter(Query.ToSharedRef());
+		Highlighter.SetTree(OldTree, OldSource);
+
+		TArray<TArray<FTreeSitterHighlightSpan>> LineSpans;
+		Highlighter.GetLineSpans(0, 300, LineSpans);
+		TestEqual("Every block queried", Highlighter.GetCachedBlockCount(), 5);
+
+		const TSharedRef<const FTreeSitterSource> NewSource = FTreeSitterSource::Create(Code.Replace(TEXT("const value150 = 150;"), TEXT("let value150 = \"150\";")));
+		TSInputEdit Edit;
+		NewSource->ComputeEdit(*OldSource, Edit);
+		ts_tree_edit(OldTree, &Edit);
+		TSTree* NewTree = Parser->Parse(NewSource->GetUTF8(), NewSource->GetUTF8Length(), OldTree);
+
+		Highlighter.UpdateTree(Edit, OldTree, NewTree, NewSource);
+		ts_tree_delete(OldTree);
+		ts_tree_delete(NewTree);
+
+		TestEqual("Only the edited block was dropped", Highlighter.GetCachedBlockCount(), 4);
+
+		Highlighter.GetLineSpans(150, 151, LineSpans);
+		TestEqual("Edited line spans", DescribeLine(Highlighter, LineSpans[0]), TEXT("keyword:0-3 string:15-20 comment:22-33"));
+	});
+}
+
+#endif
@@ -0,0 +1,399 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+#include "Tests/TreeSitterPerformanceTest.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace UE::TreeSitter::Tests
+{
+	/** A single text edit: InsertedText replaces RemovedLength characters at Position */
+	struct FStressEdit
+	{
+		int32 Position = 0;
+		int32 RemovedLength = 0;
+		FString InsertedText;
+
+		FString Apply(const FString& InText) const
+		{
+			return InText.Left(Position) + InsertedText + InText.Mid(Position + RemovedLength);
+		}
+
+		FString ToString() const
+		{
+			return FString::Printf(TEXT("at %d, remove %d, insert \"%s\""), Position, RemovedLength, *InsertedText.ReplaceCharWithEscapedChar());
+		}
+	};
+
+	/** Result of an edit applied on a tree, either reparsed incrementally or from scratch */
+	struct FStressStep
+	{
+		TSTree* IncrementalTree = nullptr;
+		TSTree* FullTree = nullptr;
+		double IncrementalMs = 0.0;
+		double FullMs = 0.0;
+
+		~FStressStep()
+		{
+			ts_tree_delete(IncrementalTree);
+			ts_tree_delete(FullTree);
+		}
+	};
+
+	/** Snippets inserted by random edits, mostly delimiters since they are what breaks trees apart */
+	static const TCHAR* StressSnippets[] = {
+		TEXT(" "), TEXT("\n"), TEXT("{"), TEXT("}"), TEXT("["), TEXT("]"), TEXT("("), TEXT(")"), TEXT("\""), TEXT("'"),
+		TEXT("`"), TEXT(","), TEXT(";"), TEXT(":"), TEXT("*"), TEXT("#"), TEXT("|"), TEXT("- "), TEXT("```"),
+		TEXT("/*"), TEXT("*/"), TEXT("//"), TEXT("42"), TEXT("null"), TEXT("name"), TEXT("function f() {}"),
+	};
+
+	static FStressEdit MakeRandomEdit(FRandomStream& InRandom, const FString& InText)
+	{
+		FStressEdit Edit;
+		Edit.Position = InRandom.RandRange(0, InText.Len());
+
+		const int32 Kind = InRandom.RandRange(0, 3);
+		if (Kind == 0 || Kind == 3)
+		{
+			Edit.RemovedLength = FMath::Min(InRandom.RandRange(1, 16), InText.Len() - Edit.Position);
+		}
+		if (Kind == 1 || Kind == 3)
+		{
+			Edit.InsertedText = StressSnippets[InRandom.RandRange(0, UE_ARRAY_COUNT(StressSnippets) - 1)];
+		}
+		if (Kind == 2 && !InText.IsEmpty())
+		{
+			// Copy of another part of the document, like a paste
+			const int32 Start = InRandom.RandRange(0, InText.Len() - 1);
+			Edit.InsertedText = InText.Mid(Start, InRandom.RandRange(1, 64));
+		}
+
+		return Edit;
+	}
+
+	static FString DescribeNode(const TSNode& InNode, const char* InFieldName)
+	{
+		const TSPoint Point = ts_node_start_point(InNode);
+		return FString::Printf(
+			TEXT("%s%s%s [%u, %u) at %u:%u%s%s"),
+			InFieldName ? UTF8_TO_TCHAR(InFieldName) : TEXT(""),
+			InFieldName ? TEXT(": ") : TEXT(""),
+			UTF8_TO_TCHAR(ts_node_type(InNode)),
+			ts_node_start_byte(InNode),
+			ts_node_end_byte(InNode),
+			Point.row,
+			Point.column,
+			ts_node_is_missing(InNode) ? TEXT(" (missing)") : TEXT(""),
+			ts_node_is_extra(InNode) ? TEXT(" (extra)") : TEXT("")
+		);
+	}
+
+	static bool AreNodesEqual(const TSTreeCursor& InIncremental, const TSTreeCursor& InFull)
+	{
+		const TSNode Incremental = ts_tree_cursor_current_node(&InIncremental);
+		const TSNode Full = ts_tree_cursor_current_node(&InFull);
+		const char* IncrementalField = ts_tree_cursor_current_field_name(&InIncremental);
+		const char* FullField = ts_tree_cursor_current_field_name(&InFull);
+
+		return ts_node_symbol(Incremental) == ts_node_symbol(Full)
+			&& ts_node_start_byte(Incremental) == ts_node_start_byte(Full)
+			&& ts_node_end_byte(Incremental) == ts_node_end_byte(Full)
+			&& ts_node_child_count(Incremental) == ts_node_child_count(Full)
+			&& ts_node_is_missing(Incremental) == ts_node_is_missing(Full)
+			&& ts_node_is_extra(Incremental) == ts_node_is_extra(Full)
+			&& ts_node_has_error(Incremental) == ts_node_has_error(Full)
+			&& (IncrementalField == FullField || (IncrementalField && FullField && FCStringAnsi::Strcmp(IncrementalField, FullField) == 0));
+	}
+
+	/**
+	 * Walks both trees in lockstep, node by node (anonymous ones included).
+	 *
+	 * @return false on the first node that differs, described in OutDivergence
+	 */
+	static bool CompareTrees(const TSTree* InIncrementalTree, const TSTree* InFullTree, FString& OutDivergence)
+	{
+		TSTreeCursor Incremental = ts_tree_cursor_new(ts_tree_root_node(InIncrementalTree));
+		TSTreeCursor Full = ts_tree_cursor_new(ts_tree_root_node(InFullTree));
+
+		bool bEqual = true;
+		while (true)
+		{
+			if (!AreNodesEqual(Incremental, Full))
+			{
+				OutDivergence = FString::Printf(
+					TEXT("incremental %s, full %s"),
+					*DescribeNode(ts_tree_cursor_current_node(&Incremental), ts_tree_cursor_current_field_name(&Incremental)),
+					*DescribeNode(ts_tree_cursor_current_node(&Full), ts_tree_cursor_current_field_name(&Full))
+				);
+				bEqual = false;
+				break;
+			}
+
+			// Child counts are equal, both cursors always move the same way
+			if (ts_tree_cursor_goto_first_child(&Incremental))
+			{
+				ts_tree_cursor_goto_first_child(&Full);
+				continue;
+			}
+
+			bool bDone = false;
+			while (!ts_tree_cursor_goto_next_sibling(&Incremental))
+			{
+				if (!ts_tree_cursor_goto_parent(&Incremental))
+				{
+					bDone = true;
+					break;
+				}
+				ts_tree_cursor_goto_parent(&Full);
+			}
+
+			if (bDone)
+			{
+				break;
+			}
+			ts_tree_cursor_goto_next_sibling(&Full);
+		}
+
+		ts_tree_cursor_delete(&Incremental);
+		ts_tree_cursor_delete(&Full);
+		return bEqual;
+	}
+
+	/** Applies an edit on InOldTree and reparses incrementally, along with a full parse of the edited text */
+	static bool ParseStep(const FTreeSitterParser& InParser, const FTreeSitterSource& InOldSource, const TSTree* InOldTree, const FTreeSitterSource& InNewSource, FStressStep& OutStep)
+	{
+		TSTree* EditedTree = ts_tree_copy(InOldTree);
+
+		TSInputEdit Edit;
+		if (InNewSource.ComputeEdit(InOldSource, Edit))
+		{
+			ts_tree_edit(EditedTree, &Edit);
+		}
+
+		double StartTime = FPlatformTime::Seconds();
+		OutStep.IncrementalTree = InParser.Parse(InNewSource.GetUTF8(), InNewSource.GetUTF8Length(), EditedTree);
+		OutStep.IncrementalMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		ts_tree_delete(EditedTree);
+
+		StartTime = FPlatformTime::Seconds();
+		OutStep.FullTree = InParser.Parse(InNewSource.GetUTF8(), InNewSource.GetUTF8Length());
+		OutStep.FullMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+		return OutStep.IncrementalTree && OutStep.FullTree;
+	}
+
+	/** Whether a single edit diverges when applied on a fresh full parse of InText */
+	static bool DoesEditDiverge(const FTreeSitterParser& InParser, const FString& InText, const FStressEdit& InEdit, FString& OutDivergence)
+	{
+		const TSharedRef<const FTreeSitterSource> OldSource = FTreeSitterSource::Create(InText);
+		const TSharedRef<const FTreeSitterSource> NewSource = FTreeSitterSource::Create(InEdit.Apply(InText));
+
+		TSTree* OldTree = InParser.Parse(OldSource->GetUTF8(), OldSource->GetUTF8Length());
+		if (!OldTree)
+		{
+			return false;
+		}
+
+		FStressStep Step;
+		const bool bDiverges = ParseStep(InParser, *OldSource, OldTree, *NewSource, Step) && !CompareTrees(Step.IncrementalTree, Step.FullTree, OutDivergence);
+		ts_tree_delete(OldTree);
+		return bDiverges;
+	}
+
+	/**
+	 * Shrinks a diverging edit, by removing chunks of lines from the text around it as long as it still diverges.
+	 *
+	 * @return false if the edit doesn't diverge on its own, the divergence then depends on the previous edits
+	 */
+	static bool ShrinkDivergence(const FTreeSitterParser& InParser, FString& InOutText, FStressEdit& InOutEdit, FString& OutDivergence)
+	{
+		if (!DoesEditDiverge(InParser, InOutText, InOutEdit, OutDivergence))
+		{
+			return false;
+		}
+
+		TArray<FString> Lines;
+		InOutText.ParseIntoArray(Lines, TEXT("\n"), false);
+
+		for (int32 ChunkSize = FMath::Max(Lines.Num() / 2, 1); ChunkSize >= 1; ChunkSize /= 2)
+		{
+			for (int32 LineIndex = 0; LineIndex < Lines.Num();)
+			{
+				const int32 Count = FMath::Min(ChunkSize, Lines.Num() - LineIndex);
+
+				// Character range of the chunk, including line breaks, which must not overlap the edit
+				int32 ChunkStart = 0;
+				for (int32 Index = 0; Index < LineIndex; ++Index)
+				{
+					ChunkStart += Lines[Index].Len() + 1;
+				}
+				int32 ChunkEnd = ChunkStart;
+				for (int32 Index = LineIndex; Index < LineIndex + Count; ++Index)
+				{
+					ChunkEnd += Lines[Index].Len() + 1;
+				}
+				ChunkEnd = FMath::Min(ChunkEnd, InOutText.Len());
+
+				const bool bBeforeEdit = ChunkEnd <= InOutEdit.Position;
+				const bool bAfterEdit = ChunkStart >= InOutEdit.Position + InOutEdit.RemovedLength;
+				if (!bBeforeEdit && !bAfterEdit)
+				{
+					LineIndex += Count;
+					continue;
+				}
+
+				FStressEdit CandidateEdit = InOutEdit;
+				if (bBeforeEdit)
+				{
+					CandidateEdit.Position -= ChunkEnd - ChunkStart;
+				}
+
+				const FString CandidateText = InOutText.Left(ChunkStart) + InOutText.Mid(ChunkEnd);
+				FString CandidateDivergence;
+				if (DoesEditDiverge(InParser, CandidateText, CandidateEdit, CandidateDivergence))
+				{
+					InOutText = CandidateText;
+					InOutEdit = CandidateEdit;
+					OutDivergence = CandidateDivergence;
+					Lines.RemoveAt(LineIndex, Count);
+				}
+				else
+				{
+					LineIndex += Count;
+				}
+			}
+		}
+
+		return true;
+	}
+}
+
+BEGIN_DEFINE_SPEC(FTreeSitterIncrementalParseSpec, "TreeSitter.Stress.IncrementalParse", EAutomationTestFlags::StressFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	/** Overridable with -TreeSitterStressSeed= and -TreeSitterStressEdits=, to replay a reported divergence */
+	int32 Seed = 1234;
+	int32 EditCount = 2000;
+
+	void RunStress(const ETreeSitterLanguage InLanguage, const FString& InText);
+
+END_DEFINE_SPEC(FTreeSitterIncrementalParseSpec)
+
+void FTreeSitterIncrementalParseSpec::RunStress(const ETreeSitterLanguage InLanguage, const FString& InText)
+{
+	using namespace UE::TreeSitter::Tests;
+
+	const FTreeSitterParser Parser;
+	if (!TestTrue(TEXT("Language is available"), Parser.SetLanguage(InLanguage)))
+	{
+		return;
+	}
+
+	FRandomStream Random(Seed);
+	TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(InText);
+	TSTree* Tree = Parser.Parse(Source->GetUTF8(), Source->GetUTF8Length());
+
+	TArray<double> IncrementalLatencies;
+	TArray<double> FullLatencies;
+	IncrementalLatencies.Reserve(EditCount);
+	FullLatencies.Reserve(EditCount);
+
+	for (int32 EditIndex = 0; EditIndex < EditCount && Tree; ++EditIndex)
+	{
+		const FStressEdit Edit = MakeRandomEdit(Random, Source->GetText());
+		const TSharedRef<const FTreeSitterSource> EditedSource = FTreeSitterSource::Create(Edit.Apply(Source->GetText()));
+
+		FStressStep Step;
+		if (!TestTrue(TEXT("Edited source parses"), ParseStep(Parser, *Source, Tree, *EditedSource, Step)))
+		{
+			break;
+		}
+
+		IncrementalLatencies.Add(Step.IncrementalMs);
+		FullLatencies.Add(Step.FullMs);
+
+		FString Divergence;
+		if (!CompareTrees(Step.IncrementalTree, Step.FullTree, Divergence))
+		{
+			FString ReproText = Source->GetText();
+			FStressEdit ReproEdit = Edit;
+			if (ShrinkDivergence(Parser, ReproText, ReproEdit, Divergence))
+			{
+				AddError(FString::Printf(
+					TEXT("Edit %d (seed %d) diverges: %s. Minimal repro, edit %s applied on \"%s\""),
+					EditIndex,
+					Seed,
+					*Divergence,
+					*ReproEdit.ToString(),
+					*ReproText.ReplaceCharWithEscapedChar()
+				));
+			}
+			else
+			{
+				AddError(FString::Printf(
+					TEXT("Edit %d (seed %d) diverges: %s. Depends on the previous edits, replay with -TreeSitterStressSeed=%d -TreeSitterStressEdits=%d"),
+					EditIndex,
+					Seed,
+					*Divergence,
+					Seed,
+					EditIndex + 1
+				));
+			}
+			break;
+		}
+
+		// Keep going from the incremental tree, so that reused subtrees accumulate over edits
+		Swap(Tree, Step.IncrementalTree);
+		Source = EditedSource;
+	}
+
+	ts_tree_delete(Tree);
+
+	const double IncrementalMedian = UE::TreeSitter::GetPercentile(IncrementalLatencies, 0.5);
+	const double FullMedian = UE::TreeSitter::GetPercentile(FullLatencies, 0.5);
+	AddInfo(FString::Printf(
+		TEXT("%d edits, incremental median %.3f ms (p95 %.3f ms), full median %.3f ms (p95 %.3f ms)"),
+		IncrementalLatencies.Num(),
+		IncrementalMedian,
+		UE::TreeSitter::GetPercentile(IncrementalLatencies, 0.95),
+		FullMedian,
+		UE::TreeSitter::GetPercentile(FullLatencies, 0.95)
+	));
+
+	if (IncrementalMedian > FullMedian)
+	{
+		AddWarning(TEXT("Incremental reparses are slower than full parses"));
+	}
+}
+
+void FTreeSitterIncrementalParseSpec::Define()
+{
+	FParse::Value(FCommandLine::Get(), TEXT("TreeSitterStressSeed="), Seed);
+	FParse::Value(FCommandLine::Get(), TEXT("TreeSitterStressEdits="), EditCount);
+
+	It("should reparse JSON incrementally into the same tree as a full parse", [this]()
+	{
+		RunStress(ETreeSitterLanguage::Json, UE::TreeSitter::Tests::GenerateJson(50));
+	});
+
+	It("should reparse JavaScript incrementally into the same tree as a full parse", [this]()
+	{
+		RunStress(ETreeSitterLanguage::JavaScript, UE::TreeSitter::Tests::GenerateJavaScript(10));
+	});
+
+	It("should reparse Markdown incrementally into the same tree as a full parse", [this]()
+	{
+		RunStress(ETreeSitterLanguage::Markdown, UE::TreeSitter::Tests::GenerateMarkdown(10));
+	});
+}
+
+#endif
@@ -0,0 +1,195 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterLint.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterLintSpec, "TreeSitter.TreeSitterLint", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	const FString Code = TEXT(
+		"var a = 1;\n"
+		"let b = 2;\n"
+		"if (a == b) {\n"
+		"  debugger;\n"
+		"}\n"
+		"console.log(a);\n"
+	);
+
+	TSharedPtr<FTreeSitterParser> Parser;
+	TSharedPtr<FTreeSitterLinter> Linter;
+
+	/** Diagnostics as "id:row", in order */
+	FString Describe(const TArray<FTreeSitterLintDiagnostic>& InDiagnostics) const
+	{
+		TArray<FString> Descriptions;
+		for (const FTreeSitterLintDiagnostic& Diagnostic : InDiagnostics)
+		{
+			Descriptions.Add(FString::Printf(TEXT("%s:%u"), *Linter->GetRules()[Diagnostic.Rule].Id.ToString(), Diagnostic.Row));
+		}
+		return FString::Join(Descriptions, TEXT(" "));
+	}
+
+	bool SameDiagnostics(const TArray<FTreeSitterLintDiagnostic>& A, const TArray<FTreeSitterLintDiagnostic>& B) const
+	{
+		if (A.Num() != B.Num())
+		{
+			return false;
+		}
+
+		for (int32 Index = 0; Index < A.Num(); ++Index)
+		{
+			if (A[Index].Rule != B[Index].Rule || A[Index].StartByte != B[Index].StartByte || A[Index].EndByte != B[Index].EndByte || A[Index].Row != B[Index].Row
+				|| A[Index].MatchStartByte != B[Index].MatchStartByte || A[Index].MatchEndByte != B[Index].MatchEndByte)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+END_DEFINE_SPEC(FTreeSitterLintSpec)
+
+void FTreeSitterLintSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Parser = MakeShared<FTreeSitterParser>();
+		Parser->SetLanguage(ETreeSitterLanguage::JavaScript);
+
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::JavaScript);
+		Linter = MakeShared<FTreeSitterLinter>(LanguageParser ? LanguageParser() : nullptr, TArray<FTreeSitterLintRule>{
+			{ TEXT("no-var"), TEXT("(variable_declaration) @lint"), TEXT("Use let or const"), ETreeSitterLintSeverity::Warning },
+			{ TEXT("no-debugger"), TEXT("(debugger_statement) @lint"), TEXT("Unexpected debugger"), ETreeSitterLintSeverity::Error },
+			{ TEXT("eqeqeq"), TEXT("(binary_expression operator: [\"==\" \"!=\"] @lint)"), TEXT("Use ==="), ETreeSitterLintSeverity::Warning },
+			{ TEXT("no-console"), TEXT("(call_expression function: (member_expression object: (identifier) @object) (#eq? @object \"console\")) @lint"), TEXT("Unexpected console"), ETreeSitterLintSeverity::Info },
+		});
+	});
+
+	AfterEach([this]()
+	{
+		Parser.Reset();
+		Linter.Reset();
+	});
+
+	It("should run every rule in a single combined query", [this]()
+	{
+		if (!TestTrue("Linter", Linter->IsValid()))
+		{
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(Code);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+
+		TArray<FTreeSitterLintDiagnostic> Diagnostics;
+		Linter->Lint(Tree, *Source, Diagnostics);
+		ts_tree_delete(Tree);
+
+		TestEqual("Diagnostics", Describe(Diagnostics), TEXT("no-var:0 eqeqeq:2 no-debugger:3 no-console:5"));
+	});
+
+	It("should match a full lint after an edit, linting only the changed ranges", [this]()
+	{
+		if (!TestTrue("Linter", Linter->IsValid()))
+		{
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> OldSource = FTreeSitterSource::Create(Code);
+		TSTree* OldTree = Parser->Parse(OldSource->GetUTF8(), OldSource->GetUTF8Length());
+
+		TArray<FTreeSitterLintDiagnostic> Diagnostics;
+		Linter->Lint(OldTree, *OldSource, Diagnostics);
+
+		// Fixes the comparison and adds a line, shifting the diagnostics after it
+		const TSharedRef<const FTreeSitterSource> NewSource = FTreeSitterSource::Create(Code.Replace(TEXT("a == b"), TEXT("a === b &&\n    b != 0")));
+		TSInputEdit Edit;
+		NewSource->ComputeEdit(*OldSource, Edit);
+		ts_tree_edit(OldTree, &Edit);
+		TSTree* NewTree = Parser->Parse(NewSource->GetUTF8(), NewSource->GetUTF8Length(), OldTree);
+
+		Linter->UpdateDiagnostics(Edit, OldTree, NewTree, *NewSource, Diagnostics);
+
+		TArray<FTreeSitterLintDiagnostic> FullDiagnostics;
+		Linter->Lint(NewTree, *NewSource, FullDiagnostics);
+		ts_tree_delete(OldTree);
+		ts_tree_delete(NewTree);
+
+		TestEqual("Updated diagnostics", Describe(Diagnostics), TEXT("no-var:0 eqeqeq:3 no-debugger:4 no-console:6"));
+		TestTrue("Same as a full lint", SameDiagnostics(Diagnostics, FullDiagnostics));
+	});
+
+	It("should lint again matches only reached by the edit through another capture", [this]()
+	{
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::JavaScript);
+		Linter = MakeShared<FTreeSitterLinter>(LanguageParser ? LanguageParser() : nullptr, TArray<FTreeSitterLintRule>{
+			{ TEXT("no-secret"), TEXT("(call_expression function: (identifier) @lint arguments: (arguments (identifier) @arg) (#eq? @arg \"secret\"))"), TEXT("Do not log secrets"), ETreeSitterLintSeverity::Error },
+		});
+		if (!TestTrue("Linter", Linter->IsValid()))
+		{
+			return;
+		}
+
+		// The reported function name is far from the edited argument
+		const TSharedRef<const FTreeSitterSource> OldSource = FTreeSitterSource::Create(TEXT("log(someLongArgumentName, secrex);\n"));
+		TSTree* OldTree = Parser->Parse(OldSource->GetUTF8(), OldSource->GetUTF8Length());
+
+		TArray<FTreeSitterLintDiagnostic> Diagnostics;
+		Linter->Lint(OldTree, *OldSource, Diagnostics);
+		TestEqual("Before", Describe(Diagnostics), TEXT(""));
+
+		const TSharedRef<const FTreeSitterSource> NewSource = FTreeSitterSource::Create(TEXT("log(someLongArgumentName, secret);\n"));
+		TSInputEdit Edit;
+		NewSource->ComputeEdit(*OldSource, Edit);
+		ts_tree_edit(OldTree, &Edit);
+		TSTree* NewTree = Parser->Parse(NewSource->GetUTF8(), NewSource->GetUTF8Length(), OldTree);
+
+		Linter->UpdateDiagnostics(Edit, OldTree, NewTree, *NewSource, Diagnostics);
+		ts_tree_delete(OldTree);
+		ts_tree_delete(NewTree);
+
+		TestEqual("After", Describe(Diagnostics), TEXT("no-secret:0"));
+	});
+
+	It("should report the whole match of rules without a @lint capture", [this]()
+	{
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::JavaScript);
+		Linter = MakeShared<FTreeSitterLinter>(LanguageParser ? LanguageParser() : nullptr, TArray<FTreeSitterLintRule>{
+			{ TEXT("no-var"), TEXT("(variable_declaration) @lint"), TEXT("Use let or const"), ETreeSitterLintSeverity::Warning },
+			{ TEXT("no-debugger"), TEXT("(debugger_statement) @statement"), TEXT("Unexpected debugger"), ETreeSitterLintSeverity::Error },
+		});
+		if (!TestTrue("Linter", Linter->IsValid()))
+		{
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(Code);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+
+		TArray<FTreeSitterLintDiagnostic> Diagnostics;
+		Linter->Lint(Tree, *Source, Diagnostics);
+		ts_tree_delete(Tree);
+
+		TestEqual("Diagnostics", Describe(Diagnostics), TEXT("no-var:0 no-debugger:3"));
+	});
+
+	It("should report the rule failing to compile", [this]()
+	{
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::JavaScript);
+		const FTreeSitterLinter InvalidLinter(LanguageParser ? LanguageParser() : nullptr, {
+			{ TEXT("no-var"), TEXT("(variable_declaration) @lint"), TEXT("Use let or const"), ETreeSitterLintSeverity::Warning },
+			{ TEXT("broken"), TEXT("(not_a_node) @lint"), TEXT("Never reported"), ETreeSitterLintSeverity::Error },
+		});
+
+		TestFalse("Linter", InvalidLinter.IsValid());
+		TestTrue("Error names the rule", InvalidLinter.GetError().Contains(TEXT("broken")));
+	});
+}
+
+#endif
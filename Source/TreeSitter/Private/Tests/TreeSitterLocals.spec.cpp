@@ -0,0 +1,139 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterLocals.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterLocalsSpec, "TreeSitter.TreeSitterLocals", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	const FString Code = TEXT(
+		"function outer(a) {\n"
+		"  let b = a + 1;\n"
+		"  function inner(a) {\n"
+		"    return a * b;\n"
+		"  }\n"
+		"  return inner(b) + a;\n"
+		"}\n"
+	);
+
+	TSharedPtr<FTreeSitterParser> Parser;
+	TSharedPtr<const FTreeSitterQuery> Query;
+
+	/** Byte offset of the Nth occurrence of a substring, ASCII only */
+	int32 Find(const FString& InText, const TCHAR* InSubstring, const int32 InOccurrence = 0) const
+	{
+		int32 Index = INDEX_NONE;
+		for (int32 Occurrence = 0; Occurrence <= InOccurrence; ++Occurrence)
+		{
+			Index = InText.Find(InSubstring, ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 1);
+		}
+		return Index;
+	}
+
+	void TestSameLocals(const FTreeSitterLocals& InActual, const FTreeSitterLocals& InExpected)
+	{
+		TestEqual("Scope count", InActual.GetScopes().Num(), InExpected.GetScopes().Num());
+		TestEqual("Definition count", InActual.GetDefinitions().Num(), InExpected.GetDefinitions().Num());
+		TestEqual("Reference count", InActual.GetReferences().Num(), InExpected.GetReferences().Num());
+
+		for (int32 Index = 0; Index < FMath::Min(InActual.GetScopes().Num(), InExpected.GetScopes().Num()); ++Index)
+		{
+			const FTreeSitterLocalScope& Actual = InActual.GetScopes()[Index];
+			const FTreeSitterLocalScope& Expected = InExpected.GetScopes()[Index];
+			TestTrue(FString::Printf(TEXT("Scope %d"), Index), Actual.StartByte == Expected.StartByte && Actual.EndByte == Expected.EndByte && Actual.Parent == Expected.Parent);
+		}
+
+		for (int32 Index = 0; Index < FMath::Min(InActual.GetDefinitions().Num(), InExpected.GetDefinitions().Num()); ++Index)
+		{
+			const FTreeSitterLocalDefinition& Actual = InActual.GetDefinitions()[Index];
+			const FTreeSitterLocalDefinition& Expected = InExpected.GetDefinitions()[Index];
+			TestTrue(FString::Printf(TEXT("Definition %d"), Index), Actual.StartByte == Expected.StartByte && Actual.Scope == Expected.Scope && Actual.NameHash == Expected.NameHash);
+		}
+
+		for (int32 Index = 0; Index < FMath::Min(InActual.GetReferences().Num(), InExpected.GetReferences().Num()); ++Index)
+		{
+			const FTreeSitterLocalReference& Actual = InActual.GetReferences()[Index];
+			const FTreeSitterLocalReference& Expected = InExpected.GetReferences()[Index];
+			TestTrue(FString::Printf(TEXT("Reference %d"), Index), Actual.StartByte == Expected.StartByte && Actual.Scope == Expected.Scope && Actual.Definition == Expected.Definition);
+		}
+	}
+
+END_DEFINE_SPEC(FTreeSitterLocalsSpec)
+
+void FTreeSitterLocalsSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Parser = MakeShared<FTreeSitterParser>();
+		Parser->SetLanguage(ETreeSitterLanguage::JavaScript);
+		Query = ITreeSitterModule::Get().FindQuery(ETreeSitterLanguage::JavaScript, TEXT("locals"));
+	});
+
+	AfterEach([this]()
+	{
+		Parser.Reset();
+		Query.Reset();
+	});
+
+	It("should resolve references to the innermost definition", [this]()
+	{
+		if (!TestTrue("Locals query", Query.IsValid() && Query->IsValid()))
+		{
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(Code);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		const TSharedRef<FTreeSitterLocals> Locals = FTreeSitterLocals::Build(Query.ToSharedRef(), Tree, *Source);
+		ts_tree_delete(Tree);
+
+		const int32 OuterA = Locals->FindDefinitionAt(Find(Code, TEXT("a)"), 0));
+		const int32 InnerA = Locals->FindDefinitionAt(Find(Code, TEXT("a)"), 1));
+		TestNotEqual("Parameters are distinct", OuterA, InnerA);
+		TestEqual("Shadowed parameter", Locals->FindDefinitionAt(Find(Code, TEXT("a *"))), InnerA);
+		TestEqual("Outer parameter", Locals->FindDefinitionAt(Find(Code, TEXT("a + 1"))), OuterA);
+		TestEqual("Outer parameter after the inner function", Locals->FindDefinitionAt(Find(Code, TEXT("a;\n}"))), OuterA);
+
+		const int32 B = Locals->FindDefinitionAt(Find(Code, TEXT("b =")));
+		TestEqual("Captured variable", Locals->FindDefinitionAt(Find(Code, TEXT("b;"))), B);
+
+		TArray<int32> References;
+		Locals->FindReferences(B, References);
+		TestEqual("References of b", References.Num(), 2);
+	});
+
+	It("should match a full build after an edit, querying only the edited scope", [this]()
+	{
+		if (!TestTrue("Locals query", Query.IsValid() && Query->IsValid()))
+		{
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> OldSource = FTreeSitterSource::Create(Code);
+		TSTree* OldTree = Parser->Parse(OldSource->GetUTF8(), OldSource->GetUTF8Length());
+		const TSharedRef<FTreeSitterLocals> OldLocals = FTreeSitterLocals::Build(Query.ToSharedRef(), OldTree, *OldSource);
+
+		const TSharedRef<const FTreeSitterSource> NewSource = FTreeSitterSource::Create(Code.Replace(TEXT("a * b;"), TEXT("a * b * b;")));
+		TSInputEdit Edit;
+		NewSource->ComputeEdit(*OldSource, Edit);
+		ts_tree_edit(OldTree, &Edit);
+		TSTree* NewTree = Parser->Parse(NewSource->GetUTF8(), NewSource->GetUTF8Length(), OldTree);
+
+		const TSharedRef<FTreeSitterLocals> UpdatedLocals = OldLocals->Update(Edit, OldTree, NewTree, *NewSource);
+		const TSharedRef<FTreeSitterLocals> BuiltLocals = FTreeSitterLocals::Build(Query.ToSharedRef(), NewTree, *NewSource);
+		ts_tree_delete(OldTree);
+		ts_tree_delete(NewTree);
+
+		TestSameLocals(*UpdatedLocals, *BuiltLocals);
+		TestTrue("Only the inner function was queried", UpdatedLocals->GetUpdatedStartByte() > 0 && UpdatedLocals->GetUpdatedEndByte() < NewSource->GetUTF8Length());
+	});
+}
+
+#endif
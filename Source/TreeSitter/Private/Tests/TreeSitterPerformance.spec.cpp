@@ -0,0 +1,108 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "Tests/TreeSitterPerformanceTest.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterPerformanceSpec, "TreeSitter.Performance.Parser", EAutomationTestFlags::PerfFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	/** Parses InSource with a parser created for the run, so that allocations don't depend on a previous parse */
+	static void ParseOnce(const ETreeSitterLanguage InLanguage, const FTreeSitterSource& InSource)
+	{
+		const FTreeSitterParser Parser;
+		Parser.SetLanguage(InLanguage);
+		if (TSTree* Tree = Parser.Parse(InSource.GetUTF8(), InSource.GetUTF8Length()))
+		{
+			ts_tree_delete(Tree);
+		}
+	}
+
+END_DEFINE_SPEC(FTreeSitterPerformanceSpec)
+
+void FTreeSitterPerformanceSpec::Define()
+{
+	It("should parse a large JSON document within budget", [this]()
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJson(5000));
+		UE::TreeSitter::Tests::TestPerformance(*this, TEXT("Parse.Json"), [&Source]()
+		{
+			ParseOnce(ETreeSitterLanguage::Json, *Source);
+		});
+	});
+
+	It("should parse a large JavaScript document within budget", [this]()
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJavaScript(500));
+		UE::TreeSitter::Tests::TestPerformance(*this, TEXT("Parse.JavaScript"), [&Source]()
+		{
+			ParseOnce(ETreeSitterLanguage::JavaScript, *Source);
+		});
+	});
+
+	It("should parse JSON in linear time and allocations", [this]()
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJson(1250));
+		const TSharedRef<const FTreeSitterSource> LargerSource = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJson(1250 * UE::TreeSitter::Tests::ScalingInputFactor));
+		UE::TreeSitter::Tests::TestLinearScaling(*this, TEXT("Parse.Json.Scaling"), [&Source]()
+		{
+			ParseOnce(ETreeSitterLanguage::Json, *Source);
+		}, [&LargerSource]()
+		{
+			ParseOnce(ETreeSitterLanguage::Json, *LargerSource);
+		});
+	});
+
+	It("should parse JavaScript in linear time and allocations", [this]()
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJavaScript(125));
+		const TSharedRef<const FTreeSitterSource> LargerSource = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJavaScript(125 * UE::TreeSitter::Tests::ScalingInputFactor));
+		UE::TreeSitter::Tests::TestLinearScaling(*this, TEXT("Parse.JavaScript.Scaling"), [&Source]()
+		{
+			ParseOnce(ETreeSitterLanguage::JavaScript, *Source);
+		}, [&LargerSource]()
+		{
+			ParseOnce(ETreeSitterLanguage::JavaScript, *LargerSource);
+		});
+	});
+
+	It("should reparse a large JavaScript document incrementally within budget", [this]()
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJavaScript(500));
+
+		FString EditedText = Source->GetText();
+		EditedText.InsertAt(EditedText.Len() / 2, TEXT("let inserted = 42;\n"));
+		const TSharedRef<const FTreeSitterSource> EditedSource = FTreeSitterSource::Create(MoveTemp(EditedText));
+
+		TSInputEdit Edit;
+		TestTrue(TEXT("Sources differ"), EditedSource->ComputeEdit(*Source, Edit));
+
+		const FTreeSitterParser Parser;
+		Parser.SetLanguage(ETreeSitterLanguage::JavaScript);
+
+		// Only the reparse is measured, the old tree is parsed and edited outside of it
+		TSTree* OldTree = Parser.Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		if (!TestNotNull(TEXT("Initial tree"), OldTree))
+		{
+			return;
+		}
+		ts_tree_edit(OldTree, &Edit);
+
+		UE::TreeSitter::Tests::TestPerformance(*this, TEXT("Parse.JavaScript.Incremental"), [&Parser, &EditedSource, OldTree]()
+		{
+			if (TSTree* Tree = Parser.Parse(EditedSource->GetUTF8(), EditedSource->GetUTF8Length(), OldTree))
+			{
+				ts_tree_delete(Tree);
+			}
+		});
+
+		ts_tree_delete(OldTree);
+	});
+}
+
+#endif
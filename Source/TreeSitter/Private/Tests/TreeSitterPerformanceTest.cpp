@@ -0,0 +1,234 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "Tests/TreeSitterPerformanceTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/ConfigCacheIni.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "TreeSitterMemory.h"
+
+namespace UE::TreeSitter::Tests
+{
+	/** Best of that many runs, the first one warming up caches and the parser pool */
+	static constexpr int32 PerformanceRunCount = 5;
+
+	/** Default relative tolerances, overridable per section with TimeTolerance / AllocationTolerance */
+	static constexpr double DefaultTimeTolerance = 0.5;
+	static constexpr double DefaultAllocationTolerance = 0.1;
+
+	static FString GetBaselineFilename()
+	{
+		const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TreeSitter"));
+		return Plugin.IsValid() ? FPaths::Combine(Plugin->GetBaseDir(), TEXT("Resources"), TEXT("Tests"), TEXT("PerformanceBaseline.ini")) : FString();
+	}
+
+	static bool IsWithinBudget(FAutomationTestBase& InTest, const FString& InName, const TCHAR* InMeasure, const double InMeasured, const double InBaseline, const double InTolerance)
+	{
+		if (InBaseline <= 0.0)
+		{
+			InTest.AddWarning(FString::Printf(TEXT("%s: no baseline for %s, measured %.3f. Run with -TreeSitterUpdateBaseline to record it."), *InName, InMeasure, InMeasured));
+			return true;
+		}
+
+		const double Budget = InBaseline * (1.0 + InTolerance);
+		if (InMeasured > Budget)
+		{
+			InTest.AddError(FString::Printf(
+				TEXT("%s: %s regressed to %.3f, baseline %.3f (+%.3f, +%.1f%%, tolerance %.0f%%)"),
+				*InName,
+				InMeasure,
+				InMeasured,
+				InBaseline,
+				InMeasured - InBaseline,
+				(InMeasured - InBaseline) / InBaseline * 100.0,
+				InTolerance * 100.0
+			));
+			return false;
+		}
+
+		InTest.AddInfo(FString::Printf(TEXT("%s: %s %.3f, baseline %.3f"), *InName, InMeasure, InMeasured, InBaseline));
+		return true;
+	}
+
+	/** Best time and allocation count over PerformanceRunCount runs */
+	static void Measure(const TFunctionRef<void()>& InFunction, double& OutBestTimeMs, uint64& OutBestAllocations)
+	{
+		OutBestTimeMs = TNumericLimits<double>::Max();
+		OutBestAllocations = TNumericLimits<uint64>::Max();
+
+		for (int32 Run = 0; Run < PerformanceRunCount; ++Run)
+		{
+			const uint64 StartAllocations = GetAllocationCount();
+			const double StartTime = FPlatformTime::Seconds();
+
+			InFunction();
+
+			OutBestTimeMs = FMath::Min(OutBestTimeMs, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+			// Other threads may parse at the same time, the smallest delta is the one of this run alone
+			OutBestAllocations = FMath::Min(OutBestAllocations, GetAllocationCount() - StartAllocations);
+		}
+	}
+
+	static bool IsWithinGrowth(FAutomationTestBase& InTest, const FString& InName, const TCHAR* InMeasure, const double InSmall, const double InLarge, const double InMaxGrowth)
+	{
+		// Measures below a millisecond or a single allocation are mostly noise, they are compared to 1 instead
+		const double Growth = InLarge / FMath::Max(InSmall, 1.0);
+		if (Growth > InMaxGrowth)
+		{
+			InTest.AddError(FString::Printf(
+				TEXT("%s: %s grew %.1fx for a %dx larger input (%.3f to %.3f), more than the %.1fx allowed"),
+				*InName,
+				InMeasure,
+				Growth,
+				ScalingInputFactor,
+				InSmall,
+				InLarge,
+				InMaxGrowth
+			));
+			return false;
+		}
+
+		InTest.AddInfo(FString::Printf(TEXT("%s: %s grew %.1fx for a %dx larger input (%.3f to %.3f)"), *InName, InMeasure, Growth, ScalingInputFactor, InSmall, InLarge));
+		return true;
+	}
+
+	bool TestPerformance(FAutomationTestBase& InTest, const FString& InName, const TFunctionRef<void()>& InFunction)
+	{
+		double BestTimeMs;
+		uint64 BestAllocations;
+		Measure(InFunction, BestTimeMs, BestAllocations);
+
+		const FString Filename = GetBaselineFilename();
+		if (Filename.IsEmpty())
+		{
+			InTest.AddError(TEXT("Unable to locate the TreeSitter plugin to read performance baselines"));
+			return false;
+		}
+
+		FConfigFile Baseline;
+		Baseline.Read(Filename);
+
+		if (FParse::Param(FCommandLine::Get(), TEXT("TreeSitterUpdateBaseline")))
+		{
+			Baseline.SetString(*InName, TEXT("TimeMs"), *FString::Printf(TEXT("%.3f"), BestTimeMs));
+			Baseline.SetString(*InName, TEXT("Allocations"), *LexToString(BestAllocations));
+			Baseline.Dirty = true;
+			if (!Baseline.Write(Filename))
+			{
+				InTest.AddError(FString::Printf(TEXT("Unable to write performance baseline %s"), *Filename));
+				return false;
+			}
+
+			InTest.AddInfo(FString::Printf(TEXT("%s: recorded %.3f ms, %llu allocations"), *InName, BestTimeMs, BestAllocations));
+			return true;
+		}
+
+		double BaselineTimeMs = 0.0;
+		double TimeTolerance = DefaultTimeTolerance;
+		double AllocationTolerance = DefaultAllocationTolerance;
+		FString BaselineAllocations;
+		Baseline.GetDouble(*InName, TEXT("TimeMs"), BaselineTimeMs);
+		Baseline.GetDouble(*InName, TEXT("TimeTolerance"), TimeTolerance);
+		Baseline.GetDouble(*InName, TEXT("AllocationTolerance"), AllocationTolerance);
+		Baseline.GetString(*InName, TEXT("Allocations"), BaselineAllocations);
+
+		bool bSuccess = IsWithinBudget(InTest, InName, TEXT("time (ms)"), BestTimeMs, BaselineTimeMs, TimeTolerance);
+#if !UE_BUILD_SHIPPING
+		bSuccess &= IsWithinBudget(InTest, InName, TEXT("allocations"), static_cast<double>(BestAllocations), FCString::Atod(*BaselineAllocations), AllocationTolerance);
+#endif
+		return bSuccess;
+	}
+
+	bool TestLinearScaling(FAutomationTestBase& InTest, const FString& InName, const TFunctionRef<void()>& InFunction, const TFunctionRef<void()>& InLargerFunction, const double InMaxGrowth)
+	{
+		double SmallTimeMs;
+		uint64 SmallAllocations;
+		Measure(InFunction, SmallTimeMs, SmallAllocations);
+
+		double LargeTimeMs;
+		uint64 LargeAllocations;
+		Measure(InLargerFunction, LargeTimeMs, LargeAllocations);
+
+		bool bSuccess = IsWithinGrowth(InTest, InName, TEXT("time (ms)"), SmallTimeMs, LargeTimeMs, InMaxGrowth);
+#if !UE_BUILD_SHIPPING
+		bSuccess &= IsWithinGrowth(InTest, InName, TEXT("allocations"), static_cast<double>(SmallAllocations), static_cast<double>(LargeAllocations), InMaxGrowth);
+#endif
+		return bSuccess;
+	}
+
+	FString GenerateJson(const int32 InObjectCount)
+	{
+		FString Result = TEXT("[\n");
+		for (int32 Index = 0; Index < InObjectCount; ++Index)
+		{
+			Result += FString::Printf(
+				TEXT("  {\"id\": %d, \"name\": \"Item_%d\", \"enabled\": %s, \"weight\": %d.%d, \"tags\": [\"a\", \"b\", \"c%d\"], \"parent\": null, \"nested\": {\"x\": %d, \"y\": [%d, %d]}}%s\n"),
+				Index,
+				Index,
+				Index % 2 ? TEXT("true") : TEXT("false"),
+				Index % 100,
+				Index % 7,
+				Index % 10,
+				Index * 3,
+				Index,
+				-Index,
+				Index + 1 < InObjectCount ? TEXT(",") : TEXT("")
+			);
+		}
+		Result += TEXT("]\n");
+		return Result;
+	}
+
+	FString GenerateJavaScript(const int32 InFunctionCount)
+	{
+		FString Result;
+		for (int32 Index = 0; Index < InFunctionCount; ++Index)
+		{
+			Result += FString::Printf(
+				TEXT("// Function %d\n")
+				TEXT("export function compute%d(items, { scale = %d, offset } = {}) {\n")
+				TEXT("  const total = items.filter((item) => item.enabled).reduce((sum, item) => sum + item.weight * scale, 0);\n")
+				TEXT("  if (total > %d && offset !== undefined) {\n")
+				TEXT("    return `${total + offset}: ${items.length}`;\n")
+				TEXT("  }\n")
+				TEXT("  for (let i = 0; i < items.length; ++i) { items[i].index = i; }\n")
+				TEXT("  return { total, label: 'compute%d', values: [1, 2, 3].map(x => x * %d) };\n")
+				TEXT("}\n\n")
+				TEXT("class Widget%d extends Base {\n")
+				TEXT("  constructor(name) { super(name); this.count = %d; }\n")
+				TEXT("  async load() { const data = await fetch(this.name); return data?.json() ?? null; }\n")
+				TEXT("}\n\n"),
+				Index, Index, Index % 5 + 1, Index * 10, Index, Index, Index, Index
+			);
+		}
+		return Result;
+	}
+
+	FString GenerateMarkdown(const int32 InSectionCount)
+	{
+		FString Result;
+		for (int32 Index = 0; Index < InSectionCount; ++Index)
+		{
+			Result += FString::Printf(
+				TEXT("## Section %d\n\n")
+				TEXT("Some *emphasis*, **strong text**, `inline code` and a [link](https://example.com/%d) in paragraph %d.\n")
+				TEXT("A second line with ~~strikethrough~~ and an ![image](images/%d.png).\n\n")
+				TEXT("- First item\n- Second item with **bold**\n  - Nested item %d\n\n")
+				TEXT("1. One\n2. Two\n\n")
+				TEXT("> A quote about section %d\n\n")
+				TEXT("```js\nconst value%d = compute(%d);\n```\n\n")
+				TEXT("```json\n{\"section\": %d, \"values\": [1, 2, 3]}\n```\n\n")
+				TEXT("| Name | Value |\n| --- | --- |\n| Item %d | %d |\n| Other | *none* |\n\n"),
+				Index, Index, Index, Index, Index, Index, Index, Index, Index, Index, Index * 2
+			);
+		}
+		return Result;
+	}
+}
+
+#endif
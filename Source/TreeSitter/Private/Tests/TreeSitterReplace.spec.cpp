@@ -0,0 +1,148 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterMemory.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterReplace.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterReplaceSpec, "TreeSitter.TreeSitterReplace", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	/** console.log(...) calls, the object and property being checked by predicates */
+	const FString LogQuery = TEXT(
+		"((call_expression\n"
+		"  function: (member_expression object: (identifier) @object property: (property_identifier) @property)\n"
+		"  arguments: (arguments) @args) @match\n"
+		"  (#eq? @object \"console\")\n"
+		"  (#match? @property \"^(log|info)$\"))\n"
+	);
+
+	TSharedPtr<FTreeSitterParser> Parser;
+	const TSLanguage* Language = nullptr;
+
+	FString ToSExpression(const TSTree* InTree) const
+	{
+		char* String = ts_node_string(ts_tree_root_node(InTree));
+		FString Result = UTF8_TO_TCHAR(String);
+		UE::TreeSitter::Free(String);
+		return Result;
+	}
+
+END_DEFINE_SPEC(FTreeSitterReplaceSpec)
+
+void FTreeSitterReplaceSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Parser = MakeShared<FTreeSitterParser>();
+		Parser->SetLanguage(ETreeSitterLanguage::JavaScript);
+
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::JavaScript);
+		Language = LanguageParser ? LanguageParser() : nullptr;
+	});
+
+	AfterEach([this]()
+	{
+		Parser.Reset();
+		Language = nullptr;
+	});
+
+	It("should replace the matches passing the predicates, outermost first", [this]()
+	{
+		const FTreeSitterReplacer Replacer(MakeShared<FTreeSitterQuery>(Language, LogQuery), TEXT("logger.${property}$args"));
+		if (!TestTrue("Replacer", Replacer.IsValid()))
+		{
+			return;
+		}
+
+		const FString Code = TEXT(
+			"console.log(1);\n"
+			"console.warn(2);\n"
+			"other.log(3);\n"
+			"console.info(console.log(4));\n"
+		);
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(Code);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+
+		TArray<FTreeSitterTextEdit> Edits;
+		Replacer.FindEdits(ts_tree_root_node(Tree), *Source, Edits);
+		TestEqual("Edit count", Edits.Num(), 2);
+
+		const TSharedRef<const FTreeSitterSource> Result = UE::TreeSitter::ApplyEdits(*Source, Edits);
+		TestEqual("Replaced text", Result->GetText(), TEXT(
+			"logger.log(1);\n"
+			"console.warn(2);\n"
+			"other.log(3);\n"
+			"logger.info(console.log(4));\n"
+		));
+
+		ts_tree_delete(Tree);
+	});
+
+	It("should reparse the edited tree incrementally to the same tree as a full parse", [this]()
+	{
+		const FTreeSitterReplacer Replacer(MakeShared<FTreeSitterQuery>(Language, LogQuery), TEXT("logger.debug(\"$property\",\n  ${args})"));
+		if (!TestTrue("Replacer", Replacer.IsValid()))
+		{
+			return;
+		}
+
+		const FString Code = TEXT(
+			"function greet(name) {\n"
+			"  console.log(name);\n"
+			"  return name.length;\n"
+			"}\n"
+			"console.info(greet(\"é\"), 'ü');\n"
+		);
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(Code);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+
+		TArray<FTreeSitterTextEdit> Edits;
+		Replacer.FindEdits(ts_tree_root_node(Tree), *Source, Edits);
+		TestEqual("Edit count", Edits.Num(), 2);
+
+		const TSharedRef<const FTreeSitterSource> Result = UE::TreeSitter::ApplyEdits(*Source, Edits, Tree);
+		TSTree* IncrementalTree = Parser->Parse(Result->GetUTF8(), Result->GetUTF8Length(), Tree);
+		TSTree* FullTree = Parser->Parse(Result->GetUTF8(), Result->GetUTF8Length());
+
+		TestFalse("No syntax error", ts_node_has_error(ts_tree_root_node(IncrementalTree)));
+		TestEqual("Incremental tree", ToSExpression(IncrementalTree), ToSExpression(FullTree));
+
+		ts_tree_delete(Tree);
+		ts_tree_delete(IncrementalTree);
+		ts_tree_delete(FullTree);
+	});
+
+	It("should insert a dollar sign for $$", [this]()
+	{
+		const FTreeSitterReplacer Replacer(MakeShared<FTreeSitterQuery>(Language, LogQuery), TEXT("$$property.$property$$$args"));
+		if (!TestTrue("Replacer", Replacer.IsValid()))
+		{
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(TEXT("console.log(1);\n"));
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+
+		TArray<FTreeSitterTextEdit> Edits;
+		Replacer.FindEdits(ts_tree_root_node(Tree), *Source, Edits);
+		ts_tree_delete(Tree);
+
+		TestEqual("Replaced text", UE::TreeSitter::ApplyEdits(*Source, Edits)->GetText(), TEXT("$property.log$(1);\n"));
+	});
+
+	It("should reject templates referencing unknown captures", [this]()
+	{
+		const FTreeSitterReplacer Replacer(MakeShared<FTreeSitterQuery>(Language, LogQuery), TEXT("logger.$method$args"));
+		TestFalse("Replacer", Replacer.IsValid());
+		TestTrue("Error", Replacer.GetError().Contains(TEXT("@method")));
+	});
+}
+
+#endif
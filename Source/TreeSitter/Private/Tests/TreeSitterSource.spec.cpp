@@ -0,0 +1,55 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+BEGIN_DEFINE_SPEC(FTreeSitterSourceSpec, "TreeSitter.TreeSitterSource", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+END_DEFINE_SPEC(FTreeSitterSourceSpec)
+
+void FTreeSitterSourceSpec::Define()
+{
+	Describe("Views", [this]()
+	{
+		It("should map UTF-8 byte ranges back to characters", [this]()
+		{
+			// "é" is two bytes in UTF-8, "x" starts at byte 3 but character 2
+			const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(TEXT("aéx\nyz"));
+
+			TestEqual("UTF-8 length", Source->GetUTF8Length(), 7u);
+			TestEqual("View after multi-byte character", FString(Source->GetView(3, 4)), TEXT("x"));
+			TestEqual("View over multi-byte character", FString(Source->GetView(0, 3)), TEXT("aé"));
+			TestEqual("Out of range view is clamped", FString(Source->GetView(5, 100)), TEXT("yz"));
+		});
+	});
+
+	Describe("Edits", [this]()
+	{
+		It("should compute the edit between two sources", [this]()
+		{
+			const TSharedRef<const FTreeSitterSource> Previous = FTreeSitterSource::Create(TEXT("# Title\n\nSome text\n"));
+			const TSharedRef<const FTreeSitterSource> Current = FTreeSitterSource::Create(TEXT("# Title\n\nSome more text\n"));
+
+			TSInputEdit Edit;
+			if (!TestTrue("Sources differ", Current->ComputeEdit(*Previous, Edit)))
+			{
+				return;
+			}
+
+			TestEqual("Start byte", Edit.start_byte, 14u);
+			TestEqual("Old end byte", Edit.old_end_byte, 14u);
+			TestEqual("New end byte", Edit.new_end_byte, 19u);
+			TestEqual("Start row", Edit.start_point.row, 2u);
+			TestEqual("Start column", Edit.start_point.column, 5u);
+		});
+
+		It("should report identical sources", [this]()
+		{
+			const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(TEXT("Same"));
+
+			TSInputEdit Edit;
+			TestFalse("No edit", Source->ComputeEdit(*FTreeSitterSource::Create(TEXT("Same")), Edit));
+		});
+	});
+}
@@ -0,0 +1,76 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "Misc/Paths.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterSymbolIndex.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterSymbolIndexSpec, "TreeSitter.TreeSitterSymbolIndex", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TUniquePtr<FTreeSitterSymbolIndex> Index;
+
+	void Update(const FString& InPath, const FString& InText) const
+	{
+		Index->UpdateFile(InPath, ETreeSitterLanguage::JavaScript, *FTreeSitterSource::Create(InText));
+	}
+
+	/** Matches as "<file>:<name>", with "()" for references, comma separated */
+	FString FindNames(const FString& InPrefix, const bool bInDefinitionsOnly = false) const
+	{
+		TArray<FTreeSitterSymbolLocation> Symbols;
+		Index->FindSymbols(InPrefix, Symbols, 100, bInDefinitionsOnly);
+
+		TArray<FString> Names;
+		for (const FTreeSitterSymbolLocation& Symbol : Symbols)
+		{
+			Names.Add(FString::Printf(TEXT("%s:%s%s"), *FPaths::GetCleanFilename(Symbol.Path), *Symbol.Tag.Name, Symbol.Tag.bIsDefinition ? TEXT("") : TEXT("()")));
+		}
+		return FString::Join(Names, TEXT(", "));
+	}
+
+END_DEFINE_SPEC(FTreeSitterSymbolIndexSpec)
+
+void FTreeSitterSymbolIndexSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Index = MakeUnique<FTreeSitterSymbolIndex>();
+		Update(TEXT("a.js"), TEXT("function loadLevel() {}\nfunction LoadAsset() { loadLevel(); }\nclass Loader {}\n"));
+		Update(TEXT("b.js"), TEXT("function unload() { loadLevel(); }\n"));
+	});
+
+	AfterEach([this]()
+	{
+		Index.Reset();
+	});
+
+	It("should find symbols by prefix, ignoring case, definitions first", [this]()
+	{
+		TestEqual("Symbols", FindNames(TEXT("load")), TEXT("a.js:LoadAsset, a.js:Loader, a.js:loadLevel, a.js:loadLevel(), b.js:loadLevel()"));
+		TestEqual("Definitions only", FindNames(TEXT("LOAD"), true), TEXT("a.js:LoadAsset, a.js:Loader, a.js:loadLevel"));
+		TestEqual("No match", FindNames(TEXT("save")), TEXT(""));
+	});
+
+	It("should replace the symbols of updated files", [this]()
+	{
+		Update(TEXT("b.js"), TEXT("function unloadAll() {}\n"));
+
+		TestEqual("Removed reference", FindNames(TEXT("loadLevel")), TEXT("a.js:loadLevel, a.js:loadLevel()"));
+		TestEqual("New definition", FindNames(TEXT("unloadA")), TEXT("b.js:unloadAll"));
+		TestEqual("File count", Index->GetFileCount(), 2);
+	});
+
+	It("should forget removed files", [this]()
+	{
+		Index->RemoveFile(TEXT("a.js"));
+
+		TestEqual("Remaining symbols", FindNames(TEXT("")), TEXT("b.js:unload, b.js:loadLevel()"));
+		TestEqual("Symbol count", Index->GetSymbolCount(), 2);
+	});
+}
+
+#endif
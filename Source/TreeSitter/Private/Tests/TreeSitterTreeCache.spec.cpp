@@ -0,0 +1,131 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TreeSitterFlatTree.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterTreeCache.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterTreeCacheSpec, "TreeSitter.TreeSitterTreeCache", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TSharedPtr<FTreeSitterTreeCache> Cache;
+	TSharedPtr<const FTreeSitterSource> Source;
+	uint64 ContentHash = 0;
+
+	/** Offsets in the entry header (Magic, FormatVersion, LanguageVersion, Language, ContentHash, GrammarHash, ...) */
+	static constexpr int32 LanguageVersionOffset = 8;
+	static constexpr int32 GrammarHashOffset = 24;
+
+	/** Offset of the SubtreeSize of the first child of the root, past the 40 bytes header and the root node */
+	static constexpr int32 FirstChildSubtreeSizeOffset = 40 + sizeof(FTreeSitterFlatNode) + STRUCT_OFFSET(FTreeSitterFlatNode, SubtreeSize);
+
+	/** Path of the entry of Source, as laid out by FTreeSitterTreeCache */
+	FString GetEntryPath() const
+	{
+		return Cache->GetDirectory() / UE::TreeSitter::GetLanguageName(ETreeSitterLanguage::Json) / FString::Printf(TEXT("%016llx.tstc"), ContentHash);
+	}
+
+	/** Overwrites a uint32 field of the stored entry with InValue, or its value + 1 (as another ABI or grammar build would have written it) */
+	bool CorruptEntry(const int32 InOffset, const TOptional<uint32> InValue = {}) const
+	{
+		TArray<uint8> Buffer;
+		if (!FFileHelper::LoadFileToArray(Buffer, *GetEntryPath()) || Buffer.Num() < InOffset + static_cast<int32>(sizeof(uint32)))
+		{
+			return false;
+		}
+
+		uint32 Value;
+		FMemory::Memcpy(&Value, Buffer.GetData() + InOffset, sizeof(uint32));
+		Value = InValue.Get(Value + 1);
+		FMemory::Memcpy(Buffer.GetData() + InOffset, &Value, sizeof(uint32));
+		return FFileHelper::SaveArrayToFile(Buffer, *GetEntryPath());
+	}
+
+END_DEFINE_SPEC(FTreeSitterTreeCacheSpec)
+
+void FTreeSitterTreeCacheSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		const FString Directory = FPaths::AutomationTransientDir() / TEXT("TreeSitterTreeCache");
+		IFileManager::Get().DeleteDirectory(*Directory, false, true);
+		Cache = MakeShared<FTreeSitterTreeCache>(Directory);
+		Source = FTreeSitterSource::Create(TEXT("{\"a\": [1, 2, 3]}"));
+		ContentHash = FTreeSitterTreeCache::HashContent(*Source);
+	});
+
+	AfterEach([this]()
+	{
+		Cache.Reset();
+		Source.Reset();
+	});
+
+	It("should load back stored trees", [this]()
+	{
+		bool bCacheHit = true;
+		const TSharedPtr<const FTreeSitterFlatTree> Parsed = Cache->FindOrParse(ETreeSitterLanguage::Json, *Source, &bCacheHit);
+		TestFalse("Cache miss", bCacheHit);
+
+		const TSharedPtr<const FTreeSitterFlatTree> Loaded = Cache->Find(ETreeSitterLanguage::Json, ContentHash);
+		if (!TestTrue("Stored", Parsed.IsValid() && Loaded.IsValid()))
+		{
+			return;
+		}
+
+		TestEqual("Node count", Loaded->GetNodes().Num(), Parsed->GetNodes().Num());
+		TestEqual("Root hash", Loaded->GetNodes()[0].Hash, Parsed->GetNodes()[0].Hash);
+		TestFalse("Other language", Cache->Find(ETreeSitterLanguage::JavaScript, ContentHash).IsValid());
+	});
+
+	It("should ignore entries written by another language ABI", [this]()
+	{
+		Cache->FindOrParse(ETreeSitterLanguage::Json, *Source);
+		if (!TestTrue("Entry altered", CorruptEntry(LanguageVersionOffset)))
+		{
+			return;
+		}
+
+		TestFalse("Found", Cache->Find(ETreeSitterLanguage::Json, ContentHash).IsValid());
+
+		bool bCacheHit = true;
+		Cache->FindOrParse(ETreeSitterLanguage::Json, *Source, &bCacheHit);
+		TestFalse("Cache miss", bCacheHit);
+		TestTrue("Overwritten", Cache->Find(ETreeSitterLanguage::Json, ContentHash).IsValid());
+	});
+
+	It("should ignore entries whose node table is corrupted", [this]()
+	{
+		Cache->FindOrParse(ETreeSitterLanguage::Json, *Source);
+		if (!TestTrue("Entry altered", CorruptEntry(FirstChildSubtreeSizeOffset, 0)))
+		{
+			return;
+		}
+
+		TestFalse("Found", Cache->Find(ETreeSitterLanguage::Json, ContentHash).IsValid());
+	});
+
+	It("should ignore entries written by another grammar revision", [this]()
+	{
+		Cache->FindOrParse(ETreeSitterLanguage::Json, *Source);
+		if (!TestTrue("Entry altered", CorruptEntry(GrammarHashOffset)))
+		{
+			return;
+		}
+
+		TestFalse("Found", Cache->Find(ETreeSitterLanguage::Json, ContentHash).IsValid());
+
+		bool bCacheHit = true;
+		Cache->FindOrParse(ETreeSitterLanguage::Json, *Source, &bCacheHit);
+		TestFalse("Cache miss", bCacheHit);
+		TestTrue("Overwritten", Cache->Find(ETreeSitterLanguage::Json, ContentHash).IsValid());
+	});
+}
+
+#endif
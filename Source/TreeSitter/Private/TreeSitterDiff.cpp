@@ -0,0 +1,380 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterDiff.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+#include "Algo/StableSort.h"
+#include "Containers/BitArray.h"
+#include "TreeSitterFlatTree.h"
+#include "TreeSitterStats.h"
+
+namespace UE::TreeSitter::Diff
+{
+	/** Both trees and their mapping, while it is being built */
+	struct FDiffContext
+	{
+		TConstArrayView<FTreeSitterFlatNode> OldNodes;
+		TConstArrayView<FTreeSitterFlatNode> NewNodes;
+		TArray<int32>& OldToNew;
+		TArray<int32>& NewToOld;
+
+		void Map(const int32 InOldIndex, const int32 InNewIndex) const
+		{
+			OldToNew[InOldIndex] = InNewIndex;
+			NewToOld[InNewIndex] = InOldIndex;
+		}
+
+		/** Identical hashes mean identical shapes, so both subtrees line up node for node */
+		void MapSubtree(const int32 InOldIndex, const int32 InNewIndex) const
+		{
+			for (int32 Offset = 0; Offset < static_cast<int32>(NewNodes[InNewIndex].SubtreeSize); ++Offset)
+			{
+				Map(InOldIndex + Offset, InNewIndex + Offset);
+			}
+		}
+	};
+
+	template <typename CallbackType>
+	static void ForEachChild(const TConstArrayView<FTreeSitterFlatNode> InNodes, const int32 InIndex, CallbackType&& InCallback)
+	{
+		const int32 EndIndex = InIndex + static_cast<int32>(InNodes[InIndex].SubtreeSize);
+		for (int32 ChildIndex = InIndex + 1; ChildIndex < EndIndex; ChildIndex += InNodes[ChildIndex].SubtreeSize)
+		{
+			InCallback(ChildIndex);
+		}
+	}
+
+	static bool HasNamedChildren(const TConstArrayView<FTreeSitterFlatNode> InNodes, const int32 InIndex)
+	{
+		bool bHasNamedChildren = false;
+		ForEachChild(InNodes, InIndex, [&InNodes, &bHasNamedChildren](const int32 InChildIndex)
+		{
+			bHasNamedChildren |= InNodes[InChildIndex].IsNamed();
+		});
+		return bHasNamedChildren;
+	}
+
+	/** Indices of the values in the longest increasing subsequence (patience sorting) */
+	static TBitArray<> GetLongestIncreasingSubsequence(const TArray<int32>& InValues)
+	{
+		TArray<int32> TailIndices;
+		TArray<int32> Previous;
+		Previous.SetNumUninitialized(InValues.Num());
+
+		for (int32 Index = 0; Index < InValues.Num(); ++Index)
+		{
+			const int32 Length = Algo::LowerBoundBy(TailIndices, InValues[Index], [&InValues](const int32 InTailIndex) { return InValues[InTailIndex]; });
+			Previous[Index] = Length > 0 ? TailIndices[Length - 1] : INDEX_NONE;
+			if (Length == TailIndices.Num())
+			{
+				TailIndices.Add(Index);
+			}
+			else
+			{
+				TailIndices[Length] = Index;
+			}
+		}
+
+		TBitArray<> Result(false, InValues.Num());
+		for (int32 Index = TailIndices.IsEmpty() ? INDEX_NONE : TailIndices.Last(); Index != INDEX_NONE; Index = Previous[Index])
+		{
+			Result[Index] = true;
+		}
+		return Result;
+	}
+
+	/**
+	 * Matches identical named subtrees, largest first so that a subtree is never split by an earlier match of one of
+	 * its descendants. Once a node is matched its descendants are too, so a node still unmatched when reached has no
+	 * matched descendants either.
+	 */
+	static void MatchIdenticalSubtrees(const FDiffContext& InContext)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UE::TreeSitter::Diff::MatchIdenticalSubtrees);
+
+		// Leaves are too common to be matched anywhere in the document, they are left to their parents
+		TMap<uint64, TArray<int32>> Candidates;
+		for (int32 Index = 0; Index < InContext.OldNodes.Num(); ++Index)
+		{
+			const FTreeSitterFlatNode& Node = InContext.OldNodes[Index];
+			if (Node.IsNamed() && Node.SubtreeSize > 1)
+			{
+				Candidates.FindOrAdd(Node.Hash).Add(Index);
+			}
+		}
+
+		TArray<int32> NewIndices;
+		for (int32 Index = 0; Index < InContext.NewNodes.Num(); ++Index)
+		{
+			const FTreeSitterFlatNode& Node = InContext.NewNodes[Index];
+			if (Node.IsNamed() && Node.SubtreeSize > 1 && Candidates.Contains(Node.Hash))
+			{
+				NewIndices.Add(Index);
+			}
+		}
+
+		// Stable, subtrees of the same size are matched in document order
+		Algo::StableSortBy(NewIndices, [&InContext](const int32 InIndex) { return InContext.NewNodes[InIndex].SubtreeSize; }, TGreater<>());
+
+		// Consumed candidates are popped from the front, each list is walked once
+		TMap<uint64, int32> CandidateHeads;
+
+		for (const int32 Index : NewIndices)
+		{
+			// Already part of a larger match
+			if (InContext.NewToOld[Index] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			const FTreeSitterFlatNode& Node = InContext.NewNodes[Index];
+			const TArray<int32>& NodeCandidates = Candidates.FindChecked(Node.Hash);
+
+			int32& Head = CandidateHeads.FindOrAdd(Node.Hash);
+			while (NodeCandidates.IsValidIndex(Head) && InContext.OldToNew[NodeCandidates[Head]] != INDEX_NONE)
+			{
+				++Head;
+			}
+
+			const int32 OldIndex = NodeCandidates.IsValidIndex(Head) ? NodeCandidates[Head] : INDEX_NONE;
+			if (OldIndex != INDEX_NONE && InContext.OldNodes[OldIndex].SubtreeSize == Node.SubtreeSize)
+			{
+				InContext.MapSubtree(OldIndex, Index);
+			}
+		}
+	}
+
+	/** Matches unmatched parents with the old parent most of their matched children come from */
+	static void MatchParents(const FDiffContext& InContext)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UE::TreeSitter::Diff::MatchParents);
+
+		if (InContext.NewToOld[0] == INDEX_NONE && InContext.OldToNew[0] == INDEX_NONE && InContext.OldNodes[0].Symbol == InContext.NewNodes[0].Symbol)
+		{
+			InContext.Map(0, 0);
+		}
+
+		// Backwards, so that children are matched before their parents
+		TMap<int32, int32> Votes;
+		for (int32 Index = InContext.NewNodes.Num() - 1; Index >= 0; --Index)
+		{
+			const FTreeSitterFlatNode& Node = InContext.NewNodes[Index];
+			if (!Node.IsNamed() || Node.SubtreeSize == 1 || InContext.NewToOld[Index] != INDEX_NONE)
+			{
+				continue;
+			}
+
+			Votes.Reset();
+			ForEachChild(InContext.NewNodes, Index, [&InContext, &Node, &Votes](const int32 InChildIndex)
+			{
+				const int32 OldChildIndex = InContext.NewToOld[InChildIndex];
+				const int32 OldParentIndex = OldChildIndex != INDEX_NONE ? InContext.OldNodes[OldChildIndex].Parent : INDEX_NONE;
+				if (OldParentIndex != INDEX_NONE && InContext.OldToNew[OldParentIndex] == INDEX_NONE && InContext.OldNodes[OldParentIndex].Symbol == Node.Symbol)
+				{
+					++Votes.FindOrAdd(OldParentIndex);
+				}
+			});
+
+			int32 BestOldIndex = INDEX_NONE;
+			int32 BestVotes = 0;
+			for (const TPair<int32, int32>& Vote : Votes)
+			{
+				if (Vote.Value > BestVotes)
+				{
+					BestOldIndex = Vote.Key;
+					BestVotes = Vote.Value;
+				}
+			}
+
+			if (BestOldIndex != INDEX_NONE)
+			{
+				InContext.Map(BestOldIndex, Index);
+			}
+		}
+	}
+
+	/** Matches the remaining named children of matched parents, by hash then by symbol, in order */
+	static void MatchRemainingChildren(const FDiffContext& InContext)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UE::TreeSitter::Diff::MatchRemainingChildren);
+
+		TArray<int32> OldChildren;
+		TArray<int32> NewChildren;
+		TMap<uint64, TArray<int32>> OldChildrenByKey;
+
+		// Forwards, children matched here get their own children matched when reached
+		for (int32 Index = 0; Index < InContext.NewNodes.Num(); ++Index)
+		{
+			const int32 OldIndex = InContext.NewToOld[Index];
+			if (OldIndex == INDEX_NONE || !InContext.NewNodes[Index].IsNamed())
+			{
+				continue;
+			}
+
+			OldChildren.Reset();
+			NewChildren.Reset();
+			ForEachChild(InContext.OldNodes, OldIndex, [&InContext, &OldChildren](const int32 InChildIndex)
+			{
+				if (InContext.OldNodes[InChildIndex].IsNamed() && InContext.OldToNew[InChildIndex] == INDEX_NONE)
+				{
+					OldChildren.Add(InChildIndex);
+				}
+			});
+			ForEachChild(InContext.NewNodes, Index, [&InContext, &NewChildren](const int32 InChildIndex)
+			{
+				if (InContext.NewNodes[InChildIndex].IsNamed() && InContext.NewToOld[InChildIndex] == INDEX_NONE)
+				{
+					NewChildren.Add(InChildIndex);
+				}
+			});
+
+			if (OldChildren.IsEmpty() || NewChildren.IsEmpty())
+			{
+				continue;
+			}
+
+			for (const bool bByHash : { true, false })
+			{
+				OldChildrenByKey.Reset();
+				for (const int32 OldChildIndex : OldChildren)
+				{
+					if (InContext.OldToNew[OldChildIndex] == INDEX_NONE)
+					{
+						const FTreeSitterFlatNode& OldChild = InContext.OldNodes[OldChildIndex];
+						OldChildrenByKey.FindOrAdd(bByHash ? OldChild.Hash : OldChild.Symbol).Add(OldChildIndex);
+					}
+				}
+
+				// Lists are reversed so that the first child in document order is popped first
+				for (TPair<uint64, TArray<int32>>& Pair : OldChildrenByKey)
+				{
+					Algo::Reverse(Pair.Value);
+				}
+
+				for (const int32 NewChildIndex : NewChildren)
+				{
+					const FTreeSitterFlatNode& NewChild = InContext.NewNodes[NewChildIndex];
+					TArray<int32>* Matches = InContext.NewToOld[NewChildIndex] == INDEX_NONE ? OldChildrenByKey.Find(bByHash ? NewChild.Hash : NewChild.Symbol) : nullptr;
+					if (Matches && !Matches->IsEmpty())
+					{
+						const int32 OldChildIndex = Matches->Pop();
+						if (bByHash && InContext.OldNodes[OldChildIndex].SubtreeSize == NewChild.SubtreeSize)
+						{
+							InContext.MapSubtree(OldChildIndex, NewChildIndex);
+						}
+						else
+						{
+							InContext.Map(OldChildIndex, NewChildIndex);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	static void AddEdits(const FDiffContext& InContext, TArray<FTreeSitterDiffEdit>& OutEdits)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UE::TreeSitter::Diff::AddEdits);
+
+		// Children kept under the same parent are only moved when out of order, i.e. not in the longest run of
+		// children whose old order is preserved
+		TBitArray<> Reordered(false, InContext.NewNodes.Num());
+		TArray<int32> Children;
+		TArray<int32> OldPositions;
+		for (int32 Index = 0; Index < InContext.NewNodes.Num(); ++Index)
+		{
+			if (InContext.NewToOld[Index] == INDEX_NONE || InContext.NewNodes[Index].SubtreeSize == 1)
+			{
+				continue;
+			}
+
+			Children.Reset();
+			OldPositions.Reset();
+			ForEachChild(InContext.NewNodes, Index, [&InContext, &Children, &OldPositions, Index](const int32 InChildIndex)
+			{
+				const int32 OldChildIndex = InContext.NewToOld[InChildIndex];
+				if (InContext.NewNodes[InChildIndex].IsNamed() && OldChildIndex != INDEX_NONE && InContext.OldNodes[OldChildIndex].Parent == InContext.NewToOld[Index])
+				{
+					Children.Add(InChildIndex);
+					OldPositions.Add(OldChildIndex);
+				}
+			});
+
+			const TBitArray<> InOrder = GetLongestIncreasingSubsequence(OldPositions);
+			for (int32 ChildPosition = 0; ChildPosition < Children.Num(); ++ChildPosition)
+			{
+				Reordered[Children[ChildPosition]] = !InOrder[ChildPosition];
+			}
+		}
+
+		for (int32 Index = 0; Index < InContext.NewNodes.Num(); ++Index)
+		{
+			const FTreeSitterFlatNode& Node = InContext.NewNodes[Index];
+			if (!Node.IsNamed())
+			{
+				continue;
+			}
+
+			const int32 OldIndex = InContext.NewToOld[Index];
+			if (OldIndex == INDEX_NONE)
+			{
+				// Descendants of an inserted node are part of the insert
+				if (Node.Parent == INDEX_NONE || InContext.NewToOld[Node.Parent] != INDEX_NONE)
+				{
+					OutEdits.Add({ ETreeSitterDiffOperation::Insert, INDEX_NONE, Index });
+				}
+				continue;
+			}
+
+			const int32 OldParentIndex = InContext.OldNodes[OldIndex].Parent;
+			const bool bReparented = Node.Parent != INDEX_NONE && (OldParentIndex == INDEX_NONE || InContext.OldToNew[OldParentIndex] != Node.Parent);
+			if (bReparented || Reordered[Index])
+			{
+				OutEdits.Add({ ETreeSitterDiffOperation::Move, OldIndex, Index });
+			}
+
+			if (InContext.OldNodes[OldIndex].Hash != Node.Hash && !HasNamedChildren(InContext.NewNodes, Index) && !HasNamedChildren(InContext.OldNodes, OldIndex))
+			{
+				OutEdits.Add({ ETreeSitterDiffOperation::Update, OldIndex, Index });
+			}
+		}
+
+		for (int32 Index = 0; Index < InContext.OldNodes.Num(); ++Index)
+		{
+			const FTreeSitterFlatNode& Node = InContext.OldNodes[Index];
+			if (Node.IsNamed() && InContext.OldToNew[Index] == INDEX_NONE && (Node.Parent == INDEX_NONE || InContext.OldToNew[Node.Parent] != INDEX_NONE))
+			{
+				OutEdits.Add({ ETreeSitterDiffOperation::Delete, Index, INDEX_NONE });
+			}
+		}
+	}
+}
+
+void UE::TreeSitter::DiffTrees(const TSharedRef<const FTreeSitterFlatTree>& InOldTree, const TSharedRef<const FTreeSitterFlatTree>& InNewTree, FTreeSitterTreeDiff& OutDiff)
+{
+	using namespace UE::TreeSitter::Diff;
+	TRACE_CPUPROFILER_EVENT_SCOPE(UE::TreeSitter::DiffTrees);
+
+	OutDiff.OldTree = InOldTree;
+	OutDiff.NewTree = InNewTree;
+	OutDiff.Edits.Reset();
+	OutDiff.OldToNew.Init(INDEX_NONE, InOldTree->GetNodes().Num());
+	OutDiff.NewToOld.Init(INDEX_NONE, InNewTree->GetNodes().Num());
+
+	if (InOldTree->GetNodes().IsEmpty() || InNewTree->GetNodes().IsEmpty())
+	{
+		return;
+	}
+
+	const FDiffContext Context{ InOldTree->GetNodes(), InNewTree->GetNodes(), OutDiff.OldToNew, OutDiff.NewToOld };
+	MatchIdenticalSubtrees(Context);
+	MatchParents(Context);
+	MatchRemainingChildren(Context);
+	AddEdits(Context, OutDiff.Edits);
+}
+
+void UE::TreeSitter::DiffTrees(const TSTree* InOldTree, const FTreeSitterSource& InOldSource, const TSTree* InNewTree, const FTreeSitterSource& InNewSource, FTreeSitterTreeDiff& OutDiff)
+{
+	DiffTrees(FTreeSitterFlatTree::Build(InOldTree, InOldSource), FTreeSitterFlatTree::Build(InNewTree, InNewSource), OutDiff);
+}
@@ -0,0 +1,189 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterFlatTree.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Hash/xxhash.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::FlatTree
+{
+	/**
+	 * Hash of text no node covers. Surrounding whitespace is ignored and inner runs count as a single space, so that
+	 * layout alone does not change hashes. Zero when there is only whitespace.
+	 */
+	static uint64 HashGap(const ANSICHAR* InText, uint32 InStartByte, uint32 InEndByte, TArray<ANSICHAR, TInlineAllocator<256>>& OutScratch)
+	{
+		while (InStartByte < InEndByte && FCharAnsi::IsWhitespace(InText[InStartByte]))
+		{
+			++InStartByte;
+		}
+		while (InEndByte > InStartByte && FCharAnsi::IsWhitespace(InText[InEndByte - 1]))
+		{
+			--InEndByte;
+		}
+		if (InStartByte == InEndByte)
+		{
+			return 0;
+		}
+
+		OutScratch.Reset();
+		for (uint32 Byte = InStartByte; Byte < InEndByte; ++Byte)
+		{
+			if (!FCharAnsi::IsWhitespace(InText[Byte]))
+			{
+				OutScratch.Add(InText[Byte]);
+			}
+			else if (OutScratch.Last() != ' ')
+			{
+				OutScratch.Add(' ');
+			}
+		}
+		return FXxHash64::HashBuffer(OutScratch.GetData(), OutScratch.Num()).Hash;
+	}
+}
+
+TSharedRef<FTreeSitterFlatTree> FTreeSitterFlatTree::Build(const TSTree* InTree, const FTreeSitterSource& InSource)
+{
+	using namespace UE::TreeSitter::FlatTree;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterFlatTree::Build);
+
+	const TSNode Root = ts_tree_root_node(InTree);
+
+	TArray<FTreeSitterFlatNode> Nodes;
+	Nodes.Reserve(ts_node_descendant_count(Root));
+
+	// Index of the node at each depth of the current path, to patch subtree sizes once leaving them
+	TArray<int32, TInlineAllocator<64>> Path;
+
+	TSTreeCursor Cursor = ts_tree_cursor_new(Root);
+	bool bDone = false;
+	while (!bDone)
+	{
+		const TSNode Node = ts_tree_cursor_current_node(&Cursor);
+		const TSPoint StartPoint = ts_node_start_point(Node);
+
+		FTreeSitterFlatNode& FlatNode = Nodes.AddDefaulted_GetRef();
+		FlatNode.StartByte = ts_node_start_byte(Node);
+		FlatNode.EndByte = ts_node_end_byte(Node);
+		FlatNode.StartRow = StartPoint.row;
+		FlatNode.StartColumn = StartPoint.column;
+		FlatNode.Parent = Path.IsEmpty() ? INDEX_NONE : Path.Last();
+		FlatNode.Symbol = ts_node_symbol(Node);
+		FlatNode.FieldId = ts_tree_cursor_current_field_id(&Cursor);
+		FlatNode.Flags = (ts_node_is_named(Node) ? ETreeSitterFlatNodeFlags::Named : ETreeSitterFlatNodeFlags::None)
+			| (ts_node_is_missing(Node) ? ETreeSitterFlatNodeFlags::Missing : ETreeSitterFlatNodeFlags::None)
+			| (ts_node_is_extra(Node) ? ETreeSitterFlatNodeFlags::Extra : ETreeSitterFlatNodeFlags::None)
+			| (ts_node_is_error(Node) ? ETreeSitterFlatNodeFlags::Error : ETreeSitterFlatNodeFlags::None)
+			| (ts_node_has_error(Node) ? ETreeSitterFlatNodeFlags::HasError : ETreeSitterFlatNodeFlags::None);
+
+		if (ts_tree_cursor_goto_first_child(&Cursor))
+		{
+			Path.Add(Nodes.Num() - 1);
+			continue;
+		}
+
+		while (!ts_tree_cursor_goto_next_sibling(&Cursor))
+		{
+			if (!ts_tree_cursor_goto_parent(&Cursor))
+			{
+				bDone = true;
+				break;
+			}
+
+			const int32 ParentIndex = Path.Pop();
+			Nodes[ParentIndex].SubtreeSize = Nodes.Num() - ParentIndex;
+		}
+	}
+	ts_tree_cursor_delete(&Cursor);
+
+	// Children come after their parent in pre-order, walking backwards hashes every child before its parent
+	const ANSICHAR* Text = InSource.GetUTF8();
+	const uint32 TextLength = InSource.GetUTF8Length();
+	TArray<uint64, TInlineAllocator<32>> HashInput;
+	TArray<ANSICHAR, TInlineAllocator<256>> GapScratch;
+	for (int32 Index = Nodes.Num() - 1; Index >= 0; --Index)
+	{
+		FTreeSitterFlatNode& Node = Nodes[Index];
+		const uint32 StartByte = FMath::Min(Node.StartByte, TextLength);
+		const uint32 EndByte = FMath::Clamp(Node.EndByte, StartByte, TextLength);
+		if (Node.SubtreeSize == 1)
+		{
+			Node.Hash = FXxHash64::HashBufferWithSeed(Text + StartByte, EndByte - StartByte, Node.Symbol).Hash;
+			continue;
+		}
+
+		// Text between children belongs to no child, e.g. the plain text around emphasis in Markdown inlines
+		HashInput.Reset();
+		HashInput.Add(Node.Symbol);
+		uint32 GapStartByte = StartByte;
+		for (int32 ChildIndex = Index + 1; ChildIndex < Index + static_cast<int32>(Node.SubtreeSize); ChildIndex += Nodes[ChildIndex].SubtreeSize)
+		{
+			const FTreeSitterFlatNode& Child = Nodes[ChildIndex];
+			const uint32 ChildStartByte = FMath::Clamp(Child.StartByte, GapStartByte, EndByte);
+			if (const uint64 GapHash = HashGap(Text, GapStartByte, ChildStartByte, GapScratch))
+			{
+				HashInput.Add(GapHash);
+			}
+			HashInput.Add(Child.Hash);
+			GapStartByte = FMath::Clamp(Child.EndByte, ChildStartByte, EndByte);
+		}
+		if (const uint64 GapHash = HashGap(Text, GapStartByte, EndByte, GapScratch))
+		{
+			HashInput.Add(GapHash);
+		}
+		Node.Hash = FXxHash64::HashBuffer(HashInput.GetData(), HashInput.NumBytes()).Hash;
+	}
+
+	return MakeShared<FTreeSitterFlatTree>(ts_tree_language(InTree), MoveTemp(Nodes));
+}
+
+FTreeSitterFlatTree::FTreeSitterFlatTree(const TSLanguage* InLanguage, TArray<FTreeSitterFlatNode>&& InNodes)
+	: Language(InLanguage)
+	, OwnedNodes(MoveTemp(InNodes))
+	, Nodes(OwnedNodes)
+{
+}
+
+FTreeSitterFlatTree::FTreeSitterFlatTree(const TSLanguage* InLanguage, TUniquePtr<IMappedFileHandle> InMappedFile, TUniquePtr<IMappedFileRegion> InMappedRegion, const TConstArrayView<FTreeSitterFlatNode> InNodes)
+	: Language(InLanguage)
+	, MappedFile(MoveTemp(InMappedFile))
+	, MappedRegion(MoveTemp(InMappedRegion))
+	, Nodes(InNodes)
+{
+}
+
+FTreeSitterFlatTree::~FTreeSitterFlatTree()
+{
+	// The region must be unmapped before its file is closed
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+const char* FTreeSitterFlatTree::GetNodeType(const FTreeSitterFlatNode& InNode) const
+{
+	return Language ? ts_language_symbol_name(Language, InNode.Symbol) : "";
+}
+
+void FTreeSitterFlatTree::ForEachSyntaxError(const TFunctionRef<void(const FTreeSitterFlatNode&)>& InCallback) const
+{
+	int32 Index = 0;
+	while (Nodes.IsValidIndex(Index))
+	{
+		const FTreeSitterFlatNode& Node = Nodes[Index];
+		if (Node.IsError() || Node.IsMissing())
+		{
+			InCallback(Node);
+			Index += Node.SubtreeSize;
+		}
+		else if (Node.HasError())
+		{
+			++Index;
+		}
+		else
+		{
+			Index += Node.SubtreeSize;
+		}
+	}
+}
@@ -0,0 +1,191 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterHighlighter.h"
+
+#include "TreeSitterMemory.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+FTreeSitterHighlighter::FTreeSitterHighlighter(const TSharedRef<const FTreeSitterQuery>& InQuery)
+	: Query(InQuery)
+{
+}
+
+FTreeSitterHighlighter::~FTreeSitterHighlighter()
+{
+	ts_tree_delete(Tree);
+}
+
+void FTreeSitterHighlighter::SetTree(const TSTree* InTree, const TSharedRef<const FTreeSitterSource>& InSource)
+{
+	ts_tree_delete(Tree);
+	Tree = InTree ? ts_tree_copy(InTree) : nullptr;
+	Source = InSource;
+	Blocks.Reset();
+	UpdateLineStarts();
+}
+
+void FTreeSitterHighlighter::UpdateTree(const TSInputEdit& InEdit, const TSTree* InOldTree, const TSTree* InTree, const TSharedRef<const FTreeSitterSource>& InSource)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterHighlighter::UpdateTree);
+
+	int32 FirstDirtyLine = InEdit.start_point.row;
+	int32 EndDirtyLine = InEdit.new_end_point.row + 1;
+
+	uint32 RangeCount = 0;
+	TSRange* Ranges = ts_tree_get_changed_ranges(InOldTree, InTree, &RangeCount);
+	for (uint32 Index = 0; Index < RangeCount; ++Index)
+	{
+		FirstDirtyLine = FMath::Min<int32>(FirstDirtyLine, Ranges[Index].start_point.row);
+		EndDirtyLine = FMath::Max<int32>(EndDirtyLine, Ranges[Index].end_point.row + 1);
+	}
+	UE::TreeSitter::Free(Ranges);
+
+	// Rows after an edit changing the line count have moved
+	if (InEdit.new_end_point.row != InEdit.old_end_point.row)
+	{
+		EndDirtyLine = MAX_int32;
+	}
+
+	const int32 FirstDirtyBlock = FirstDirtyLine / LinesPerBlock;
+	const int32 EndDirtyBlock = EndDirtyLine == MAX_int32 ? MAX_int32 : (EndDirtyLine + LinesPerBlock - 1) / LinesPerBlock;
+	for (auto It = Blocks.CreateIterator(); It; ++It)
+	{
+		if (It.Key() >= FirstDirtyBlock && It.Key() < EndDirtyBlock)
+		{
+			It.RemoveCurrent();
+		}
+	}
+
+	ts_tree_delete(Tree);
+	Tree = InTree ? ts_tree_copy(InTree) : nullptr;
+	Source = InSource;
+	UpdateLineStarts();
+}
+
+void FTreeSitterHighlighter::GetLineSpans(const int32 InFirstLine, const int32 InEndLine, TArray<TArray<FTreeSitterHighlightSpan>>& OutLineSpans)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterHighlighter::GetLineSpans);
+
+	const int32 FirstLine = FMath::Max(InFirstLine, 0);
+	const int32 EndLine = FMath::Min(InEndLine, LineStarts.Num());
+
+	OutLineSpans.Reset();
+	OutLineSpans.SetNum(FMath::Max(EndLine - FirstLine, 0));
+
+	for (int32 Line = FirstLine; Line < EndLine; ++Line)
+	{
+		const FBlock& Block = FindOrQueryBlock(Line / LinesPerBlock);
+		const int32 LineInBlock = Line % LinesPerBlock;
+		if (Block.LineSpanStarts.IsValidIndex(LineInBlock + 1))
+		{
+			const int32 SpanStart = Block.LineSpanStarts[LineInBlock];
+			OutLineSpans[Line - FirstLine].Append(Block.Spans.GetData() + SpanStart, Block.LineSpanStarts[LineInBlock + 1] - SpanStart);
+		}
+	}
+}
+
+FName FTreeSitterHighlighter::GetCaptureName(const uint16 InCapture) const
+{
+	return Query->GetCaptureName(InCapture);
+}
+
+const FTreeSitterHighlighter::FBlock& FTreeSitterHighlighter::FindOrQueryBlock(const int32 InBlockIndex)
+{
+	if (const FBlock* Block = Blocks.Find(InBlockIndex))
+	{
+		return *Block;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterHighlighter::QueryBlock);
+
+	FBlock& Block = Blocks.Add(InBlockIndex);
+	if (!Tree || !Source.IsValid() || !Query->IsValid())
+	{
+		return Block;
+	}
+
+	const int32 FirstLine = InBlockIndex * LinesPerBlock;
+	const int32 EndLine = FMath::Min(FirstLine + LinesPerBlock, LineStarts.Num());
+	const uint32 TextLength = Source->GetUTF8Length();
+
+	// Spans are gathered per line first, captures of a node spanning several lines coming in any order
+	TArray<TArray<FTreeSitterHighlightSpan>, TInlineAllocator<LinesPerBlock>> LineSpans;
+	LineSpans.SetNum(EndLine - FirstLine);
+
+	TSQueryCursor* Cursor = ts_query_cursor_new();
+	ts_query_cursor_set_point_range(Cursor, TSPoint({ .row = static_cast<uint32>(FirstLine), .column = 0 }), TSPoint({ .row = static_cast<uint32>(EndLine), .column = 0 }));
+	ts_query_cursor_exec(Cursor, Query->Get(), ts_tree_root_node(Tree));
+
+	uint32 PreviousStartByte = MAX_uint32;
+	uint32 PreviousEndByte = MAX_uint32;
+
+	TSQueryMatch Match;
+	uint32 CaptureIndex = 0;
+	while (ts_query_cursor_next_capture(Cursor, &Match, &CaptureIndex))
+	{
+		const TSQueryCapture& Capture = Match.captures[CaptureIndex];
+		const uint32 StartByte = ts_node_start_byte(Capture.node);
+		const uint32 EndByte = FMath::Min(ts_node_end_byte(Capture.node), TextLength);
+
+		// Same node captured by a later pattern
+		if (StartByte == PreviousStartByte && EndByte == PreviousEndByte)
+		{
+			continue;
+		}
+		PreviousStartByte = StartByte;
+		PreviousEndByte = EndByte;
+
+		const int32 StartLine = FMath::Max<int32>(ts_node_start_point(Capture.node).row, FirstLine);
+		const int32 LastLine = FMath::Min<int32>(ts_node_end_point(Capture.node).row, EndLine - 1);
+		for (int32 Line = StartLine; Line <= LastLine; ++Line)
+		{
+			const uint32 LineStartByte = LineStarts[Line];
+			const uint32 LineEndByte = LineStarts.IsValidIndex(Line + 1) ? LineStarts[Line + 1] : TextLength;
+			const uint32 SpanStartByte = FMath::Max(StartByte, LineStartByte);
+			const uint32 SpanEndByte = FMath::Min(EndByte, LineEndByte);
+			if (SpanEndByte <= SpanStartByte)
+			{
+				continue;
+			}
+
+			const int32 LineStartChar = Source->GetCharIndex(LineStartByte);
+			LineSpans[Line - FirstLine].Add({ Source->GetCharIndex(SpanStartByte) - LineStartChar, Source->GetCharIndex(SpanEndByte) - LineStartChar, static_cast<uint16>(Capture.index) });
+		}
+	}
+
+	ts_query_cursor_delete(Cursor);
+
+	Block.LineSpanStarts.Reserve(LineSpans.Num() + 1);
+	for (const TArray<FTreeSitterHighlightSpan>& Spans : LineSpans)
+	{
+		Block.LineSpanStarts.Add(Block.Spans.Num());
+		Block.Spans.Append(Spans);
+	}
+	Block.LineSpanStarts.Add(Block.Spans.Num());
+
+	return Block;
+}
+
+void FTreeSitterHighlighter::UpdateLineStarts()
+{
+	LineStarts.Reset();
+	if (!Source.IsValid())
+	{
+		return;
+	}
+
+	const ANSICHAR* Text = Source->GetUTF8();
+	const uint32 TextLength = Source->GetUTF8Length();
+
+	LineStarts.Add(0);
+	for (uint32 Index = 0; Index < TextLength; ++Index)
+	{
+		if (Text[Index] == '\n')
+		{
+			LineStarts.Add(Index + 1);
+		}
+	}
+}
@@ -0,0 +1,127 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterLanguages.h"
+
+#include "HAL/FileManager.h"
+#include "ITreeSitterModule.h"
+#include "Misc/Paths.h"
+
+namespace UE::TreeSitter
+{
+	const TCHAR* GetLanguageName(const ETreeSitterLanguage InLanguage)
+	{
+		switch (InLanguage)
+		{
+		case ETreeSitterLanguage::JavaScript:
+			return TEXT("JavaScript");
+		case ETreeSitterLanguage::Json:
+			return TEXT("Json");
+		case ETreeSitterLanguage::Markdown:
+			return TEXT("Markdown");
+		case ETreeSitterLanguage::MarkdownInline:
+			return TEXT("MarkdownInline");
+		case ETreeSitterLanguage::C:
+			return TEXT("C");
+		case ETreeSitterLanguage::Cpp:
+			return TEXT("Cpp");
+		case ETreeSitterLanguage::Python:
+			return TEXT("Python");
+		case ETreeSitterLanguage::Yaml:
+			return TEXT("Yaml");
+		}
+
+		return TEXT("Unknown");
+	}
+
+	bool FindLanguageByName(const FString& InName, ETreeSitterLanguage& OutLanguage)
+	{
+		for (const ETreeSitterLanguage Language : {
+			ETreeSitterLanguage::JavaScript,
+			ETreeSitterLanguage::Json,
+			ETreeSitterLanguage::Markdown,
+			ETreeSitterLanguage::C,
+			ETreeSitterLanguage::Cpp,
+			ETreeSitterLanguage::Python,
+			ETreeSitterLanguage::Yaml,
+		})
+		{
+			if (InName.Equals(GetLanguageName(Language), ESearchCase::IgnoreCase))
+			{
+				OutLanguage = Language;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	bool FindLanguageForExtension(const FString& InExtension, ETreeSitterLanguage& OutLanguage)
+	{
+		if (InExtension == TEXT("js") || InExtension == TEXT("mjs") || InExtension == TEXT("cjs"))
+		{
+			OutLanguage = ETreeSitterLanguage::JavaScript;
+			return true;
+		}
+
+		if (InExtension == TEXT("json") || InExtension == TEXT("uplugin") || InExtension == TEXT("uproject"))
+		{
+			OutLanguage = ETreeSitterLanguage::Json;
+			return true;
+		}
+
+		if (InExtension == TEXT("md") || InExtension == TEXT("markdown"))
+		{
+			OutLanguage = ETreeSitterLanguage::Markdown;
+			return true;
+		}
+
+		if (InExtension == TEXT("c"))
+		{
+			OutLanguage = ETreeSitterLanguage::C;
+			return true;
+		}
+
+		// Headers are C++ in Unreal projects
+		if (InExtension == TEXT("cpp") || InExtension == TEXT("cc") || InExtension == TEXT("cxx") || InExtension == TEXT("h") || InExtension == TEXT("hpp") || InExtension == TEXT("inl"))
+		{
+			OutLanguage = ETreeSitterLanguage::Cpp;
+			return true;
+		}
+
+		if (InExtension == TEXT("py"))
+		{
+			OutLanguage = ETreeSitterLanguage::Python;
+			return true;
+		}
+
+		if (InExtension == TEXT("yaml") || InExtension == TEXT("yml"))
+		{
+			OutLanguage = ETreeSitterLanguage::Yaml;
+			return true;
+		}
+
+		return false;
+	}
+
+	TArray<TPair<FString, ETreeSitterLanguage>> FindLanguageFiles(const TArray<FString>& InDirectories, const TFunctionRef<bool(ETreeSitterLanguage)>& InFilter)
+	{
+		TArray<TPair<FString, ETreeSitterLanguage>> LanguageFiles;
+		for (const FString& Directory : InDirectories)
+		{
+			TArray<FString> Files;
+			IFileManager::Get().FindFilesRecursive(Files, *Directory, TEXT("*.*"), true, false);
+
+			for (FString& File : Files)
+			{
+				ETreeSitterLanguage Language;
+				if (FindLanguageForExtension(FPaths::GetExtension(File), Language) && InFilter(Language))
+				{
+					LanguageFiles.Emplace(MoveTemp(File), Language);
+				}
+			}
+		}
+
+		LanguageFiles.Sort([](const TPair<FString, ETreeSitterLanguage>& A, const TPair<FString, ETreeSitterLanguage>& B) { return A.Key < B.Key; });
+		return LanguageFiles;
+	}
+}
@@ -0,0 +1,189 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterLint.h"
+
+#include "TreeSitterMemory.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+FTreeSitterLinter::FTreeSitterLinter(const TSLanguage* InLanguage, TArray<FTreeSitterLintRule> InRules)
+	: Rules(MoveTemp(InRules))
+{
+	// Rules are compiled one by one first, to report errors per rule and know which patterns of the combined query
+	// come from which rule
+	FString CombinedSource;
+	for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); ++RuleIndex)
+	{
+		const FTreeSitterQuery RuleQuery(InLanguage, Rules[RuleIndex].Query);
+		if (!RuleQuery.IsValid())
+		{
+			Error = FString::Printf(TEXT("Rule %s: %s"), *Rules[RuleIndex].Id.ToString(), *RuleQuery.GetError());
+			return;
+		}
+
+		const bool bHasLintCapture = RuleQuery.FindCaptureIndex(TEXT("lint")) != INDEX_NONE;
+		const uint32 PatternCount = ts_query_pattern_count(RuleQuery.Get());
+		for (uint32 Index = 0; Index < PatternCount; ++Index)
+		{
+			PatternRules.Add(RuleIndex);
+			PatternHasLintCapture.Add(bHasLintCapture);
+		}
+
+		CombinedSource += Rules[RuleIndex].Query;
+		CombinedSource += TEXT("\n");
+	}
+
+	Query = MakeShared<FTreeSitterQuery>(InLanguage, CombinedSource);
+	if (!Query->IsValid())
+	{
+		Error = Query->GetError();
+		return;
+	}
+
+	check(static_cast<uint32>(PatternRules.Num()) == ts_query_pattern_count(Query->Get()));
+	LintCapture = Query->FindCaptureIndex(TEXT("lint"));
+}
+
+bool FTreeSitterLinter::IsValid() const
+{
+	return Error.IsEmpty() && Query.IsValid();
+}
+
+const FString& FTreeSitterLinter::GetError() const
+{
+	return Error;
+}
+
+void FTreeSitterLinter::Lint(const TSTree* InTree, const FTreeSitterSource& InSource, TArray<FTreeSitterLintDiagnostic>& OutDiagnostics) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterLinter::Lint);
+
+	OutDiagnostics.Reset();
+	if (IsValid() && InTree)
+	{
+		LintRange(ts_tree_root_node(InTree), InSource, 0, MAX_uint32, OutDiagnostics);
+	}
+}
+
+void FTreeSitterLinter::UpdateDiagnostics(const TSInputEdit& InEdit, const TSTree* InOldTree, const TSTree* InTree, const FTreeSitterSource& InSource, TArray<FTreeSitterLintDiagnostic>& InOutDiagnostics) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterLinter::UpdateDiagnostics);
+
+	if (!IsValid() || !InTree)
+	{
+		return;
+	}
+
+	// Region to lint again, in new byte offsets
+	uint32 RegionStart = InEdit.start_byte;
+	uint32 RegionEnd = InEdit.new_end_byte;
+
+	uint32 RangeCount = 0;
+	TSRange* Ranges = ts_tree_get_changed_ranges(InOldTree, InTree, &RangeCount);
+	for (uint32 Index = 0; Index < RangeCount; ++Index)
+	{
+		RegionStart = FMath::Min(RegionStart, Ranges[Index].start_byte);
+		RegionEnd = FMath::Max(RegionEnd, Ranges[Index].end_byte);
+	}
+	UE::TreeSitter::Free(Ranges);
+
+	// Drop the matches the edit went through and shift what follows it, then drop the matches reaching the region, linted
+	// again below. Matches are tested as a whole, another capture than the reported one may have changed.
+	InOutDiagnostics.RemoveAll([&InEdit](const FTreeSitterLintDiagnostic& Diagnostic)
+	{
+		return Diagnostic.MatchStartByte <= InEdit.old_end_byte && Diagnostic.MatchEndByte >= InEdit.start_byte;
+	});
+
+	const int64 ByteDelta = static_cast<int64>(InEdit.new_end_byte) - InEdit.old_end_byte;
+	const int64 RowDelta = static_cast<int64>(InEdit.new_end_point.row) - InEdit.old_end_point.row;
+	for (FTreeSitterLintDiagnostic& Diagnostic : InOutDiagnostics)
+	{
+		if (Diagnostic.MatchStartByte > InEdit.old_end_byte)
+		{
+			Diagnostic.StartByte += ByteDelta;
+			Diagnostic.EndByte += ByteDelta;
+			Diagnostic.MatchStartByte += ByteDelta;
+			Diagnostic.MatchEndByte += ByteDelta;
+			Diagnostic.Row += RowDelta;
+		}
+	}
+
+	InOutDiagnostics.RemoveAll([RegionStart, RegionEnd](const FTreeSitterLintDiagnostic& Diagnostic)
+	{
+		return Diagnostic.MatchStartByte <= RegionEnd && Diagnostic.MatchEndByte >= RegionStart;
+	});
+
+	// Matches reaching the region may be reported before it, the kept diagnostics are merged back by start
+	LintRange(ts_tree_root_node(InTree), InSource, RegionStart, RegionEnd, InOutDiagnostics);
+	InOutDiagnostics.StableSort([](const FTreeSitterLintDiagnostic& A, const FTreeSitterLintDiagnostic& B)
+	{
+		return A.StartByte < B.StartByte;
+	});
+}
+
+void FTreeSitterLinter::LintRange(const TSNode& InRootNode, const FTreeSitterSource& InSource, const uint32 InStartByte, const uint32 InEndByte, TArray<FTreeSitterLintDiagnostic>& OutDiagnostics) const
+{
+	// Widened by a byte, the cursor range being exclusive, so that nodes touching the region are matched as well
+	TSQueryCursor* Cursor = ts_query_cursor_new();
+	ts_query_cursor_set_byte_range(Cursor, InStartByte > 0 ? InStartByte - 1 : 0, InEndByte < MAX_uint32 ? InEndByte + 1 : MAX_uint32);
+	ts_query_cursor_exec(Cursor, Query->Get(), InRootNode);
+
+	const int32 FirstDiagnostic = OutDiagnostics.Num();
+
+	TSQueryMatch Match;
+	while (ts_query_cursor_next_match(Cursor, &Match))
+	{
+		if (!Query->MatchesPredicates(Match, InSource))
+		{
+			continue;
+		}
+
+		const bool bHasLintCapture = PatternHasLintCapture[Match.pattern_index];
+		const TSQueryCapture* FirstCapture = nullptr;
+		uint32 StartByte = MAX_uint32;
+		uint32 EndByte = 0;
+		uint32 MatchStartByte = MAX_uint32;
+		uint32 MatchEndByte = 0;
+		for (uint16 Index = 0; Index < Match.capture_count; ++Index)
+		{
+			const TSQueryCapture& Capture = Match.captures[Index];
+			const uint32 CaptureStart = ts_node_start_byte(Capture.node);
+			const uint32 CaptureEnd = ts_node_end_byte(Capture.node);
+			MatchStartByte = FMath::Min(MatchStartByte, CaptureStart);
+			MatchEndByte = FMath::Max(MatchEndByte, CaptureEnd);
+
+			if (!bHasLintCapture || Capture.index == static_cast<uint32>(LintCapture))
+			{
+				if (CaptureStart < StartByte)
+				{
+					StartByte = CaptureStart;
+					FirstCapture = &Capture;
+				}
+				EndByte = FMath::Max(EndByte, CaptureEnd);
+			}
+		}
+
+		// Matches only reaching the widened cursor range through their pattern root were not reached by the edit
+		if (!FirstCapture || MatchStartByte > InEndByte || MatchEndByte < InStartByte)
+		{
+			continue;
+		}
+
+		FTreeSitterLintDiagnostic& Diagnostic = OutDiagnostics.AddDefaulted_GetRef();
+		Diagnostic.Rule = PatternRules[Match.pattern_index];
+		Diagnostic.StartByte = StartByte;
+		Diagnostic.EndByte = EndByte;
+		Diagnostic.Row = ts_node_start_point(FirstCapture->node).row;
+		Diagnostic.MatchStartByte = MatchStartByte;
+		Diagnostic.MatchEndByte = MatchEndByte;
+	}
+
+	ts_query_cursor_delete(Cursor);
+
+	MakeArrayView(OutDiagnostics).RightChop(FirstDiagnostic).StableSort([](const FTreeSitterLintDiagnostic& A, const FTreeSitterLintDiagnostic& B)
+	{
+		return A.StartByte < B.StartByte;
+	});
+}
@@ -0,0 +1,435 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterLocals.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+#include "Hash/xxhash.h"
+#include "TreeSitterMemory.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::Locals
+{
+	enum class ELocalCapture : uint8
+	{
+		None,
+		Scope,
+		Definition,
+		Reference,
+	};
+
+	/** Accepts both the current (@local.scope) and legacy (@scope, @definition.var) capture names */
+	static TArray<ELocalCapture> GetLocalCaptures(const FTreeSitterQuery& InQuery)
+	{
+		TArray<ELocalCapture> Captures;
+		const uint32 CaptureCount = ts_query_capture_count(InQuery.Get());
+		Captures.Init(ELocalCapture::None, CaptureCount);
+
+		for (uint32 Index = 0; Index < CaptureCount; ++Index)
+		{
+			FString CaptureName = InQuery.GetCaptureName(Index).ToString();
+			CaptureName.RemoveFromStart(TEXT("local."));
+
+			if (CaptureName == TEXT("scope"))
+			{
+				Captures[Index] = ELocalCapture::Scope;
+			}
+			else if (CaptureName == TEXT("definition") || CaptureName.StartsWith(TEXT("definition.")))
+			{
+				Captures[Index] = ELocalCapture::Definition;
+			}
+			else if (CaptureName == TEXT("reference") || CaptureName.StartsWith(TEXT("reference.")))
+			{
+				Captures[Index] = ELocalCapture::Reference;
+			}
+		}
+
+		return Captures;
+	}
+
+	/** Captures of a byte range, before scopes are assigned */
+	struct FCapturedLocals
+	{
+		TArray<FTreeSitterLocalScope> Scopes;
+		TArray<FTreeSitterLocalDefinition> Definitions;
+		TArray<FTreeSitterLocalReference> References;
+	};
+
+	static uint64 HashName(const FTreeSitterSource& InSource, const uint32 InStartByte, const uint32 InEndByte)
+	{
+		const uint32 EndByte = FMath::Min(InEndByte, InSource.GetUTF8Length());
+		return FXxHash64::HashBuffer(InSource.GetUTF8() + InStartByte, EndByte > InStartByte ? EndByte - InStartByte : 0).Hash;
+	}
+
+	/**
+	 * Runs the query over the nodes within [InStartByte, InEndByte], the node spanning exactly that range excluded
+	 * (it is the scope being updated). Ancestors intersecting the range are reported by the cursor and skipped.
+	 */
+	static void CaptureLocals(const FTreeSitterQuery& InQuery, const TSTree* InTree, const FTreeSitterSource& InSource, const uint32 InStartByte, const uint32 InEndByte, const bool bInExcludeRange, FCapturedLocals& OutLocals)
+	{
+		const TArray<ELocalCapture> Captures = GetLocalCaptures(InQuery);
+
+		TSQueryCursor* Cursor = ts_query_cursor_new();
+		ts_query_cursor_set_byte_range(Cursor, InStartByte, InEndByte);
+		ts_query_cursor_exec(Cursor, InQuery.Get(), ts_tree_root_node(InTree));
+
+		// Definitions are usually also matched by the catch-all reference pattern
+		TSet<uint32> DefinitionStarts;
+
+		TSQueryMatch Match;
+		while (ts_query_cursor_next_match(Cursor, &Match))
+		{
+			for (uint16 Index = 0; Index < Match.capture_count; ++Index)
+			{
+				const TSQueryCapture& Capture = Match.captures[Index];
+				const uint32 StartByte = ts_node_start_byte(Capture.node);
+				const uint32 EndByte = ts_node_end_byte(Capture.node);
+				if (StartByte < InStartByte || EndByte > InEndByte || (bInExcludeRange && StartByte == InStartByte && EndByte == InEndByte))
+				{
+					continue;
+				}
+
+				switch (Captures[Capture.index])
+				{
+				case ELocalCapture::Scope:
+					OutLocals.Scopes.Add({ StartByte, EndByte, INDEX_NONE });
+					break;
+				case ELocalCapture::Definition:
+					OutLocals.Definitions.Add({ HashName(InSource, StartByte, EndByte), StartByte, EndByte, INDEX_NONE });
+					DefinitionStarts.Add(StartByte);
+					break;
+				case ELocalCapture::Reference:
+					OutLocals.References.Add({ HashName(InSource, StartByte, EndByte), StartByte, EndByte, INDEX_NONE, INDEX_NONE });
+					break;
+				default:
+					break;
+				}
+			}
+		}
+
+		ts_query_cursor_delete(Cursor);
+
+		// Pre-order: outer scopes first when starting at the same byte
+		OutLocals.Scopes.Sort([](const FTreeSitterLocalScope& InA, const FTreeSitterLocalScope& InB)
+		{
+			return InA.StartByte != InB.StartByte ? InA.StartByte < InB.StartByte : InA.EndByte > InB.EndByte;
+		});
+		OutLocals.Scopes.SetNum(Algo::Unique(OutLocals.Scopes, [](const FTreeSitterLocalScope& InA, const FTreeSitterLocalScope& InB)
+		{
+			return InA.StartByte == InB.StartByte && InA.EndByte == InB.EndByte;
+		}));
+
+		OutLocals.References.RemoveAll([&DefinitionStarts](const FTreeSitterLocalReference& InReference)
+		{
+			return DefinitionStarts.Contains(InReference.StartByte);
+		});
+
+		OutLocals.Definitions.StableSort([](const FTreeSitterLocalDefinition& InA, const FTreeSitterLocalDefinition& InB) { return InA.StartByte < InB.StartByte; });
+		OutLocals.References.StableSort([](const FTreeSitterLocalReference& InA, const FTreeSitterLocalReference& InB) { return InA.StartByte < InB.StartByte; });
+	}
+
+	/** Innermost scope of each capture, scope indices being offset by InFirstScope and rooted at InParentScope */
+	static void AssignScopes(FCapturedLocals& InOutLocals, const int32 InFirstScope, const int32 InParentScope)
+	{
+		TArray<int32, TInlineAllocator<32>> Stack;
+		int32 NextScope = 0;
+
+		const auto GetInnermostScope = [&InOutLocals, &Stack, &NextScope, InFirstScope, InParentScope](const uint32 InStartByte, const uint32 InEndByte)
+		{
+			// Enter every scope starting before, leave the ones ending before
+			while (InOutLocals.Scopes.IsValidIndex(NextScope) && InOutLocals.Scopes[NextScope].StartByte <= InStartByte)
+			{
+				FTreeSitterLocalScope& Scope = InOutLocals.Scopes[NextScope];
+				while (!Stack.IsEmpty() && InOutLocals.Scopes[Stack.Last()].EndByte < Scope.EndByte)
+				{
+					Stack.Pop();
+				}
+				Scope.Parent = Stack.IsEmpty() ? InParentScope : InFirstScope + Stack.Last();
+				Stack.Add(NextScope++);
+			}
+
+			while (!Stack.IsEmpty() && InOutLocals.Scopes[Stack.Last()].EndByte < InEndByte)
+			{
+				Stack.Pop();
+			}
+			return Stack.IsEmpty() ? InParentScope : InFirstScope + Stack.Last();
+		};
+
+		// Definitions and references are sorted but interleaved, both walks restart from the first scope
+		for (FTreeSitterLocalDefinition& Definition : InOutLocals.Definitions)
+		{
+			Definition.Scope = GetInnermostScope(Definition.StartByte, Definition.EndByte);
+		}
+
+		Stack.Reset();
+		NextScope = 0;
+		for (FTreeSitterLocalReference& Reference : InOutLocals.References)
+		{
+			Reference.Scope = GetInnermostScope(Reference.StartByte, Reference.EndByte);
+		}
+
+		// Scopes not enclosing any capture
+		GetInnermostScope(MAX_uint32, MAX_uint32);
+	}
+
+	template <typename ItemType>
+	static int32 LowerBoundByStart(const TArray<ItemType>& InItems, const uint32 InByteOffset)
+	{
+		return Algo::LowerBoundBy(InItems, InByteOffset, [](const ItemType& InItem) { return InItem.StartByte; });
+	}
+}
+
+FTreeSitterLocals::FTreeSitterLocals(const TSharedRef<const FTreeSitterQuery>& InQuery)
+	: Query(InQuery)
+{
+}
+
+TSharedRef<FTreeSitterLocals> FTreeSitterLocals::Build(const TSharedRef<const FTreeSitterQuery>& InQuery, const TSTree* InTree, const FTreeSitterSource& InSource)
+{
+	using namespace UE::TreeSitter::Locals;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterLocals::Build);
+
+	TSharedRef<FTreeSitterLocals> Locals = MakeShared<FTreeSitterLocals>(InQuery);
+	if (!InQuery->IsValid() || !InTree)
+	{
+		return Locals;
+	}
+
+	FCapturedLocals Captured;
+	CaptureLocals(*InQuery, InTree, InSource, 0, MAX_uint32, false, Captured);
+	AssignScopes(Captured, 0, INDEX_NONE);
+
+	Locals->Scopes = MoveTemp(Captured.Scopes);
+	Locals->Definitions = MoveTemp(Captured.Definitions);
+	Locals->References = MoveTemp(Captured.References);
+	Locals->UpdatedStartByte = 0;
+	Locals->UpdatedEndByte = InSource.GetUTF8Length();
+	Locals->ResolveReferences(0, Locals->References.Num());
+	return Locals;
+}
+
+TSharedRef<FTreeSitterLocals> FTreeSitterLocals::Update(const TSInputEdit& InEdit, const TSTree* InOldTree, const TSTree* InTree, const FTreeSitterSource& InSource) const
+{
+	using namespace UE::TreeSitter::Locals;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterLocals::Update);
+
+	// Changed region in new coordinates: the edit, and whatever tree-sitter restructured around it
+	uint32 RegionStart = InEdit.start_byte;
+	uint32 RegionEnd = InEdit.new_end_byte;
+
+	uint32 RangeCount = 0;
+	TSRange* Ranges = ts_tree_get_changed_ranges(InOldTree, InTree, &RangeCount);
+	for (uint32 Index = 0; Index < RangeCount; ++Index)
+	{
+		RegionStart = FMath::Min(RegionStart, Ranges[Index].start_byte);
+		RegionEnd = FMath::Max(RegionEnd, Ranges[Index].end_byte);
+	}
+	UE::TreeSitter::Free(Ranges);
+
+	const int64 Delta = static_cast<int64>(InEdit.new_end_byte) - static_cast<int64>(InEdit.old_end_byte);
+	const uint32 OldRegionEnd = static_cast<uint32>(RegionEnd - Delta);
+
+	// Innermost scope strictly around the change, still spanning a node of the new tree
+	const TSNode Root = ts_tree_root_node(InTree);
+	int32 DirtyScope = Scopes.IsEmpty() ? INDEX_NONE : LowerBoundByStart(Scopes, RegionStart) - 1;
+	for (; DirtyScope != INDEX_NONE; DirtyScope = Scopes[DirtyScope].Parent)
+	{
+		const FTreeSitterLocalScope& Scope = Scopes[DirtyScope];
+		if (Scope.StartByte >= RegionStart || Scope.EndByte <= OldRegionEnd)
+		{
+			continue;
+		}
+
+		const uint32 NewEndByte = static_cast<uint32>(Scope.EndByte + Delta);
+		const TSNode Node = ts_node_descendant_for_byte_range(Root, Scope.StartByte, NewEndByte);
+		if (ts_node_start_byte(Node) == Scope.StartByte && ts_node_end_byte(Node) == NewEndByte)
+		{
+			break;
+		}
+	}
+
+	if (DirtyScope == INDEX_NONE)
+	{
+		return Build(Query, InTree, InSource);
+	}
+
+	const uint32 DirtyStart = Scopes[DirtyScope].StartByte;
+	const uint32 OldDirtyEnd = Scopes[DirtyScope].EndByte;
+	const uint32 NewDirtyEnd = static_cast<uint32>(OldDirtyEnd + Delta);
+
+	FCapturedLocals Captured;
+	CaptureLocals(*Query, InTree, InSource, DirtyStart, NewDirtyEnd, true, Captured);
+	AssignScopes(Captured, DirtyScope + 1, DirtyScope);
+
+	// Previous items within the dirty scope are replaced, the ones after it shifted
+	int32 OldScopesEnd = DirtyScope + 1;
+	while (Scopes.IsValidIndex(OldScopesEnd) && Scopes[OldScopesEnd].StartByte < OldDirtyEnd)
+	{
+		++OldScopesEnd;
+	}
+	const int32 OldDefinitionsStart = LowerBoundByStart(Definitions, DirtyStart);
+	const int32 OldDefinitionsEnd = LowerBoundByStart(Definitions, OldDirtyEnd);
+	const int32 OldReferencesStart = LowerBoundByStart(References, DirtyStart);
+	const int32 OldReferencesEnd = LowerBoundByStart(References, OldDirtyEnd);
+
+	const int32 ScopeShift = Captured.Scopes.Num() - (OldScopesEnd - DirtyScope - 1);
+	const int32 DefinitionShift = Captured.Definitions.Num() - (OldDefinitionsEnd - OldDefinitionsStart);
+
+	const auto ShiftByte = [OldDirtyEnd, Delta](const uint32 InByte)
+	{
+		return InByte >= OldDirtyEnd ? static_cast<uint32>(InByte + Delta) : InByte;
+	};
+	const auto ShiftScope = [OldScopesEnd, ScopeShift](const int32 InScope)
+	{
+		return InScope >= OldScopesEnd ? InScope + ScopeShift : InScope;
+	};
+	const auto ShiftDefinition = [OldDefinitionsEnd, DefinitionShift](const int32 InDefinition)
+	{
+		return InDefinition >= OldDefinitionsEnd ? InDefinition + DefinitionShift : InDefinition;
+	};
+
+	TSharedRef<FTreeSitterLocals> Locals = MakeShared<FTreeSitterLocals>(Query);
+	Locals->UpdatedStartByte = DirtyStart;
+	Locals->UpdatedEndByte = NewDirtyEnd;
+
+	Locals->Scopes.Reserve(Scopes.Num() + ScopeShift);
+	for (int32 Index = 0; Index <= DirtyScope; ++Index)
+	{
+		// Enclosing scopes grow or shrink with the edit
+		const FTreeSitterLocalScope& Scope = Scopes[Index];
+		Locals->Scopes.Add({ Scope.StartByte, ShiftByte(Scope.EndByte), Scope.Parent });
+	}
+	Locals->Scopes.Append(Captured.Scopes);
+	for (int32 Index = OldScopesEnd; Index < Scopes.Num(); ++Index)
+	{
+		const FTreeSitterLocalScope& Scope = Scopes[Index];
+		Locals->Scopes.Add({ ShiftByte(Scope.StartByte), ShiftByte(Scope.EndByte), ShiftScope(Scope.Parent) });
+	}
+
+	Locals->Definitions.Reserve(Definitions.Num() + DefinitionShift);
+	Locals->Definitions.Append(Definitions.GetData(), OldDefinitionsStart);
+	Locals->Definitions.Append(Captured.Definitions);
+	for (int32 Index = OldDefinitionsEnd; Index < Definitions.Num(); ++Index)
+	{
+		const FTreeSitterLocalDefinition& Definition = Definitions[Index];
+		Locals->Definitions.Add({ Definition.NameHash, ShiftByte(Definition.StartByte), ShiftByte(Definition.EndByte), ShiftScope(Definition.Scope) });
+	}
+
+	// References outside the dirty scope can't see into it, only their indices move
+	Locals->References.Reserve(References.Num() + Captured.References.Num() - (OldReferencesEnd - OldReferencesStart));
+	Locals->References.Append(References.GetData(), OldReferencesStart);
+	Locals->References.Append(Captured.References);
+	for (int32 Index = OldReferencesEnd; Index < References.Num(); ++Index)
+	{
+		const FTreeSitterLocalReference& Reference = References[Index];
+		Locals->References.Add({ Reference.NameHash, ShiftByte(Reference.StartByte), ShiftByte(Reference.EndByte), ShiftScope(Reference.Scope), Reference.Definition == INDEX_NONE ? INDEX_NONE : ShiftDefinition(Reference.Definition) });
+	}
+	for (int32 Index = 0; Index < OldReferencesStart; ++Index)
+	{
+		FTreeSitterLocalReference& Reference = Locals->References[Index];
+		Reference.Definition = Reference.Definition == INDEX_NONE ? INDEX_NONE : ShiftDefinition(Reference.Definition);
+	}
+
+	Locals->ResolveReferences(OldReferencesStart, OldReferencesStart + Captured.References.Num());
+	return Locals;
+}
+
+int32 FTreeSitterLocals::FindDefinitionAt(const uint32 InByteOffset) const
+{
+	using namespace UE::TreeSitter::Locals;
+
+	// Identifiers don't overlap, the candidate is the last one starting at or before the offset
+	const int32 Reference = Algo::UpperBoundBy(References, InByteOffset, [](const FTreeSitterLocalReference& InReference) { return InReference.StartByte; }) - 1;
+	if (References.IsValidIndex(Reference) && InByteOffset <= References[Reference].EndByte)
+	{
+		return References[Reference].Definition;
+	}
+
+	const int32 Definition = Algo::UpperBoundBy(Definitions, InByteOffset, [](const FTreeSitterLocalDefinition& InDefinition) { return InDefinition.StartByte; }) - 1;
+	if (Definitions.IsValidIndex(Definition) && InByteOffset <= Definitions[Definition].EndByte)
+	{
+		return Definition;
+	}
+
+	return INDEX_NONE;
+}
+
+void FTreeSitterLocals::FindReferences(const int32 InDefinition, TArray<int32>& OutReferences) const
+{
+	using namespace UE::TreeSitter::Locals;
+
+	if (!Definitions.IsValidIndex(InDefinition))
+	{
+		return;
+	}
+
+	// Only references within the scope of the definition can resolve to it
+	const int32 Scope = Definitions[InDefinition].Scope;
+	const int32 StartReference = Scopes.IsValidIndex(Scope) ? LowerBoundByStart(References, Scopes[Scope].StartByte) : 0;
+	const uint32 EndByte = Scopes.IsValidIndex(Scope) ? Scopes[Scope].EndByte : MAX_uint32;
+
+	for (int32 Index = StartReference; Index < References.Num() && References[Index].StartByte < EndByte; ++Index)
+	{
+		if (References[Index].Definition == InDefinition)
+		{
+			OutReferences.Add(Index);
+		}
+	}
+}
+
+void FTreeSitterLocals::ResolveReferences(const int32 InFirstReference, const int32 InEndReference)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterLocals::ResolveReferences);
+
+	if (InFirstReference >= InEndReference)
+	{
+		return;
+	}
+
+	// Definitions of each (scope, name), in document order
+	TMap<TPair<int32, uint64>, TArray<int32, TInlineAllocator<1>>> ScopeDefinitions;
+	ScopeDefinitions.Reserve(Definitions.Num());
+	for (int32 Index = 0; Index < Definitions.Num(); ++Index)
+	{
+		ScopeDefinitions.FindOrAdd(TPair<int32, uint64>(Definitions[Index].Scope, Definitions[Index].NameHash)).Add(Index);
+	}
+
+	for (int32 Index = InFirstReference; Index < InEndReference; ++Index)
+	{
+		FTreeSitterLocalReference& Reference = References[Index];
+		Reference.Definition = INDEX_NONE;
+
+		int32 HoistedDefinition = INDEX_NONE;
+		for (int32 Scope = Reference.Scope; ; Scope = Scopes[Scope].Parent)
+		{
+			if (const TArray<int32, TInlineAllocator<1>>* Candidates = ScopeDefinitions.Find(TPair<int32, uint64>(Scope, Reference.NameHash)))
+			{
+				for (int32 CandidateIndex = Candidates->Num() - 1; CandidateIndex >= 0 && Reference.Definition == INDEX_NONE; --CandidateIndex)
+				{
+					if (Definitions[(*Candidates)[CandidateIndex]].StartByte <= Reference.StartByte)
+					{
+						Reference.Definition = (*Candidates)[CandidateIndex];
+					}
+				}
+
+				if (HoistedDefinition == INDEX_NONE)
+				{
+					HoistedDefinition = (*Candidates)[0];
+				}
+			}
+
+			if (Reference.Definition != INDEX_NONE || Scope == INDEX_NONE)
+			{
+				break;
+			}
+		}
+
+		if (Reference.Definition == INDEX_NONE)
+		{
+			Reference.Definition = HoistedDefinition;
+		}
+	}
+}
@@ -0,0 +1,14 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterMemory.h"
+
+LLM_DEFINE_TAG(TreeSitter);
+
+DEFINE_STAT(STAT_TreeSitter_AllocatedMemory);
+DEFINE_STAT(STAT_TreeSitter_LiveAllocations);
+
+#if !UE_BUILD_SHIPPING
+std::atomic<uint64> UE::TreeSitter::Private::AllocationCount = 0;
+std::atomic<uint64> UE::TreeSitter::Private::AllocatedBytes = 0;
+std::atomic<uint64> UE::TreeSitter::Private::PeakAllocatedBytes = 0;
+#endif
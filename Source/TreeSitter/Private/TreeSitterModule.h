@@ -3,16 +3,7 @@
 #pragma once
 
 #include "ITreeSitterModule.h"
-#include "Internationalization/Text.h"
-#include "Math/Vector2D.h"
-
-class SWindow;
-struct IConsoleCommand;
-struct TSLanguage;
-struct TSNode;
-struct TSParser;
-struct TSPoint;
-struct TSRange;
+#include "HAL/CriticalSection.h"
 
 class FTreeSitterModule : public ITreeSitterModule
 {
@@ -24,65 +15,53 @@ public:
 	
 	//~ Begin ITreeSitterModule
 	virtual FGetLanguageParser* GetLanguageParser(const ETreeSitterLanguage InLanguage) override;
-	virtual void RegisterCustomMarkdownWidget(const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate) override;
-	virtual void UnregisterCustomMarkdownWidget(const FName& InNodeName) override;
-	virtual TSharedRef<SWidget> CreateWidgetForNodeType(const FName& InNodeType, const TSharedRef<FTreeSitterNode>& InNode, const FString& InOriginalSource) override;
-	virtual bool HasCustomWidgetForNodeType(const FName& InNodeType) override;
+	virtual TSharedPtr<const FTreeSitterQuery> FindQuery(const ETreeSitterLanguage InLanguage, const FString& InQueryName) override;
+	virtual FString GetGrammarRevision(const ETreeSitterLanguage InLanguage) override;
 	//~ End ITreeSitterModule
 
+	/** Name of a language loaded by this module, for trace scopes and logs. Doesn't need the module, safe from any thread. */
+	static const TCHAR* FindLanguageName(const TSLanguage* InLanguage);
+
 private:
-	/** References of registered console commands via IConsoleManager */
-	TArray<IConsoleCommand*> ConsoleCommands;
-	
-	/** Reference to opened slate widget windows */
-	TArray<TSharedPtr<SWindow>> SlateWindows;
-	
-	FDelegateHandle OnLiveReloadPatchCompleteHandle;
+	/** Guards the lazy loading of grammar libraries, languages can be requested from worker threads */
+	FCriticalSection LanguageParsersCriticalSection;
 
-	TMap<FName, FTreeSitterOnGetCustomWidgetInstance> NodeNameToWidgetFactories;
+	/** Exports of the grammar libraries loaded so far, failed loads are cached as nullptr and only reported once */
+	TMap<ETreeSitterLanguage, FGetLanguageParser*> LanguageParsers;
 	
-	void OnLiveReloadComplete();
+	TArray<void*> ParserLibraryHandles;
 
-	void RegisterCustomWidgetInstances();
-	void UnregisterCustomWidgetInstances();
+	/** See GetGrammarRevision(), guarded by LanguageParsersCriticalSection */
+	TMap<ETreeSitterLanguage, FString> GrammarRevisions;
 
-	/** Called from StartupModule and sets up console commands for the plugin via IConsoleManager */
-	void RegisterConsoleCommands();
-	
-	/** Called from ShutdownModule and clears out previously registered console commands */
-	void UnregisterConsoleCommands();
-	
-	void ExecuteWidgetCommand(const TArray<FString>& InArgs);
-	void ExecuteTestCommand(const TArray<FString>& InArgs) const;
-	
-	void ExecuteGenerateMarkdownSlateWidgetCommand(const TArray<FString>& InArgs);
-	
-	TSharedPtr<SWindow> OpenWindow(const TSharedRef<SWidget>& InWidgetContent, const FText& InTitle = FText::GetEmpty(), const FVector2f& InWindowSize = FVector2f(1280.f, 1080.f));
-	void HandleWindowClosed(const TSharedRef<SWindow>& InWindow);
-	
-	TArray<void*> ParserLibraryHandles;
+	/** Bundled queries compiled so far, missing or invalid ones are cached as nullptr */
+	FCriticalSection QueriesCriticalSection;
+	TMap<TPair<ETreeSitterLanguage, FString>, TSharedPtr<const FTreeSitterQuery>> Queries;
+
+	/** Names of the languages loaded so far, see FindLanguageName() */
+	static FCriticalSection LanguageNamesCriticalSection;
+	static TMap<const TSLanguage*, const TCHAR*> LanguageNames;
 
-	using FGetLanguageParser = const TSLanguage*(void);
-	FGetLanguageParser* tree_sitter_javascript = nullptr;
-	FGetLanguageParser* tree_sitter_json = nullptr;
-	FGetLanguageParser* tree_sitter_markdown = nullptr;
-	FGetLanguageParser* tree_sitter_markdown_inline = nullptr;
+	/** Loads the grammar library for a language, and resolves its `tree_sitter_<language>()` export */
+	FGetLanguageParser* LoadLanguageParser(const ETreeSitterLanguage InLanguage);
 	
+	/** Name of the grammar a language is parsed with, as in its library name and language-manifest.txt */
+	static const TCHAR* GetGrammarName(const ETreeSitterLanguage InLanguage);
+
+	/** Directory of the grammar libraries for this platform, empty if unsupported */
+	static FString GetLanguageLibraryDir();
+
+	/** File name of a grammar library on this platform, `libtree-sitter-<language>.dll` or `.so` */
+	static FString GetLanguageLibraryName(const FString& InLanguageName);
+
+	/** Base directory of the plugin, also when running from a program that doesn't discover plugins */
+	static FString GetPluginBaseDir();
+
 	static void* LoadLanguageLibraryHandle(const FString& InLibraryPath);
 
 	void* LoadLanguageLibrary(const FString& InDLLName);
 	
 	void* LoadLanguageLibraryWithDLLExport(const FString& InDLLName, const FString& InExportName, FGetLanguageParser*& OutExportHandle);
-	void* LoadLanguageLibraryWithDLLExport(const FString& InLanguageName, FGetLanguageParser*& OutExportHandle);
-	
-	void CheckTreeSitter() const;
-	void CheckTreeSitterMarkdown() const;
-
-	static FString GetNodeTextForRanges(const FString& InSource, const TSPoint& InStartPoint, const TSPoint& InEndPoint);
-
-	static bool GetInlineTSRanges(const TSNode& InNode, TArray<TSRange>& OutRanges);
-	
-	static void DebugASTNodeInfo(const FString& InSource, const TSNode& InNode, const FString& InPadding = TEXT(""));
 
 	template<typename FFuncType>
 	static void GetDllExport(const TCHAR* DllName, void* DllHandle, const TCHAR* ExportName, FFuncType& ExportHandle)
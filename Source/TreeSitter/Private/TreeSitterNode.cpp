@@ -25,3 +25,51 @@ FTreeSitterNode::FTreeSitterNode(const TSNode& InNode, const uint32 InDepth)
 	Depth = InDepth;
 }
 
+void UE::TreeSitter::ForEachSyntaxError(const TSNode& InRootNode, const TFunctionRef<void(const TSNode&)>& InCallback)
+{
+	if (ts_node_is_null(InRootNode) || !ts_node_has_error(InRootNode))
+	{
+		return;
+	}
+
+	TSTreeCursor Cursor = ts_tree_cursor_new(InRootNode);
+
+	bool bDone = false;
+	while (!bDone)
+	{
+		const TSNode Node = ts_tree_cursor_current_node(&Cursor);
+		bool bDescend = ts_node_has_error(Node);
+
+		if (ts_node_is_error(Node) || ts_node_is_missing(Node))
+		{
+			bDescend = false;
+			InCallback(Node);
+		}
+
+		if (bDescend && ts_tree_cursor_goto_first_child(&Cursor))
+		{
+			continue;
+		}
+
+		while (!ts_tree_cursor_goto_next_sibling(&Cursor))
+		{
+			if (!ts_tree_cursor_goto_parent(&Cursor))
+			{
+				bDone = true;
+				break;
+			}
+		}
+	}
+
+	ts_tree_cursor_delete(&Cursor);
+}
+
+int32 UE::TreeSitter::CountSyntaxErrors(const TSNode& InRootNode)
+{
+	int32 ErrorCount = 0;
+	ForEachSyntaxError(InRootNode, [&ErrorCount](const TSNode&)
+	{
+		++ErrorCount;
+	});
+	return ErrorCount;
+}
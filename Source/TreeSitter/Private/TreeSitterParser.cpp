@@ -3,8 +3,16 @@
 #include "TreeSitterParser.h"
 
 #include "ITreeSitterModule.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterModule.h"
+#include "TreeSitterStats.h"
 #include "tree_sitter/api.h"
 
+TRACE_DECLARE_INT_COUNTER(TreeSitter_ParseBytes, TEXT("TreeSitter/Parse/Bytes"));
+TRACE_DECLARE_INT_COUNTER(TreeSitter_ParseNodes, TEXT("TreeSitter/Parse/Nodes"));
+TRACE_DECLARE_INT_COUNTER(TreeSitter_FullParses, TEXT("TreeSitter/Parse/Full"));
+TRACE_DECLARE_INT_COUNTER(TreeSitter_IncrementalParses, TEXT("TreeSitter/Parse/Incremental"));
+
 FTreeSitterParser::FTreeSitterParser()
 	: Parser(ts_parser_new())
 {
@@ -17,12 +25,35 @@ FTreeSitterParser::~FTreeSitterParser()
 
 bool FTreeSitterParser::SetLanguage(const TSLanguage* Language) const
 {
-	return ts_parser_set_language(Parser, Language);
+	return SetLanguage(Language, FTreeSitterModule::FindLanguageName(Language));
 }
 
 bool FTreeSitterParser::SetLanguage(const ETreeSitterLanguage InLanguage) const
 {
-	return ts_parser_set_language(Parser, ITreeSitterModule::Get().GetLanguageParser(InLanguage)());
+	ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(InLanguage);
+	return LanguageParser && SetLanguage(LanguageParser(), UE::TreeSitter::GetLanguageName(InLanguage));
+}
+
+bool FTreeSitterParser::SetLanguage(const TSLanguage* InLanguage, const TCHAR* InLanguageName) const
+{
+	LanguageName = InLanguageName;
+	return ts_parser_set_language(Parser, InLanguage);
+}
+
+const TSLanguage* FTreeSitterParser::GetLanguage() const
+{
+	return ts_parser_language(Parser);
+}
+
+bool FTreeSitterParser::SetIncludedRanges(const TArray<TSRange>& InRanges) const
+{
+	return ts_parser_set_included_ranges(Parser, InRanges.GetData(), InRanges.Num());
+}
+
+void FTreeSitterParser::Reset() const
+{
+	ts_parser_set_included_ranges(Parser, nullptr, 0);
+	ts_parser_reset(Parser);
 }
 
 TSTree* FTreeSitterParser::Parse(const FString& SourceCode) const
@@ -34,5 +65,37 @@ TSTree* FTreeSitterParser::Parse(const FString& SourceCode) const
 	// This char* valid as long as FTCHARToUTF8 object exists
 	const char* Code = UTF8String.Get();
 	
-	return ts_parser_parse_string(Parser, nullptr, Code, strlen(Code));
+	return Parse(Code, UTF8String.Length());
+}
+
+TSTree* FTreeSitterParser::Parse(const ANSICHAR* InUTF8Source, const uint32 InLength, const TSTree* InOldTree) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterParser::Parse);
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(LanguageName);
+	CSV_SCOPED_TIMING_STAT(TreeSitter, Parse);
+
+	TSTree* Tree = ts_parser_parse_string(Parser, InOldTree, InUTF8Source, InLength);
+
+	TRACE_COUNTER_SET(TreeSitter_ParseBytes, InLength);
+	CSV_CUSTOM_STAT(TreeSitter, ParseBytes, static_cast<int32>(InLength), ECsvCustomStatOp::Accumulate);
+	if (InOldTree)
+	{
+		TRACE_COUNTER_INCREMENT(TreeSitter_IncrementalParses);
+		CSV_CUSTOM_STAT(TreeSitter, IncrementalParses, 1, ECsvCustomStatOp::Accumulate);
+	}
+	else
+	{
+		TRACE_COUNTER_INCREMENT(TreeSitter_FullParses);
+		CSV_CUSTOM_STAT(TreeSitter, FullParses, 1, ECsvCustomStatOp::Accumulate);
+	}
+
+	if (Tree)
+	{
+		// Stored in the root subtree, no traversal involved
+		const int32 NodeCount = static_cast<int32>(ts_node_descendant_count(ts_tree_root_node(Tree)));
+		TRACE_COUNTER_SET(TreeSitter_ParseNodes, NodeCount);
+		CSV_CUSTOM_STAT(TreeSitter, ParseNodes, NodeCount, ECsvCustomStatOp::Accumulate);
+	}
+
+	return Tree;
 }
@@ -0,0 +1,42 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterParserPool.h"
+
+#include "Misc/ScopeLock.h"
+#include "TreeSitterParser.h"
+
+FTreeSitterParserPool& FTreeSitterParserPool::Get()
+{
+	static FTreeSitterParserPool Pool;
+	return Pool;
+}
+
+TSharedRef<FTreeSitterParser> FTreeSitterParserPool::Acquire(const TSLanguage* InLanguage)
+{
+	{
+		FScopeLock Lock(&CriticalSection);
+		if (TArray<TSharedRef<FTreeSitterParser>>* Parsers = FreeParsers.Find(InLanguage); Parsers && !Parsers->IsEmpty())
+		{
+			return Parsers->Pop();
+		}
+	}
+
+	// Creating the parser outside the lock, other threads can keep borrowing in the meantime
+	TSharedRef<FTreeSitterParser> Parser = MakeShared<FTreeSitterParser>();
+	Parser->SetLanguage(InLanguage);
+	return Parser;
+}
+
+void FTreeSitterParserPool::Release(const TSharedRef<FTreeSitterParser>& InParser)
+{
+	InParser->Reset();
+
+	FScopeLock Lock(&CriticalSection);
+	FreeParsers.FindOrAdd(InParser->GetLanguage()).Add(InParser);
+}
+
+void FTreeSitterParserPool::Empty()
+{
+	FScopeLock Lock(&CriticalSection);
+	FreeParsers.Empty();
+}
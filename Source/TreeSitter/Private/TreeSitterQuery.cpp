@@ -0,0 +1,220 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterQuery.h"
+
+#include "Hash/xxhash.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+static const TCHAR* QueryErrorToString(const TSQueryError InError)
+{
+	switch (InError)
+	{
+	case TSQueryErrorNone:
+		return TEXT("None");
+	case TSQueryErrorSyntax:
+		return TEXT("Syntax");
+	case TSQueryErrorNodeType:
+		return TEXT("NodeType");
+	case TSQueryErrorField:
+		return TEXT("Field");
+	case TSQueryErrorCapture:
+		return TEXT("Capture");
+	case TSQueryErrorStructure:
+		return TEXT("Structure");
+	case TSQueryErrorLanguage:
+		return TEXT("Language");
+	}
+
+	return TEXT("Unknown");
+}
+
+FTreeSitterQuery::FTreeSitterQuery(const TSLanguage* InLanguage, const FString& InQuerySource)
+	: Language(InLanguage)
+{
+	if (!InLanguage)
+	{
+		Error = TEXT("Invalid language");
+		return;
+	}
+
+	const FTCHARToUTF8 UTF8Source(*InQuerySource);
+	SourceHash = FXxHash64::HashBuffer(UTF8Source.Get(), UTF8Source.Length()).Hash;
+
+	uint32 ErrorOffset = 0;
+	TSQueryError ErrorType = TSQueryErrorNone;
+	Query = ts_query_new(InLanguage, UTF8Source.Get(), UTF8Source.Length(), &ErrorOffset, &ErrorType);
+	if (!Query)
+	{
+		Error = FString::Printf(TEXT("%s error at offset %u"), QueryErrorToString(ErrorType), ErrorOffset);
+		UE_LOG(LogTemp, Error, TEXT("Failed to compile tree-sitter query: %s"), *Error);
+		return;
+	}
+
+	const uint32 CaptureCount = ts_query_capture_count(Query);
+	CaptureNames.Reserve(CaptureCount);
+	for (uint32 i = 0; i < CaptureCount; ++i)
+	{
+		uint32 Length = 0;
+		const char* Name = ts_query_capture_name_for_id(Query, i, &Length);
+		CaptureNames.Add(FName(Length, Name));
+	}
+
+	CompilePredicates();
+}
+
+FTreeSitterQuery::~FTreeSitterQuery()
+{
+	if (Query)
+	{
+		ts_query_delete(Query);
+	}
+}
+
+bool FTreeSitterQuery::IsValid() const
+{
+	return Query != nullptr;
+}
+
+TSQuery* FTreeSitterQuery::Get() const
+{
+	return Query;
+}
+
+const TSLanguage* FTreeSitterQuery::GetLanguage() const
+{
+	return Language;
+}
+
+const FString& FTreeSitterQuery::GetError() const
+{
+	return Error;
+}
+
+uint64 FTreeSitterQuery::GetSourceHash() const
+{
+	return SourceHash;
+}
+
+int32 FTreeSitterQuery::FindCaptureIndex(const FName& InCaptureName) const
+{
+	return CaptureNames.IndexOfByKey(InCaptureName);
+}
+
+FName FTreeSitterQuery::GetCaptureName(const uint32 InCaptureIndex) const
+{
+	return CaptureNames.IsValidIndex(InCaptureIndex) ? CaptureNames[InCaptureIndex] : NAME_None;
+}
+
+void FTreeSitterQuery::CompilePredicates()
+{
+	const TSQuery* RawQuery = Query;
+	const uint32 PatternCount = ts_query_pattern_count(RawQuery);
+	PatternPredicates.SetNum(PatternCount);
+
+	const auto GetString = [RawQuery](const TSQueryPredicateStep& InStep)
+	{
+		uint32 Length = 0;
+		const char* Value = ts_query_string_value_for_id(RawQuery, InStep.value_id, &Length);
+		return FString(FUTF8ToTCHAR(Value, Length));
+	};
+
+	for (uint32 PatternIndex = 0; PatternIndex < PatternCount; ++PatternIndex)
+	{
+		uint32 StepCount = 0;
+		const TSQueryPredicateStep* Steps = ts_query_predicates_for_pattern(RawQuery, PatternIndex, &StepCount);
+
+		uint32 First = 0;
+		for (uint32 Index = 0; Index < StepCount; ++Index)
+		{
+			if (Steps[Index].type != TSQueryPredicateStepTypeDone)
+			{
+				continue;
+			}
+
+			// Operator, capture and argument, anything else (e.g. #set! directives) is left alone
+			const TConstArrayView<TSQueryPredicateStep> Predicate(Steps + First, Index - First);
+			First = Index + 1;
+			if (Predicate.Num() != 3 || Predicate[0].type != TSQueryPredicateStepTypeString || Predicate[1].type != TSQueryPredicateStepTypeCapture)
+			{
+				continue;
+			}
+
+			const FString Operator = GetString(Predicate[0]);
+			const bool bIsEq = Operator == TEXT("eq?") || Operator == TEXT("not-eq?");
+			const bool bIsMatch = Operator == TEXT("match?") || Operator == TEXT("not-match?");
+			if ((!bIsEq && !bIsMatch) || (bIsMatch && Predicate[2].type != TSQueryPredicateStepTypeString))
+			{
+				continue;
+			}
+
+			FPredicate& Compiled = PatternPredicates[PatternIndex].AddDefaulted_GetRef();
+			Compiled.Capture = Predicate[1].value_id;
+			Compiled.bNegated = Operator.StartsWith(TEXT("not-"));
+			if (Predicate[2].type == TSQueryPredicateStepTypeCapture)
+			{
+				Compiled.OtherCapture = Predicate[2].value_id;
+			}
+			else
+			{
+				Compiled.Value = GetString(Predicate[2]);
+			}
+
+			if (bIsMatch)
+			{
+				Compiled.Pattern.Emplace(Compiled.Value);
+			}
+		}
+	}
+}
+
+bool FTreeSitterQuery::MatchesPredicates(const TSQueryMatch& InMatch, const FTreeSitterSource& InSource) const
+{
+	if (!PatternPredicates.IsValidIndex(InMatch.pattern_index))
+	{
+		return true;
+	}
+
+	for (const FPredicate& Predicate : PatternPredicates[InMatch.pattern_index])
+	{
+		const FStringView Text = GetCaptureView(InMatch, Predicate.Capture, InSource);
+
+		bool bMatches;
+		if (Predicate.Pattern.IsSet())
+		{
+			FRegexMatcher Matcher(Predicate.Pattern.GetValue(), FString(Text));
+			bMatches = Matcher.FindNext();
+		}
+		else if (Predicate.OtherCapture != INDEX_NONE)
+		{
+			bMatches = Text.Equals(GetCaptureView(InMatch, Predicate.OtherCapture, InSource), ESearchCase::CaseSensitive);
+		}
+		else
+		{
+			bMatches = Text.Equals(Predicate.Value, ESearchCase::CaseSensitive);
+		}
+
+		if (bMatches == Predicate.bNegated)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+FStringView FTreeSitterQuery::GetCaptureView(const TSQueryMatch& InMatch, const int32 InCapture, const FTreeSitterSource& InSource)
+{
+	uint32 StartByte = MAX_uint32;
+	uint32 EndByte = 0;
+	for (uint16 Index = 0; Index < InMatch.capture_count; ++Index)
+	{
+		if (InMatch.captures[Index].index == static_cast<uint32>(InCapture))
+		{
+			StartByte = FMath::Min(StartByte, ts_node_start_byte(InMatch.captures[Index].node));
+			EndByte = FMath::Max(EndByte, ts_node_end_byte(InMatch.captures[Index].node));
+		}
+	}
+
+	return StartByte < EndByte ? InSource.GetView(StartByte, EndByte) : FStringView();
+}
@@ -0,0 +1,277 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterReplace.h"
+
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::Replace
+{
+	static bool IsCaptureNameChar(const TCHAR InChar)
+	{
+		return FChar::IsAlnum(InChar) || InChar == TEXT('_');
+	}
+
+	/** Point reached after inserting InText at InStart */
+	static TSPoint Advance(const TSPoint& InStart, const FTCHARToUTF8& InText)
+	{
+		TSPoint Point = InStart;
+		for (int32 Index = 0; Index < InText.Length(); ++Index)
+		{
+			if (InText.Get()[Index] == '\n')
+			{
+				++Point.row;
+				Point.column = 0;
+			}
+			else
+			{
+				++Point.column;
+			}
+		}
+		return Point;
+	}
+}
+
+FTreeSitterReplacer::FTreeSitterReplacer(const TSharedRef<const FTreeSitterQuery>& InQuery, const FString& InTemplate)
+	: Query(InQuery)
+{
+	if (!Query->IsValid())
+	{
+		Error = Query->GetError();
+		return;
+	}
+
+	MatchCapture = Query->FindCaptureIndex(TEXT("match"));
+	CompileTemplate(InTemplate);
+}
+
+bool FTreeSitterReplacer::IsValid() const
+{
+	return Error.IsEmpty();
+}
+
+const FString& FTreeSitterReplacer::GetError() const
+{
+	return Error;
+}
+
+void FTreeSitterReplacer::FindEdits(const TSNode& InNode, const FTreeSitterSource& InSource, TArray<FTreeSitterTextEdit>& OutEdits) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterReplacer::FindEdits);
+
+	if (!IsValid())
+	{
+		return;
+	}
+
+	const int32 FirstEdit = OutEdits.Num();
+
+	TSQueryCursor* Cursor = ts_query_cursor_new();
+	ts_query_cursor_exec(Cursor, Query->Get(), InNode);
+
+	TSQueryMatch Match;
+	while (ts_query_cursor_next_match(Cursor, &Match))
+	{
+		if (!Query->MatchesPredicates(Match, InSource))
+		{
+			continue;
+		}
+
+		uint32 StartByte = MAX_uint32;
+		uint32 EndByte = 0;
+		for (uint16 Index = 0; Index < Match.capture_count; ++Index)
+		{
+			if (MatchCapture == INDEX_NONE || Match.captures[Index].index == static_cast<uint32>(MatchCapture))
+			{
+				StartByte = FMath::Min(StartByte, ts_node_start_byte(Match.captures[Index].node));
+				EndByte = FMath::Max(EndByte, ts_node_end_byte(Match.captures[Index].node));
+			}
+		}
+		if (StartByte > EndByte)
+		{
+			continue;
+		}
+
+		FTreeSitterTextEdit& Edit = OutEdits.AddDefaulted_GetRef();
+		Edit.StartByte = StartByte;
+		Edit.EndByte = EndByte;
+		for (const FTemplateSegment& Segment : Segments)
+		{
+			if (Segment.Capture == INDEX_NONE)
+			{
+				Edit.Replacement += Segment.Text;
+			}
+			else
+			{
+				const FStringView CaptureText = FTreeSitterQuery::GetCaptureView(Match, Segment.Capture, InSource);
+				Edit.Replacement.Append(CaptureText.GetData(), CaptureText.Len());
+			}
+		}
+	}
+
+	ts_query_cursor_delete(Cursor);
+
+	// Outermost first, then drop whatever overlaps an edit already kept
+	TArrayView<FTreeSitterTextEdit> NewEdits = MakeArrayView(OutEdits).RightChop(FirstEdit);
+	NewEdits.StableSort([](const FTreeSitterTextEdit& A, const FTreeSitterTextEdit& B)
+	{
+		return A.StartByte != B.StartByte ? A.StartByte < B.StartByte : A.EndByte > B.EndByte;
+	});
+
+	int32 KeptCount = FirstEdit;
+	uint32 KeptEndByte = 0;
+	for (int32 Index = FirstEdit; Index < OutEdits.Num(); ++Index)
+	{
+		if (KeptCount > FirstEdit && OutEdits[Index].StartByte < KeptEndByte)
+		{
+			continue;
+		}
+
+		KeptEndByte = OutEdits[Index].EndByte;
+		if (Index != KeptCount)
+		{
+			OutEdits[KeptCount] = MoveTemp(OutEdits[Index]);
+		}
+		++KeptCount;
+	}
+	OutEdits.SetNum(KeptCount);
+}
+
+void FTreeSitterReplacer::CompileTemplate(const FString& InTemplate)
+{
+	FString Literal;
+	for (int32 Index = 0; Index < InTemplate.Len(); ++Index)
+	{
+		const TCHAR Char = InTemplate[Index];
+		const TCHAR Next = Index + 1 < InTemplate.Len() ? InTemplate[Index + 1] : TEXT('\0');
+		// Escaped first, "$$name" being a dollar sign followed by the literal name
+		if (Char == TEXT('$') && Next == TEXT('$'))
+		{
+			Literal.AppendChar(TEXT('$'));
+			++Index;
+			continue;
+		}
+
+		if (Char != TEXT('$') || (Next != TEXT('{') && !UE::TreeSitter::Replace::IsCaptureNameChar(Next)))
+		{
+			Literal.AppendChar(Char);
+			continue;
+		}
+
+		FString Name;
+		if (Next == TEXT('{'))
+		{
+			const int32 End = InTemplate.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index + 2);
+			if (End == INDEX_NONE)
+			{
+				Error = FString::Printf(TEXT("Unterminated ${ at %d in the template"), Index);
+				return;
+			}
+			Name = InTemplate.Mid(Index + 2, End - Index - 2);
+			Index = End;
+		}
+		else
+		{
+			int32 End = Index + 1;
+			while (End < InTemplate.Len() && UE::TreeSitter::Replace::IsCaptureNameChar(InTemplate[End]))
+			{
+				++End;
+			}
+			Name = InTemplate.Mid(Index + 1, End - Index - 1);
+			Index = End - 1;
+		}
+
+		const int32 Capture = Query->FindCaptureIndex(FName(Name));
+		if (Capture == INDEX_NONE)
+		{
+			Error = FString::Printf(TEXT("Unknown capture @%s in the template"), *Name);
+			return;
+		}
+
+		if (!Literal.IsEmpty())
+		{
+			Segments.Add({ MoveTemp(Literal), INDEX_NONE });
+			Literal.Reset();
+		}
+		Segments.Add({ FString(), Capture });
+	}
+
+	if (!Literal.IsEmpty())
+	{
+		Segments.Add({ MoveTemp(Literal), INDEX_NONE });
+	}
+}
+
+namespace UE::TreeSitter
+{
+	TSharedRef<const FTreeSitterSource> ApplyEdits(const FTreeSitterSource& InSource, TConstArrayView<FTreeSitterTextEdit> InEdits, TSTree* InOutTree)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TreeSitter::ApplyEdits);
+
+		const uint32 SourceLength = InSource.GetUTF8Length();
+
+		FString Text;
+		Text.Reserve(InSource.GetText().Len());
+
+		// Points of every edit are gathered in a single forward scan, tree edits then being applied from the last one so
+		// that the offsets of those before stay valid
+		TArray<TSInputEdit> TreeEdits;
+		TreeEdits.Reserve(InOutTree ? InEdits.Num() : 0);
+
+		const ANSICHAR* UTF8 = InSource.GetUTF8();
+		TSPoint Point = { 0, 0 };
+		uint32 PointByte = 0;
+		const auto AdvanceTo = [UTF8, &Point, &PointByte](const uint32 InByte)
+		{
+			for (; PointByte < InByte; ++PointByte)
+			{
+				if (UTF8[PointByte] == '\n')
+				{
+					++Point.row;
+					Point.column = 0;
+				}
+				else
+				{
+					++Point.column;
+				}
+			}
+			return Point;
+		};
+
+		uint32 CopiedByte = 0;
+		for (const FTreeSitterTextEdit& Edit : InEdits)
+		{
+			const uint32 StartByte = FMath::Clamp(Edit.StartByte, CopiedByte, SourceLength);
+			const uint32 EndByte = FMath::Clamp(Edit.EndByte, StartByte, SourceLength);
+
+			const FStringView Unchanged = InSource.GetView(CopiedByte, StartByte);
+			Text.Append(Unchanged.GetData(), Unchanged.Len());
+			Text += Edit.Replacement;
+			CopiedByte = EndByte;
+
+			if (InOutTree)
+			{
+				const FTCHARToUTF8 Replacement(*Edit.Replacement, Edit.Replacement.Len());
+
+				TSInputEdit& TreeEdit = TreeEdits.AddDefaulted_GetRef();
+				TreeEdit.start_byte = StartByte;
+				TreeEdit.old_end_byte = EndByte;
+				TreeEdit.new_end_byte = StartByte + Replacement.Length();
+				TreeEdit.start_point = AdvanceTo(StartByte);
+				TreeEdit.old_end_point = AdvanceTo(EndByte);
+				TreeEdit.new_end_point = Replace::Advance(TreeEdit.start_point, Replacement);
+			}
+		}
+		const FStringView Remaining = InSource.GetView(CopiedByte, SourceLength);
+		Text.Append(Remaining.GetData(), Remaining.Len());
+
+		for (int32 Index = TreeEdits.Num() - 1; Index >= 0; --Index)
+		{
+			ts_tree_edit(InOutTree, &TreeEdits[Index]);
+		}
+
+		return FTreeSitterSource::Create(MoveTemp(Text));
+	}
+}
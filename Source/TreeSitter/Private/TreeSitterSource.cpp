@@ -0,0 +1,151 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterSource.h"
+
+#include "tree_sitter/api.h"
+
+TSharedRef<const FTreeSitterSource> FTreeSitterSource::Create(FString InText)
+{
+	return MakeShared<FTreeSitterSource>(MoveTemp(InText));
+}
+
+FTreeSitterSource::FTreeSitterSource(FString InText)
+	: Text(MoveTemp(InText))
+{
+	const FTCHARToUTF8 Converted(*Text, Text.Len());
+	UTF8.Append(Converted.Get(), Converted.Length());
+
+	// Every character is at least one byte, same length means every character is a single byte
+	if (UTF8.Num() == Text.Len())
+	{
+		return;
+	}
+
+	ByteToCharIndex.SetNumUninitialized(UTF8.Num() + 1);
+
+	int32 CharIndex = 0;
+	int32 CodePointCharIndex = 0;
+	for (int32 ByteIndex = 0; ByteIndex < UTF8.Num(); ++ByteIndex)
+	{
+		const uint8 Byte = static_cast<uint8>(UTF8[ByteIndex]);
+
+		// Lead byte of a new code point, 4 bytes sequences are surrogate pairs (two characters) for UTF-16 TCHAR
+		if ((Byte & 0xC0) != 0x80)
+		{
+			CodePointCharIndex = CharIndex;
+			CharIndex += (Byte >= 0xF0 && sizeof(TCHAR) == 2) ? 2 : 1;
+		}
+
+		ByteToCharIndex[ByteIndex] = CodePointCharIndex;
+	}
+
+	ByteToCharIndex[UTF8.Num()] = CharIndex;
+}
+
+const FString& FTreeSitterSource::GetText() const
+{
+	return Text;
+}
+
+const ANSICHAR* FTreeSitterSource::GetUTF8() const
+{
+	return UTF8.GetData();
+}
+
+uint32 FTreeSitterSource::GetUTF8Length() const
+{
+	return UTF8.Num();
+}
+
+FStringView FTreeSitterSource::GetView(const uint32 InStartByte, const uint32 InEndByte) const
+{
+	const int32 StartIndex = GetCharIndex(InStartByte);
+	const int32 EndIndex = GetCharIndex(InEndByte);
+	if (EndIndex <= StartIndex)
+	{
+		return FStringView();
+	}
+
+	return FStringView(*Text + StartIndex, EndIndex - StartIndex);
+}
+
+FStringView FTreeSitterSource::GetView(const TSNode& InNode) const
+{
+	return GetView(ts_node_start_byte(InNode), ts_node_end_byte(InNode));
+}
+
+int32 FTreeSitterSource::GetCharIndex(const uint32 InByteOffset) const
+{
+	const int32 ByteOffset = static_cast<int32>(FMath::Min(InByteOffset, GetUTF8Length()));
+	return ByteToCharIndex.IsEmpty() ? ByteOffset : ByteToCharIndex[ByteOffset];
+}
+
+TSPoint FTreeSitterSource::GetPoint(const uint32 InByteOffset) const
+{
+	const uint32 ByteOffset = FMath::Min(InByteOffset, GetUTF8Length());
+
+	uint32 Row = 0;
+	uint32 LineStart = 0;
+	for (uint32 Index = 0; Index < ByteOffset; ++Index)
+	{
+		if (UTF8[Index] == '\n')
+		{
+			++Row;
+			LineStart = Index + 1;
+		}
+	}
+
+	return TSPoint({ .row = Row, .column = ByteOffset - LineStart });
+}
+
+bool FTreeSitterSource::ComputeEdit(const FTreeSitterSource& InPreviousSource, TSInputEdit& OutEdit) const
+{
+	const uint32 OldLength = InPreviousSource.GetUTF8Length();
+	const uint32 NewLength = GetUTF8Length();
+	const ANSICHAR* OldData = InPreviousSource.GetUTF8();
+	const ANSICHAR* NewData = GetUTF8();
+
+	uint32 Prefix = 0;
+	const uint32 MaxPrefix = FMath::Min(OldLength, NewLength);
+	while (Prefix < MaxPrefix && OldData[Prefix] == NewData[Prefix])
+	{
+		++Prefix;
+	}
+
+	if (Prefix == OldLength && Prefix == NewLength)
+	{
+		return false;
+	}
+
+	// Suffix can't overlap the prefix on either side
+	uint32 Suffix = 0;
+	const uint32 MaxSuffix = MaxPrefix - Prefix;
+	while (Suffix < MaxSuffix && OldData[OldLength - Suffix - 1] == NewData[NewLength - Suffix - 1])
+	{
+		++Suffix;
+	}
+
+	// Keep the edit on code point boundaries, tree-sitter lexes UTF-8 sequences as a whole
+	auto IsContinuationByte = [](const ANSICHAR InByte)
+	{
+		return (static_cast<uint8>(InByte) & 0xC0) == 0x80;
+	};
+
+	while (Prefix > 0 && Prefix < NewLength && IsContinuationByte(NewData[Prefix]))
+	{
+		--Prefix;
+	}
+
+	while (Suffix > 0 && IsContinuationByte(NewData[NewLength - Suffix]))
+	{
+		--Suffix;
+	}
+
+	OutEdit.start_byte = Prefix;
+	OutEdit.old_end_byte = OldLength - Suffix;
+	OutEdit.new_end_byte = NewLength - Suffix;
+	OutEdit.start_point = GetPoint(OutEdit.start_byte);
+	OutEdit.old_end_point = InPreviousSource.GetPoint(OutEdit.old_end_byte);
+	OutEdit.new_end_point = GetPoint(OutEdit.new_end_byte);
+	return true;
+}
@@ -0,0 +1,17 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(TREESITTER_API, TreeSitter, true);
+
+double UE::TreeSitter::GetPercentile(TArray<double> InSamples, const double InPercentile)
+{
+	if (InSamples.IsEmpty())
+	{
+		return 0.0;
+	}
+
+	InSamples.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt32(InPercentile * InSamples.Num()) - 1, 0, InSamples.Num() - 1);
+	return InSamples[Index];
+}
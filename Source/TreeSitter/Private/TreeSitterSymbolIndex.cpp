@@ -0,0 +1,281 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterSymbolIndex.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
+#include "Hash/xxhash.h"
+#include "ITreeSitterModule.h"
+#include "Misc/ScopeRWLock.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+void FTreeSitterSymbolIndex::UpdateFile(const FString& InPath, const FTreeSitterQuery& InTagsQuery, const TSNode& InRootNode, const FTreeSitterSource& InSource)
+{
+	TArray<FTreeSitterTag> Tags;
+	UE::TreeSitter::ExtractTags(InTagsQuery, InRootNode, InSource, Tags);
+	SetFileSymbols(InPath, 0, Tags);
+}
+
+bool FTreeSitterSymbolIndex::UpdateFile(const FString& InPath, const ETreeSitterLanguage InLanguage, const FTreeSitterSource& InSource)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterSymbolIndex::UpdateFile);
+
+	const TSharedPtr<const FTreeSitterQuery> TagsQuery = ITreeSitterModule::Get().FindQuery(InLanguage, TEXT("tags"));
+	if (!TagsQuery.IsValid())
+	{
+		return false;
+	}
+
+	const uint64 ContentHash = FXxHash64::HashBuffer(InSource.GetUTF8(), InSource.GetUTF8Length()).Hash;
+	{
+		FReadScopeLock ReadLock(Lock);
+		const int32* FileId = FileIds.Find(InPath);
+		if (FileId && Files[*FileId].ContentHash == ContentHash)
+		{
+			return true;
+		}
+	}
+
+	const FTreeSitterPooledParser Parser(TagsQuery->GetLanguage());
+	TSTree* Tree = Parser->Parse(InSource.GetUTF8(), InSource.GetUTF8Length());
+	if (!Tree)
+	{
+		return false;
+	}
+
+	// Extracted out of the lock, only swapping records in blocks searches
+	TArray<FTreeSitterTag> Tags;
+	UE::TreeSitter::ExtractTags(*TagsQuery, ts_tree_root_node(Tree), InSource, Tags);
+	ts_tree_delete(Tree);
+
+	SetFileSymbols(InPath, ContentHash, Tags);
+	return true;
+}
+
+void FTreeSitterSymbolIndex::RemoveFile(const FString& InPath)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	int32 FileId = INDEX_NONE;
+	if (FileIds.RemoveAndCopyValue(InPath, FileId))
+	{
+		RemoveFileSymbols(FileId);
+		Files[FileId] = FFileSymbols();
+		FreeFileIds.Add(FileId);
+	}
+}
+
+void FTreeSitterSymbolIndex::Empty()
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	Files.Empty();
+	FileIds.Empty();
+	FreeFileIds.Empty();
+	Names.Empty();
+	NameIds.Empty();
+	NameFiles.Empty();
+	SortedNameIds.Empty();
+	PendingNameIds.Empty();
+	bHasPendingNames = false;
+	SymbolCount = 0;
+}
+
+void FTreeSitterSymbolIndex::FindSymbols(const FStringView InPrefix, TArray<FTreeSitterSymbolLocation>& OutSymbols, const int32 InMaxResults, const bool bInDefinitionsOnly) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterSymbolIndex::FindSymbols);
+
+	if (bHasPendingNames)
+	{
+		FWriteScopeLock WriteLock(Lock);
+		SortPendingNames();
+	}
+
+	FReadScopeLock ReadLock(Lock);
+
+	const int32 MaxResults = InMaxResults > 0 ? InMaxResults : MAX_int32;
+	AddSymbols(InPrefix, true, MaxResults, OutSymbols);
+	if (!bInDefinitionsOnly)
+	{
+		AddSymbols(InPrefix, false, MaxResults, OutSymbols);
+	}
+}
+
+int32 FTreeSitterSymbolIndex::GetFileCount() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return FileIds.Num();
+}
+
+int32 FTreeSitterSymbolIndex::GetSymbolCount() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return SymbolCount;
+}
+
+void FTreeSitterSymbolIndex::SetFileSymbols(const FString& InPath, const uint64 InContentHash, const TArray<FTreeSitterTag>& InTags)
+{
+	FWriteScopeLock WriteLock(Lock);
+
+	int32 FileId = INDEX_NONE;
+	if (const int32* ExistingFileId = FileIds.Find(InPath))
+	{
+		FileId = *ExistingFileId;
+		RemoveFileSymbols(FileId);
+	}
+	else
+	{
+		FileId = FreeFileIds.IsEmpty() ? Files.AddDefaulted() : FreeFileIds.Pop();
+		FileIds.Add(InPath, FileId);
+	}
+
+	FFileSymbols& File = Files[FileId];
+	File.Path = InPath;
+	File.ContentHash = InContentHash;
+	File.Symbols.Reserve(InTags.Num());
+
+	for (const FTreeSitterTag& Tag : InTags)
+	{
+		int32 NameId = INDEX_NONE;
+		if (const int32* ExistingNameId = NameIds.Find(Tag.Name))
+		{
+			NameId = *ExistingNameId;
+		}
+		else
+		{
+			NameId = Names.Add(Tag.Name);
+			NameIds.Add(Tag.Name, NameId);
+			NameFiles.AddDefaulted();
+			PendingNameIds.Add(NameId);
+			bHasPendingNames = true;
+		}
+
+		FSymbolRecord& Symbol = File.Symbols.AddDefaulted_GetRef();
+		Symbol.NameId = NameId;
+		Symbol.Kind = Tag.Kind;
+		Symbol.StartByte = Tag.StartByte;
+		Symbol.EndByte = Tag.EndByte;
+		Symbol.Row = Tag.Row;
+		Symbol.bIsDefinition = Tag.bIsDefinition;
+	}
+
+	// Grouped by name so that searches only visit the symbols of the names they match
+	Algo::StableSortBy(File.Symbols, &FSymbolRecord::NameId);
+	for (int32 Index = 0; Index < File.Symbols.Num(); ++Index)
+	{
+		const int32 NameId = File.Symbols[Index].NameId;
+		if (File.Names.IsEmpty() || File.Names.Last().NameId != NameId)
+		{
+			File.Names.Add({NameId, Index, 0});
+			NameFiles[NameId].Add(FileId);
+		}
+
+		++File.Names.Last().Num;
+	}
+
+	SymbolCount += File.Symbols.Num();
+}
+
+void FTreeSitterSymbolIndex::RemoveFileSymbols(const int32 InFileId)
+{
+	FFileSymbols& File = Files[InFileId];
+	for (const FNameSymbols& NameSymbols : File.Names)
+	{
+		NameFiles[NameSymbols.NameId].RemoveSingleSwap(InFileId);
+	}
+
+	SymbolCount -= File.Symbols.Num();
+	File.Symbols.Reset();
+	File.Names.Reset();
+}
+
+void FTreeSitterSymbolIndex::SortPendingNames() const
+{
+	if (!bHasPendingNames)
+	{
+		return;
+	}
+
+	const auto IsNameLess = [this](const int32 InA, const int32 InB)
+	{
+		return Names[InA].Compare(Names[InB], ESearchCase::IgnoreCase) < 0;
+	};
+
+	// Merging a few new names into the sorted ones is linear, rather than sorting everything again
+	PendingNameIds.Sort(IsNameLess);
+
+	TArray<int32> Merged;
+	Merged.Reserve(SortedNameIds.Num() + PendingNameIds.Num());
+
+	int32 SortedIndex = 0;
+	int32 PendingIndex = 0;
+	while (SortedIndex < SortedNameIds.Num() || PendingIndex < PendingNameIds.Num())
+	{
+		const bool bTakePending = PendingIndex < PendingNameIds.Num() && (SortedIndex == SortedNameIds.Num() || IsNameLess(PendingNameIds[PendingIndex], SortedNameIds[SortedIndex]));
+		Merged.Add(bTakePending ? PendingNameIds[PendingIndex++] : SortedNameIds[SortedIndex++]);
+	}
+
+	SortedNameIds = MoveTemp(Merged);
+	PendingNameIds.Reset();
+	bHasPendingNames = false;
+}
+
+void FTreeSitterSymbolIndex::AddSymbols(const FStringView InPrefix, const bool bInDefinitions, const int32 InMaxResults, TArray<FTreeSitterSymbolLocation>& OutSymbols) const
+{
+	// Names starting with the prefix are contiguous in case-insensitive order
+	int32 SortedIndex = Algo::LowerBoundBy(SortedNameIds, InPrefix, [this](const int32 InNameId)
+	{
+		return FStringView(Names[InNameId]);
+	}, [](const FStringView InA, const FStringView InB)
+	{
+		return InA.Compare(InB, ESearchCase::IgnoreCase) < 0;
+	});
+
+	for (; SortedIndex < SortedNameIds.Num(); ++SortedIndex)
+	{
+		const int32 NameId = SortedNameIds[SortedIndex];
+		const FString& Name = Names[NameId];
+		if (!FStringView(Name).StartsWith(InPrefix, ESearchCase::IgnoreCase))
+		{
+			break;
+		}
+
+		for (const int32 FileId : NameFiles[NameId])
+		{
+			const FFileSymbols& File = Files[FileId];
+			const int32 NameIndex = Algo::BinarySearchBy(File.Names, NameId, &FNameSymbols::NameId);
+			if (NameIndex == INDEX_NONE)
+			{
+				continue;
+			}
+
+			const FNameSymbols& NameSymbols = File.Names[NameIndex];
+			for (const FSymbolRecord& Symbol : TConstArrayView<FSymbolRecord>(File.Symbols).Slice(NameSymbols.Start, NameSymbols.Num))
+			{
+				if (Symbol.bIsDefinition != bInDefinitions)
+				{
+					continue;
+				}
+
+				if (OutSymbols.Num() >= InMaxResults)
+				{
+					return;
+				}
+
+				FTreeSitterSymbolLocation& Location = OutSymbols.AddDefaulted_GetRef();
+				Location.Path = File.Path;
+				Location.Tag.Name = Name;
+				Location.Tag.Kind = Symbol.Kind;
+				Location.Tag.bIsDefinition = Symbol.bIsDefinition;
+				Location.Tag.StartByte = Symbol.StartByte;
+				Location.Tag.EndByte = Symbol.EndByte;
+				Location.Tag.Row = Symbol.Row;
+			}
+		}
+	}
+}
@@ -0,0 +1,101 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterTags.h"
+
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter
+{
+	/** What a capture of a tags query stands for, resolved once per query run instead of once per capture */
+	struct FTagCapture
+	{
+		FName Kind;
+		bool bIsName = false;
+		bool bIsDefinition = false;
+		bool bIsReference = false;
+	};
+
+	static TArray<FTagCapture> GetTagCaptures(const FTreeSitterQuery& InQuery)
+	{
+		static const FString DefinitionPrefix = TEXT("definition.");
+		static const FString ReferencePrefix = TEXT("reference.");
+
+		TArray<FTagCapture> Captures;
+		const uint32 CaptureCount = ts_query_capture_count(InQuery.Get());
+		Captures.SetNum(CaptureCount);
+
+		for (uint32 Index = 0; Index < CaptureCount; ++Index)
+		{
+			const FString CaptureName = InQuery.GetCaptureName(Index).ToString();
+			FTagCapture& Capture = Captures[Index];
+			if (CaptureName == TEXT("name"))
+			{
+				Capture.bIsName = true;
+			}
+			else if (CaptureName.StartsWith(DefinitionPrefix))
+			{
+				Capture.bIsDefinition = true;
+				Capture.Kind = FName(CaptureName.RightChop(DefinitionPrefix.Len()));
+			}
+			else if (CaptureName.StartsWith(ReferencePrefix))
+			{
+				Capture.bIsReference = true;
+				Capture.Kind = FName(CaptureName.RightChop(ReferencePrefix.Len()));
+			}
+		}
+
+		return Captures;
+	}
+
+	void ExtractTags(const FTreeSitterQuery& InQuery, const TSNode& InRootNode, const FTreeSitterSource& InSource, TArray<FTreeSitterTag>& OutTags)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(TreeSitter::ExtractTags);
+
+		if (!InQuery.IsValid())
+		{
+			return;
+		}
+
+		const TArray<FTagCapture> Captures = GetTagCaptures(InQuery);
+
+		TSQueryCursor* Cursor = ts_query_cursor_new();
+		ts_query_cursor_exec(Cursor, InQuery.Get(), InRootNode);
+
+		TSQueryMatch Match;
+		while (ts_query_cursor_next_match(Cursor, &Match))
+		{
+			const TSQueryCapture* NameCapture = nullptr;
+			const FTagCapture* TagCapture = nullptr;
+			for (uint16 Index = 0; Index < Match.capture_count; ++Index)
+			{
+				const FTagCapture& Capture = Captures[Match.captures[Index].index];
+				if (Capture.bIsName)
+				{
+					NameCapture = &Match.captures[Index];
+				}
+				else if (Capture.bIsDefinition || Capture.bIsReference)
+				{
+					TagCapture = &Capture;
+				}
+			}
+
+			if (!NameCapture || !TagCapture)
+			{
+				continue;
+			}
+
+			FTreeSitterTag& Tag = OutTags.AddDefaulted_GetRef();
+			Tag.Name = FString(InSource.GetView(NameCapture->node));
+			Tag.Kind = TagCapture->Kind;
+			Tag.bIsDefinition = TagCapture->bIsDefinition;
+			Tag.StartByte = ts_node_start_byte(NameCapture->node);
+			Tag.EndByte = ts_node_end_byte(NameCapture->node);
+			Tag.Row = ts_node_start_point(NameCapture->node).row;
+		}
+
+		ts_query_cursor_delete(Cursor);
+	}
+}
@@ -0,0 +1,262 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterTreeCache.h"
+
+#include "Async/MappedFileHandle.h"
+#include "Hash/xxhash.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "ITreeSitterModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TreeSitterFlatTree.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::TreeCache
+{
+	static constexpr uint32 Magic = 0x43545354; // "TSTC"
+
+	/** Bump when FTreeSitterFlatNode, how its hash is computed or this header changes */
+	static constexpr uint32 FormatVersion = 3;
+
+	/** Stored as is at the start of every entry, followed by the node table */
+	struct FHeader
+	{
+		uint32 Magic = 0;
+		uint32 FormatVersion = 0;
+		uint32 LanguageVersion = 0;
+		uint32 Language = 0;
+		uint64 ContentHash = 0;
+		uint64 GrammarHash = 0;
+		uint32 NodeCount = 0;
+		uint32 Padding = 0;
+	};
+
+	static_assert(sizeof(FHeader) % alignof(FTreeSitterFlatNode) == 0, "Nodes must stay aligned after the header");
+
+	static FHeader MakeHeader(const ETreeSitterLanguage InLanguage, const TSLanguage* InTSLanguage, const uint64 InContentHash)
+	{
+		const FString GrammarRevision = ITreeSitterModule::Get().GetGrammarRevision(InLanguage);
+		const FTCHARToUTF8 GrammarRevisionUTF8(*GrammarRevision);
+
+		FHeader Header;
+		Header.Magic = Magic;
+		Header.FormatVersion = FormatVersion;
+		Header.LanguageVersion = ts_language_version(InTSLanguage);
+		Header.Language = static_cast<uint32>(InLanguage);
+		Header.ContentHash = InContentHash;
+		Header.GrammarHash = FXxHash64::HashBuffer(GrammarRevisionUTF8.Get(), GrammarRevisionUTF8.Length()).Hash;
+		return Header;
+	}
+
+	static bool IsHeaderValid(const FHeader& InHeader, const FHeader& InExpected, const int64 InSize)
+	{
+		return InHeader.Magic == InExpected.Magic
+			&& InHeader.FormatVersion == InExpected.FormatVersion
+			&& InHeader.LanguageVersion == InExpected.LanguageVersion
+			&& InHeader.Language == InExpected.Language
+			&& InHeader.ContentHash == InExpected.ContentHash
+			&& InHeader.GrammarHash == InExpected.GrammarHash
+			&& InSize == sizeof(FHeader) + static_cast<int64>(InHeader.NodeCount) * sizeof(FTreeSitterFlatNode);
+	}
+
+	/**
+	 * Whether a node table loaded from disk is a well formed pre-order: walks step by SubtreeSize and go up through
+	 * Parent, so a truncated or corrupted entry passing the header checks must not send them out of bounds or in
+	 * circles. Reads every node, which only matters for entries too large to be walked in full anyway.
+	 */
+	static bool IsNodeTableValid(const TConstArrayView<FTreeSitterFlatNode> InNodes)
+	{
+		const int64 NodeCount = InNodes.Num();
+		if (NodeCount == 0 || InNodes[0].Parent != INDEX_NONE || InNodes[0].SubtreeSize != NodeCount)
+		{
+			return false;
+		}
+
+		for (int32 Index = 1; Index < NodeCount; ++Index)
+		{
+			const FTreeSitterFlatNode& Node = InNodes[Index];
+			if (Node.SubtreeSize == 0 || Node.Parent < 0 || Node.Parent >= Index)
+			{
+				return false;
+			}
+
+			// Within its parent's subtree, which itself is within bounds
+			const FTreeSitterFlatNode& Parent = InNodes[Node.Parent];
+			if (Index + static_cast<int64>(Node.SubtreeSize) > Node.Parent + static_cast<int64>(Parent.SubtreeSize))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static const TSLanguage* GetTSLanguage(const ETreeSitterLanguage InLanguage)
+	{
+		ITreeSitterModule::FGetLanguageParser* GetLanguage = ITreeSitterModule::Get().GetLanguageParser(InLanguage);
+		return GetLanguage ? GetLanguage() : nullptr;
+	}
+}
+
+FTreeSitterTreeCache::FTreeSitterTreeCache(const FString& InDirectory)
+	: Directory(InDirectory.IsEmpty() ? FPaths::ProjectSavedDir() / TEXT("TreeSitter") / TEXT("TreeCache") : InDirectory)
+{
+}
+
+uint64 FTreeSitterTreeCache::HashContent(const FTreeSitterSource& InSource)
+{
+	return FXxHash64::HashBuffer(InSource.GetUTF8(), InSource.GetUTF8Length()).Hash;
+}
+
+TSharedPtr<const FTreeSitterFlatTree> FTreeSitterTreeCache::Find(const ETreeSitterLanguage InLanguage, const uint64 InContentHash) const
+{
+	using namespace UE::TreeSitter::TreeCache;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterTreeCache::Find);
+
+	const TSLanguage* Language = GetTSLanguage(InLanguage);
+	if (!Language)
+	{
+		return nullptr;
+	}
+
+	const FString Path = GetEntryPath(InLanguage, InContentHash);
+	const FHeader Expected = MakeHeader(InLanguage, Language, InContentHash);
+
+	// Mapped, entries are only paged in as they're walked
+	TUniquePtr<IMappedFileHandle> MappedFile(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path));
+	if (MappedFile.IsValid() && MappedFile->GetFileSize() >= static_cast<int64>(sizeof(FHeader)))
+	{
+		TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+		if (!MappedRegion.IsValid())
+		{
+			return nullptr;
+		}
+
+		const uint8* Data = MappedRegion->GetMappedPtr();
+		const FHeader& Header = *reinterpret_cast<const FHeader*>(Data);
+		if (!IsHeaderValid(Header, Expected, MappedRegion->GetMappedSize()))
+		{
+			return nullptr;
+		}
+
+		const TConstArrayView<FTreeSitterFlatNode> Nodes(reinterpret_cast<const FTreeSitterFlatNode*>(Data + sizeof(FHeader)), Header.NodeCount);
+		if (!IsNodeTableValid(Nodes))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Ignoring corrupted tree cache entry %s"), *Path);
+			return nullptr;
+		}
+
+		return MakeShared<const FTreeSitterFlatTree>(Language, MoveTemp(MappedFile), MoveTemp(MappedRegion), Nodes);
+	}
+
+	// Platforms without memory-mapped files
+	TArray<uint8> Buffer;
+	if (MappedFile.IsValid() || !FFileHelper::LoadFileToArray(Buffer, *Path, FILEREAD_Silent) || Buffer.Num() < sizeof(FHeader))
+	{
+		return nullptr;
+	}
+
+	FHeader Header;
+	FMemory::Memcpy(&Header, Buffer.GetData(), sizeof(FHeader));
+	if (!IsHeaderValid(Header, Expected, Buffer.Num()))
+	{
+		return nullptr;
+	}
+
+	TArray<FTreeSitterFlatNode> Nodes;
+	Nodes.SetNumUninitialized(Header.NodeCount);
+	FMemory::Memcpy(Nodes.GetData(), Buffer.GetData() + sizeof(FHeader), Header.NodeCount * sizeof(FTreeSitterFlatNode));
+	if (!IsNodeTableValid(Nodes))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Ignoring corrupted tree cache entry %s"), *Path);
+		return nullptr;
+	}
+
+	return MakeShared<const FTreeSitterFlatTree>(Language, MoveTemp(Nodes));
+}
+
+bool FTreeSitterTreeCache::Store(const ETreeSitterLanguage InLanguage, const uint64 InContentHash, const FTreeSitterFlatTree& InTree) const
+{
+	using namespace UE::TreeSitter::TreeCache;
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterTreeCache::Store);
+
+	if (!InTree.GetLanguage())
+	{
+		return false;
+	}
+
+	const TConstArrayView<FTreeSitterFlatNode> Nodes = InTree.GetNodes();
+
+	FHeader Header = MakeHeader(InLanguage, InTree.GetLanguage(), InContentHash);
+	Header.NodeCount = Nodes.Num();
+
+	TArray<uint8> Buffer;
+	Buffer.SetNumUninitialized(sizeof(FHeader) + Nodes.NumBytes());
+	FMemory::Memcpy(Buffer.GetData(), &Header, sizeof(FHeader));
+	FMemory::Memcpy(Buffer.GetData() + sizeof(FHeader), Nodes.GetData(), Nodes.NumBytes());
+
+	// Written aside then moved, so that concurrent readers never map a partial entry
+	const FString Path = GetEntryPath(InLanguage, InContentHash);
+	const FString TempPath = FString::Printf(TEXT("%s.%u.tmp"), *Path, FPlatformTLS::GetCurrentThreadId());
+	if (!FFileHelper::SaveArrayToFile(Buffer, *TempPath))
+	{
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*Path, *TempPath, true, true, false, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	return true;
+}
+
+TSharedPtr<const FTreeSitterFlatTree> FTreeSitterTreeCache::FindOrParse(const ETreeSitterLanguage InLanguage, const FTreeSitterSource& InSource, bool* bOutCacheHit) const
+{
+	const uint64 ContentHash = HashContent(InSource);
+	TSharedPtr<const FTreeSitterFlatTree> FlatTree = Find(InLanguage, ContentHash);
+	if (bOutCacheHit)
+	{
+		*bOutCacheHit = FlatTree.IsValid();
+	}
+
+	if (FlatTree.IsValid())
+	{
+		return FlatTree;
+	}
+
+	const TSLanguage* Language = UE::TreeSitter::TreeCache::GetTSLanguage(InLanguage);
+	if (!Language)
+	{
+		return nullptr;
+	}
+
+	const FTreeSitterPooledParser Parser(Language);
+	TSTree* Tree = Parser->Parse(InSource.GetUTF8(), InSource.GetUTF8Length());
+	if (!Tree)
+	{
+		return nullptr;
+	}
+
+	const TSharedRef<FTreeSitterFlatTree> NewFlatTree = FTreeSitterFlatTree::Build(Tree, InSource);
+	ts_tree_delete(Tree);
+
+	if (!Store(InLanguage, ContentHash, *NewFlatTree))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to store a %s tree in %s"), UE::TreeSitter::GetLanguageName(InLanguage), *Directory);
+	}
+
+	return NewFlatTree;
+}
+
+FString FTreeSitterTreeCache::GetEntryPath(const ETreeSitterLanguage InLanguage, const uint64 InContentHash) const
+{
+	return Directory / UE::TreeSitter::GetLanguageName(InLanguage) / FString::Printf(TEXT("%016llx.tstc"), InContentHash);
+}
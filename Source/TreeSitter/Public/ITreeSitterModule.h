@@ -6,10 +6,11 @@
 #include "Modules/ModuleManager.h"
 #include "UObject/ObjectMacros.h"
 
-class SWidget;
-struct FTreeSitterNode;
+class FTreeSitterQuery;
 struct TSLanguage;
 
+using TSSymbol = uint16_t;
+
 UENUM()
 enum class ETreeSitterLanguage : uint8
 {
@@ -17,10 +18,12 @@ enum class ETreeSitterLanguage : uint8
 	Json,
 	Markdown,
 	MarkdownInline,
+	C,
+	Cpp,
+	Python,
+	Yaml,
 };
 
-DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FTreeSitterOnGetCustomWidgetInstance, const TSharedRef<FTreeSitterNode>&, const FString&);
-
 /**
  * Interface for the Concert Sync Server module.
  */
@@ -54,14 +57,23 @@ public:
 
 	/**
 	 * Returns corresponding language parser, use this to get a reference onto `tree_sitter_json()` etc.
+	 *
+	 * Grammar libraries are loaded on first request, so that targets only pay for the languages they parse. Safe to
+	 * call from any thread, returns nullptr if the grammar couldn't be loaded on this platform.
 	 */
 	virtual FGetLanguageParser* GetLanguageParser(const ETreeSitterLanguage InLanguage) = 0;
 
-	virtual void RegisterCustomMarkdownWidget(const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate) = 0;
-	virtual void UnregisterCustomMarkdownWidget(const FName& InNodeName) = 0;
-
-	/** Create widget for a given node type */
-    virtual TSharedRef<SWidget> CreateWidgetForNodeType(const FName& InNodeType, const TSharedRef<FTreeSitterNode>& InNode, const FString& InOriginalSource) = 0;
+	/**
+	 * Returns a query bundled with the plugin, `Resources/Queries/<Language>/<Name>.scm` (e.g. "tags").
+	 *
+	 * Compiled on first request and shared, a compiled query being immutable. Safe to call from any thread, returns
+	 * nullptr if the language has no such query or it doesn't compile against the loaded grammar.
+	 */
+	virtual TSharedPtr<const FTreeSitterQuery> FindQuery(const ETreeSitterLanguage InLanguage, const FString& InQueryName) = 0;
 
-	virtual bool HasCustomWidgetForNodeType(const FName& InNodeType) = 0;
+	/**
+	 * Identifies the build of a grammar library: its commit as listed in language-manifest.txt, or its timestamp and
+	 * size for custom builds. Data derived from parse results (e.g. cached trees) must be invalidated when it changes.
+	 */
+	virtual FString GetGrammarRevision(const ETreeSitterLanguage InLanguage) = 0;
 };
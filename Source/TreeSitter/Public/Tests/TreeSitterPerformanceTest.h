@@ -0,0 +1,45 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Misc/AutomationTest.h"
+#include "Templates/Function.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Helpers for the performance specs of the TreeSitter modules.
+ *
+ * Measurements are compared against Resources/Tests/PerformanceBaseline.ini, one section per measure:
+ *
+ *		[Parse.Json]
+ *		TimeMs=12.5
+ *		Allocations=4210
+ *
+ * Allocations are the ones made by tree-sitter (see UE::TreeSitter::GetAllocationCount()), deterministic for a given
+ * input and checked with a tight tolerance. Time is machine dependent, and only catches large regressions. Run with
+ * -TreeSitterUpdateBaseline to record the current measures into the baseline, on the reference machine.
+ */
+namespace UE::TreeSitter::Tests
+{
+	/** Runs InFunction a few times, and checks the best time and allocation count against the baseline entry InName */
+	TREESITTER_API bool TestPerformance(FAutomationTestBase& InTest, const FString& InName, const TFunctionRef<void()>& InFunction);
+
+	/** Input size ratio between the two functions compared by TestLinearScaling() */
+	inline constexpr int32 ScalingInputFactor = 4;
+
+	/**
+	 * Checks that the cost of an operation grows linearly with its input, InLargerFunction running the same operation
+	 * on an input ScalingInputFactor times larger. The best time and allocation count may grow InMaxGrowth times at
+	 * most, twice linear by default where a quadratic regression would be 16 times. Needs no baseline, so it holds on
+	 * any machine.
+	 */
+	TREESITTER_API bool TestLinearScaling(FAutomationTestBase& InTest, const FString& InName, const TFunctionRef<void()>& InFunction, const TFunctionRef<void()>& InLargerFunction, const double InMaxGrowth = 2.0 * ScalingInputFactor);
+
+	/** Deterministic inputs, large enough for parse time to dominate the measure */
+	TREESITTER_API FString GenerateJson(const int32 InObjectCount);
+	TREESITTER_API FString GenerateJavaScript(const int32 InFunctionCount);
+	TREESITTER_API FString GenerateMarkdown(const int32 InSectionCount);
+}
+
+#endif
@@ -5,9 +5,12 @@
 #include <stdio.h>
 #include "tree_sitter/api.h"
 
+#if PLATFORM_WINDOWS
+
 // Fixup all the unresolved symbols linker errors
 //
-// Note: This must have to do with how I compile the static library for tree-sitter (using zig).
+// Note: This must have to do with how I compile the static library for tree-sitter (using zig). Other platforms link
+// a library built with their own toolchain, and don't need them.
 extern "C" {
 	
 void __stack_chk_fail(void)
@@ -38,3 +41,4 @@ int __mingw_vsnprintf(_Out_writes_opt_(_BufferCount) _Always_(_Post_z_) char* co
 	
 }
 
+#endif
@@ -0,0 +1,63 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FTreeSitterFlatTree;
+class FTreeSitterSource;
+struct TSTree;
+
+enum class ETreeSitterDiffOperation : uint8
+{
+	/** Subtree only in the new tree */
+	Insert,
+	/** Subtree only in the old tree */
+	Delete,
+	/** Node matched under another parent, or reordered among its siblings */
+	Move,
+	/** Node without named children matched to one with another text, e.g. a changed value */
+	Update,
+};
+
+/** Single step of an edit script, node indices refer to the flat trees of the diff */
+struct FTreeSitterDiffEdit
+{
+	ETreeSitterDiffOperation Operation = ETreeSitterDiffOperation::Update;
+
+	/** INDEX_NONE for inserts */
+	int32 OldNode = INDEX_NONE;
+
+	/** INDEX_NONE for deletes */
+	int32 NewNode = INDEX_NONE;
+};
+
+/** Structural differences between two revisions of a document, see UE::TreeSitter::DiffTrees() */
+struct FTreeSitterTreeDiff
+{
+	TSharedPtr<const FTreeSitterFlatTree> OldTree;
+	TSharedPtr<const FTreeSitterFlatTree> NewTree;
+
+	/** Inserts, moves and updates in new tree order, then deletes in old tree order */
+	TArray<FTreeSitterDiffEdit> Edits;
+
+	/** Matched node in the other tree for each node, INDEX_NONE if none */
+	TArray<int32> OldToNew;
+	TArray<int32> NewToOld;
+};
+
+namespace UE::TreeSitter
+{
+	/**
+	 * Computes an edit script turning one tree into another, over named nodes only (punctuation follows its parent).
+	 *
+	 * Identical subtrees are matched at once by structural hash, largest first so that a subtree is never split to match
+	 * a copy of one of its descendants. Unmatched parents are then matched through the children they share, and the remaining children of matched parents by hash then by symbol, in order.
+	 * Inserts and deletes are reported for the root of each unmatched subtree only. Near-linear in the size of both
+	 * trees, but greedy: the script is small, not guaranteed minimal.
+	 */
+	TREESITTER_API void DiffTrees(const TSharedRef<const FTreeSitterFlatTree>& InOldTree, const TSharedRef<const FTreeSitterFlatTree>& InNewTree, FTreeSitterTreeDiff& OutDiff);
+
+	/** Same as above, flattening both trees first */
+	TREESITTER_API void DiffTrees(const TSTree* InOldTree, const FTreeSitterSource& InOldSource, const TSTree* InNewTree, const FTreeSitterSource& InNewSource, FTreeSitterTreeDiff& OutDiff);
+}
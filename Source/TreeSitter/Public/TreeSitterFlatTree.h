@@ -0,0 +1,108 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class FTreeSitterSource;
+struct TSLanguage;
+struct TSTree;
+
+enum class ETreeSitterFlatNodeFlags : uint8
+{
+	None = 0,
+	Named = 1 << 0,
+	Missing = 1 << 1,
+	Extra = 1 << 2,
+	Error = 1 << 3,
+	HasError = 1 << 4,
+};
+ENUM_CLASS_FLAGS(ETreeSitterFlatNodeFlags);
+
+/**
+ * Node of a FTreeSitterFlatTree. Plain data, so that a table of them can be written to disk and memory-mapped back.
+ */
+struct FTreeSitterFlatNode
+{
+	/**
+	 * Structural hash of the subtree: symbol, hashes of the children and text of the leaves. Independent of where the
+	 * subtree sits, and of the whitespace between its tokens, so that unchanged subtrees can be matched across
+	 * reparses (see UE::TreeSitter::DiffTrees()).
+	 */
+	uint64 Hash = 0;
+
+	/** UTF-8 byte range */
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+
+	/** 0-based row and byte column of the start */
+	uint32 StartRow = 0;
+	uint32 StartColumn = 0;
+
+	/** Index of the parent node, INDEX_NONE for the root */
+	int32 Parent = INDEX_NONE;
+
+	/** Nodes in this subtree, this one included. The first child is at Index + 1, the next sibling at Index + SubtreeSize. */
+	uint32 SubtreeSize = 1;
+
+	/** TSSymbol of the node */
+	uint16 Symbol = 0;
+
+	/** Field of this node in its parent, 0 if none */
+	uint16 FieldId = 0;
+
+	ETreeSitterFlatNodeFlags Flags = ETreeSitterFlatNodeFlags::None;
+	uint8 Padding[3] = {};
+
+	bool IsNamed() const { return EnumHasAnyFlags(Flags, ETreeSitterFlatNodeFlags::Named); }
+	bool IsMissing() const { return EnumHasAnyFlags(Flags, ETreeSitterFlatNodeFlags::Missing); }
+	bool IsError() const { return EnumHasAnyFlags(Flags, ETreeSitterFlatNodeFlags::Error); }
+	bool HasError() const { return EnumHasAnyFlags(Flags, ETreeSitterFlatNodeFlags::HasError); }
+};
+
+static_assert(sizeof(FTreeSitterFlatNode) == 40, "FTreeSitterFlatNode is stored as is on disk");
+
+/**
+ * Compact, immutable snapshot of a parse result: every node of a tree (anonymous ones included) in pre-order, as a
+ * contiguous table.
+ *
+ * Unlike a TSTree, it can be persisted and loaded back without parsing (see FTreeSitterTreeCache), and walked
+ * without cursor. It can't be edited or reparsed incrementally, nor queried: tree-sitter can't rebuild a TSTree out of
+ * it, consumers needing one still have to parse.
+ */
+class TREESITTER_API FTreeSitterFlatTree
+{
+public:
+	/** Flattens a tree in a single cursor walk, then hashes its subtrees bottom-up */
+	static TSharedRef<FTreeSitterFlatTree> Build(const TSTree* InTree, const FTreeSitterSource& InSource);
+
+	/** Takes ownership of an already built table */
+	FTreeSitterFlatTree(const TSLanguage* InLanguage, TArray<FTreeSitterFlatNode>&& InNodes);
+
+	/** Views a table memory-mapped from disk, kept mapped as long as this tree is alive */
+	FTreeSitterFlatTree(const TSLanguage* InLanguage, TUniquePtr<IMappedFileHandle> InMappedFile, TUniquePtr<IMappedFileRegion> InMappedRegion, const TConstArrayView<FTreeSitterFlatNode> InNodes);
+
+	~FTreeSitterFlatTree();
+
+	const TSLanguage* GetLanguage() const { return Language; }
+
+	/** Nodes in pre-order, the root being the first one */
+	TConstArrayView<FTreeSitterFlatNode> GetNodes() const { return Nodes; }
+
+	/** Type of a node, as ts_node_type() would return it */
+	const char* GetNodeType(const FTreeSitterFlatNode& InNode) const;
+
+	/** Same as UE::TreeSitter::ForEachSyntaxError(), without descending into subtrees free of errors */
+	void ForEachSyntaxError(const TFunctionRef<void(const FTreeSitterFlatNode&)>& InCallback) const;
+
+private:
+	const TSLanguage* Language = nullptr;
+
+	TArray<FTreeSitterFlatNode> OwnedNodes;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	TConstArrayView<FTreeSitterFlatNode> Nodes;
+};
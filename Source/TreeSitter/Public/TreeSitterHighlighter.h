@@ -0,0 +1,80 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FTreeSitterQuery;
+class FTreeSitterSource;
+struct TSInputEdit;
+struct TSTree;
+
+/** Highlighted part of a line, columns are character indices in the line */
+struct FTreeSitterHighlightSpan
+{
+	int32 StartColumn = 0;
+	int32 EndColumn = 0;
+
+	/** Capture of the highlights query, see FTreeSitterHighlighter::GetCaptureName() */
+	uint16 Capture = 0;
+};
+
+/**
+ * Runs a `highlights.scm` query (see ITreeSitterModule::FindQuery(Language, "highlights")) over the lines actually
+ * displayed instead of the whole tree.
+ *
+ * Lines are highlighted by blocks of LinesPerBlock, each block being queried on its own with
+ * ts_query_cursor_set_point_range() the first time one of its lines is requested, and cached until an edit reaches
+ * it. Scrolling through a file only queries the blocks scrolled to, so the cost is bounded by the viewport.
+ *
+ * Spans of a line are in capture order: outer nodes first, nested ones after. Only the first capture of a node is
+ * kept, following the tree-sitter convention that earlier patterns take precedence.
+ */
+class TREESITTER_API FTreeSitterHighlighter
+{
+public:
+	static constexpr int32 LinesPerBlock = 64;
+
+	explicit FTreeSitterHighlighter(const TSharedRef<const FTreeSitterQuery>& InQuery);
+	~FTreeSitterHighlighter();
+
+	/** Highlights a new document, dropping every cached block. The tree is copied. */
+	void SetTree(const TSTree* InTree, const TSharedRef<const FTreeSitterSource>& InSource);
+
+	/**
+	 * Highlights a new revision of the document, dropping the blocks reached by the edit or by the tree-sitter changed
+	 * ranges only. Blocks after an edit adding or removing lines are dropped as well, their rows having moved.
+	 *
+	 * @param InOldTree Previous tree, already edited with ts_tree_edit()
+	 */
+	void UpdateTree(const TSInputEdit& InEdit, const TSTree* InOldTree, const TSTree* InTree, const TSharedRef<const FTreeSitterSource>& InSource);
+
+	/** Spans of each line in [InFirstLine, InEndLine), querying the blocks not cached yet */
+	void GetLineSpans(const int32 InFirstLine, const int32 InEndLine, TArray<TArray<FTreeSitterHighlightSpan>>& OutLineSpans);
+
+	/** Capture name without the leading @, e.g. "keyword" or "function.method" */
+	FName GetCaptureName(const uint16 InCapture) const;
+
+	int32 GetLineCount() const { return LineStarts.Num(); }
+	int32 GetCachedBlockCount() const { return Blocks.Num(); }
+
+private:
+	struct FBlock
+	{
+		/** Spans of line N are Spans[LineSpanStarts[N]] to Spans[LineSpanStarts[N + 1]] */
+		TArray<int32> LineSpanStarts;
+		TArray<FTreeSitterHighlightSpan> Spans;
+	};
+
+	const FBlock& FindOrQueryBlock(const int32 InBlockIndex);
+	void UpdateLineStarts();
+
+	TSharedRef<const FTreeSitterQuery> Query;
+	TSharedPtr<const FTreeSitterSource> Source;
+	TSTree* Tree = nullptr;
+
+	/** UTF-8 byte offset of each line */
+	TArray<uint32> LineStarts;
+
+	TMap<int32, FBlock> Blocks;
+};
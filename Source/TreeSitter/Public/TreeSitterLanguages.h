@@ -0,0 +1,25 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ETreeSitterLanguage : uint8;
+
+namespace UE::TreeSitter
+{
+	/** Display name of a language, also accepted by FindLanguageByName() */
+	TREESITTER_API const TCHAR* GetLanguageName(const ETreeSitterLanguage InLanguage);
+
+	/** Case insensitive lookup of the languages documents can be written in (MarkdownInline is only injected) */
+	TREESITTER_API bool FindLanguageByName(const FString& InName, ETreeSitterLanguage& OutLanguage);
+
+	/** Language of a file, from its extension without the dot (e.g. "json", "uplugin", "md", "h") */
+	TREESITTER_API bool FindLanguageForExtension(const FString& InExtension, ETreeSitterLanguage& OutLanguage);
+
+	/**
+	 * Files under InDirectories (recursively) with a known grammar accepted by InFilter, with their language. Sorted
+	 * by path, so that tools walking a project report the same order from one run to the other.
+	 */
+	TREESITTER_API TArray<TPair<FString, ETreeSitterLanguage>> FindLanguageFiles(const TArray<FString>& InDirectories, const TFunctionRef<bool(ETreeSitterLanguage)>& InFilter);
+}
@@ -0,0 +1,92 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FTreeSitterQuery;
+class FTreeSitterSource;
+struct TSInputEdit;
+struct TSLanguage;
+struct TSNode;
+struct TSTree;
+
+enum class ETreeSitterLintSeverity : uint8
+{
+	Info,
+	Warning,
+	Error,
+};
+
+/**
+ * Lint rule: every match of its query is reported with its message. The reported range is the node captured as @lint
+ * when the query has such a capture, the range covering all the captures of the match otherwise.
+ */
+struct FTreeSitterLintRule
+{
+	/** e.g. "no-var" */
+	FName Id;
+	FString Query;
+	FString Message;
+	ETreeSitterLintSeverity Severity = ETreeSitterLintSeverity::Warning;
+};
+
+struct FTreeSitterLintDiagnostic
+{
+	/** Index of the rule in FTreeSitterLinter::GetRules() */
+	int32 Rule = INDEX_NONE;
+
+	/** UTF-8 byte range and 0-based row of the reported node */
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+	uint32 Row = 0;
+
+	/** UTF-8 byte range covering all the captures of the match, an edit reaching it lints the match again */
+	uint32 MatchStartByte = 0;
+	uint32 MatchEndByte = 0;
+};
+
+/**
+ * Runs a set of lint rules for one language.
+ *
+ * The queries of all the rules are compiled into a single combined query, so that linting a file is one cursor pass
+ * whatever the number of rules. The linter is immutable once built and can be shared by worker threads.
+ */
+class TREESITTER_API FTreeSitterLinter
+{
+public:
+	FTreeSitterLinter(const TSLanguage* InLanguage, TArray<FTreeSitterLintRule> InRules);
+
+	/** Whether every rule compiled, see GetError() otherwise */
+	bool IsValid() const;
+	const FString& GetError() const;
+
+	const TArray<FTreeSitterLintRule>& GetRules() const { return Rules; }
+
+	/** Lints a whole tree, diagnostics being sorted by start */
+	void Lint(const TSTree* InTree, const FTreeSitterSource& InSource, TArray<FTreeSitterLintDiagnostic>& OutDiagnostics) const;
+
+	/**
+	 * Updates the diagnostics of a document after an edit, only linting again the matches reaching the region of the
+	 * edit and the tree-sitter changed ranges. Diagnostics after it are shifted.
+	 *
+	 * @param InOldTree Previous tree, already edited with ts_tree_edit()
+	 */
+	void UpdateDiagnostics(const TSInputEdit& InEdit, const TSTree* InOldTree, const TSTree* InTree, const FTreeSitterSource& InSource, TArray<FTreeSitterLintDiagnostic>& InOutDiagnostics) const;
+
+private:
+	/** Lints the matches with a capture touching [InStartByte, InEndByte] */
+	void LintRange(const TSNode& InRootNode, const FTreeSitterSource& InSource, const uint32 InStartByte, const uint32 InEndByte, TArray<FTreeSitterLintDiagnostic>& OutDiagnostics) const;
+
+	TArray<FTreeSitterLintRule> Rules;
+	TSharedPtr<const FTreeSitterQuery> Query;
+
+	/** Rule of each pattern of the combined query */
+	TArray<int32> PatternRules;
+
+	/** Whether the rule of each pattern has a @lint capture, the combined query has one as soon as any rule does */
+	TBitArray<> PatternHasLintCapture;
+
+	int32 LintCapture = INDEX_NONE;
+	FString Error;
+};
@@ -0,0 +1,100 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FTreeSitterQuery;
+class FTreeSitterSource;
+struct TSInputEdit;
+struct TSTree;
+
+/** Node captured as @local.scope. Scopes are stored in pre-order, nested ones right after their parent. */
+struct FTreeSitterLocalScope
+{
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+
+	/** INDEX_NONE for top-level scopes */
+	int32 Parent = INDEX_NONE;
+};
+
+/** Identifier captured as @local.definition */
+struct FTreeSitterLocalDefinition
+{
+	/** xxHash64 of the identifier, the text itself lives in the source */
+	uint64 NameHash = 0;
+
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+
+	/** Innermost scope, INDEX_NONE at file level */
+	int32 Scope = INDEX_NONE;
+};
+
+/** Identifier captured as @local.reference, and the definition it resolves to */
+struct FTreeSitterLocalReference
+{
+	uint64 NameHash = 0;
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+	int32 Scope = INDEX_NONE;
+
+	/** INDEX_NONE if not defined locally (globals, members, ...) */
+	int32 Definition = INDEX_NONE;
+};
+
+/**
+ * Scope tree of a document and resolution of its local references, out of a `locals.scm` query (see
+ * ITreeSitterModule::FindQuery(Language, "locals")) following the tree-sitter conventions: @local.scope,
+ * @local.definition and @local.reference captures.
+ *
+ * A reference resolves to the last definition of the same name before it, in the innermost enclosing scope that has
+ * one, or to any definition of those scopes otherwise (hoisted functions, members used before their declaration).
+ *
+ * Definitions, references and scopes are sorted by start byte.
+ */
+class TREESITTER_API FTreeSitterLocals
+{
+public:
+	static TSharedRef<FTreeSitterLocals> Build(const TSharedRef<const FTreeSitterQuery>& InQuery, const TSTree* InTree, const FTreeSitterSource& InSource);
+
+	/**
+	 * Updates the locals of a document after an edit. Only the innermost scope enclosing the changes is queried and
+	 * resolved again, everything else is shifted. Falls back to Build() when the edit reaches top-level scopes.
+	 *
+	 * @param InEdit Edit applied to the previous source
+	 * @param InOldTree Previous tree, already edited with ts_tree_edit()
+	 * @param InTree Tree of the new source, reparsed from InOldTree
+	 */
+	TSharedRef<FTreeSitterLocals> Update(const TSInputEdit& InEdit, const TSTree* InOldTree, const TSTree* InTree, const FTreeSitterSource& InSource) const;
+
+	/** Definition of the reference or definition at a byte offset, INDEX_NONE if none */
+	int32 FindDefinitionAt(const uint32 InByteOffset) const;
+
+	/** References resolved to a definition, in document order */
+	void FindReferences(const int32 InDefinition, TArray<int32>& OutReferences) const;
+
+	const TArray<FTreeSitterLocalScope>& GetScopes() const { return Scopes; }
+	const TArray<FTreeSitterLocalDefinition>& GetDefinitions() const { return Definitions; }
+	const TArray<FTreeSitterLocalReference>& GetReferences() const { return References; }
+
+	/** Byte range queried by the last Build() or Update(), for diagnostics */
+	uint32 GetUpdatedStartByte() const { return UpdatedStartByte; }
+	uint32 GetUpdatedEndByte() const { return UpdatedEndByte; }
+
+	explicit FTreeSitterLocals(const TSharedRef<const FTreeSitterQuery>& InQuery);
+
+private:
+	/** Resolves the references of a range of References, definitions being final */
+	void ResolveReferences(const int32 InFirstReference, const int32 InEndReference);
+
+	TSharedRef<const FTreeSitterQuery> Query;
+
+	TArray<FTreeSitterLocalScope> Scopes;
+	TArray<FTreeSitterLocalDefinition> Definitions;
+	TArray<FTreeSitterLocalReference> References;
+
+	uint32 UpdatedStartByte = 0;
+	uint32 UpdatedEndByte = 0;
+};
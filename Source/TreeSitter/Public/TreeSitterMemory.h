@@ -0,0 +1,155 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "HAL/LowLevelMemTracker.h"
+#include "HAL/UnrealMemory.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+#include <atomic>
+
+LLM_DECLARE_TAG_API(TreeSitter, TREESITTER_API);
+
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Allocated Memory"), STAT_TreeSitter_AllocatedMemory, STATGROUP_TreeSitter, TREESITTER_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Live Allocations"), STAT_TreeSitter_LiveAllocations, STATGROUP_TreeSitter, TREESITTER_API);
+
+namespace UE::TreeSitter
+{
+	namespace Private
+	{
+#if !UE_BUILD_SHIPPING
+		/** Allocation calls made by tree-sitter in any module, see GetAllocationCount() */
+		extern TREESITTER_API std::atomic<uint64> AllocationCount;
+
+		/** Bytes currently allocated by tree-sitter, and their high-water mark, see GetPeakAllocatedBytes() */
+		extern TREESITTER_API std::atomic<uint64> AllocatedBytes;
+		extern TREESITTER_API std::atomic<uint64> PeakAllocatedBytes;
+#endif
+
+		inline void TrackAllocation(void* InMemory)
+		{
+#if !UE_BUILD_SHIPPING
+			AllocationCount.fetch_add(1, std::memory_order_relaxed);
+#endif
+
+#if !UE_BUILD_SHIPPING || STATS
+			if (InMemory)
+			{
+				const SIZE_T Size = FMemory::GetAllocSize(InMemory);
+
+#if !UE_BUILD_SHIPPING
+				const uint64 Allocated = AllocatedBytes.fetch_add(Size, std::memory_order_relaxed) + Size;
+				uint64 Peak = PeakAllocatedBytes.load(std::memory_order_relaxed);
+				while (Allocated > Peak && !PeakAllocatedBytes.compare_exchange_weak(Peak, Allocated, std::memory_order_relaxed))
+				{
+				}
+#endif
+
+				INC_MEMORY_STAT_BY(STAT_TreeSitter_AllocatedMemory, Size);
+				INC_DWORD_STAT(STAT_TreeSitter_LiveAllocations);
+			}
+#endif
+		}
+
+		inline void UntrackAllocation(void* InMemory)
+		{
+#if !UE_BUILD_SHIPPING || STATS
+			if (InMemory)
+			{
+				const SIZE_T Size = FMemory::GetAllocSize(InMemory);
+
+#if !UE_BUILD_SHIPPING
+				AllocatedBytes.fetch_sub(Size, std::memory_order_relaxed);
+#endif
+
+				DEC_MEMORY_STAT_BY(STAT_TreeSitter_AllocatedMemory, Size);
+				DEC_DWORD_STAT(STAT_TreeSitter_LiveAllocations);
+			}
+#endif
+		}
+
+		inline void* Malloc(const size_t InSize)
+		{
+			LLM_SCOPE_BYTAG(TreeSitter);
+			void* Memory = FMemory::Malloc(InSize);
+			TrackAllocation(Memory);
+			return Memory;
+		}
+
+		inline void* Calloc(const size_t InCount, const size_t InSize)
+		{
+			LLM_SCOPE_BYTAG(TreeSitter);
+			void* Memory = FMemory::MallocZeroed(InCount * InSize);
+			TrackAllocation(Memory);
+			return Memory;
+		}
+
+		inline void* Realloc(void* InMemory, const size_t InSize)
+		{
+			LLM_SCOPE_BYTAG(TreeSitter);
+			UntrackAllocation(InMemory);
+			void* Memory = FMemory::Realloc(InMemory, InSize);
+			TrackAllocation(Memory);
+			return Memory;
+		}
+
+		inline void Free(void* InMemory)
+		{
+			UntrackAllocation(InMemory);
+			FMemory::Free(InMemory);
+		}
+	}
+
+	/**
+	 * Routes tree-sitter allocations (parsers, trees, queries, cursors) through FMemory, under the TreeSitter LLM tag
+	 * and STATGROUP_TreeSitter.
+	 *
+	 * tree-sitter is linked as a static library: in modular builds, every module depending on TreeSitterLibrary gets its
+	 * own copy of the allocator hooks. Modules creating or freeing tree-sitter objects themselves must call this from
+	 * their StartupModule(), before any ts_* call, so that trees can be handed over from one module to another.
+	 */
+	inline void InstallAllocator()
+	{
+		ts_set_allocator(&Private::Malloc, &Private::Calloc, &Private::Realloc, &Private::Free);
+	}
+
+	/**
+	 * Number of allocation calls (malloc, calloc and realloc) made by tree-sitter since startup. Deterministic for a
+	 * given input when parsing on a single thread, which performance tests rely on. Always 0 in shipping builds.
+	 */
+	inline uint64 GetAllocationCount()
+	{
+#if !UE_BUILD_SHIPPING
+		return Private::AllocationCount.load(std::memory_order_relaxed);
+#else
+		return 0;
+#endif
+	}
+
+	/**
+	 * Highest number of bytes allocated by tree-sitter at once, since startup or the last ResetPeakAllocatedBytes().
+	 * Unlike the process wide peak, it only accounts for parsers, trees, queries and cursors. Always 0 in shipping builds.
+	 */
+	inline uint64 GetPeakAllocatedBytes()
+	{
+#if !UE_BUILD_SHIPPING
+		return Private::PeakAllocatedBytes.load(std::memory_order_relaxed);
+#else
+		return 0;
+#endif
+	}
+
+	/** Lowers the high-water mark to the bytes currently allocated, to measure the peak of the next operations alone */
+	inline void ResetPeakAllocatedBytes()
+	{
+#if !UE_BUILD_SHIPPING
+		Private::PeakAllocatedBytes.store(Private::AllocatedBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+#endif
+	}
+
+	/** Frees memory handed over by tree-sitter, such as the string returned by ts_node_string() */
+	inline void Free(void* InMemory)
+	{
+		Private::Free(InMemory);
+	}
+}
@@ -2,10 +2,11 @@
 
 #pragma once
 
+#include "Templates/Function.h"
 #include "Templates/SharedPointer.h"
 #include "tree_sitter/api.h"
 
-struct FTreeSitterNode
+struct TREESITTER_API FTreeSitterNode
 {
 	TArray<TSharedPtr<FTreeSitterNode>> Children;
 	
@@ -19,7 +20,6 @@ struct FTreeSitterNode
 	TSPoint StartPoint;
 	TSPoint EndPoint;
 
-	FString SExpression;
 	FString ExtractedSource;
 	
 	bool bIsNull;
@@ -45,3 +45,15 @@ struct FTreeSitterNode
 	// explicit FTreeSitterNode(const TSNode& InNode, const TSharedRef<FString>& InSourceCode, const uint32 InDepth = 0);
 	explicit FTreeSitterNode(const TSNode& InNode, const uint32 InDepth = 0);
 };
+
+namespace UE::TreeSitter
+{
+	/**
+	 * Calls InCallback for every ERROR and MISSING node of a tree, in document order. Only descends into subtrees
+	 * containing an error, and not into ERROR nodes themselves, whose nested errors are part of the same one.
+	 */
+	TREESITTER_API void ForEachSyntaxError(const TSNode& InRootNode, const TFunctionRef<void(const TSNode&)>& InCallback);
+
+	/** Number of syntax errors ForEachSyntaxError() would report */
+	TREESITTER_API int32 CountSyntaxErrors(const TSNode& InRootNode);
+}
@@ -7,6 +7,7 @@
 enum class ETreeSitterLanguage : uint8;
 struct TSLanguage;
 struct TSParser;
+struct TSRange;
 struct TSTree;
 
 class TREESITTER_API FTreeSitterParser : public TSharedFromThis<FTreeSitterParser>
@@ -17,8 +18,28 @@ public:
 
 	bool SetLanguage(const TSLanguage* Language) const;
 	bool SetLanguage(const ETreeSitterLanguage InLanguage) const;
+	const TSLanguage* GetLanguage() const;
+
+	/** Restricts parsing to the given (ordered, non-overlapping) ranges. An empty array resets it to the whole document. */
+	bool SetIncludedRanges(const TArray<TSRange>& InRanges) const;
+
+	/** Clears included ranges and any parse state, used when a parser goes back into a pool */
+	void Reset() const;
+
 	TSTree* Parse(const FString& SourceCode) const;
 
+	/**
+	 * Parses an already UTF-8 encoded buffer, avoiding a conversion when the same source is parsed multiple times.
+	 *
+	 * Passing the previous tree (already edited with ts_tree_edit) makes it an incremental reparse.
+	 */
+	TSTree* Parse(const ANSICHAR* InUTF8Source, const uint32 InLength, const TSTree* InOldTree = nullptr) const;
+
 private:
+	bool SetLanguage(const TSLanguage* InLanguage, const TCHAR* InLanguageName) const;
+
 	TSParser* Parser;
+
+	/** Name of the current language, used as trace scope */
+	mutable const TCHAR* LanguageName = TEXT("Unknown");
 };
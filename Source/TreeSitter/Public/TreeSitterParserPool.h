@@ -0,0 +1,58 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "HAL/CriticalSection.h"
+#include "Templates/SharedPointer.h"
+
+class FTreeSitterParser;
+struct TSLanguage;
+
+/**
+ * Thread safe pool of parsers, bucketed per language.
+ *
+ * Creating a TSParser and assigning it a language is cheap but not free, and a parser can only be used by one
+ * thread at a time. Sub-parses fanned out to worker threads borrow a parser from here instead of creating their own.
+ */
+class TREESITTER_API FTreeSitterParserPool
+{
+public:
+	static FTreeSitterParserPool& Get();
+
+	/** Returns a parser set to the given language, either recycled or newly created */
+	TSharedRef<FTreeSitterParser> Acquire(const TSLanguage* InLanguage);
+
+	/** Gives a parser back to the pool. Included ranges and parse state are reset. */
+	void Release(const TSharedRef<FTreeSitterParser>& InParser);
+
+	/** Frees all pooled parsers */
+	void Empty();
+
+private:
+	FCriticalSection CriticalSection;
+	TMap<const TSLanguage*, TArray<TSharedRef<FTreeSitterParser>>> FreeParsers;
+};
+
+/** Scoped parser borrowed from FTreeSitterParserPool, and given back on destruction */
+class FTreeSitterPooledParser
+{
+public:
+	explicit FTreeSitterPooledParser(const TSLanguage* InLanguage)
+		: Parser(FTreeSitterParserPool::Get().Acquire(InLanguage))
+	{
+	}
+
+	~FTreeSitterPooledParser()
+	{
+		FTreeSitterParserPool::Get().Release(Parser);
+	}
+
+	FTreeSitterPooledParser(const FTreeSitterPooledParser&) = delete;
+	FTreeSitterPooledParser& operator=(const FTreeSitterPooledParser&) = delete;
+
+	const FTreeSitterParser* operator->() const { return &Parser.Get(); }
+	const FTreeSitterParser& Get() const { return Parser.Get(); }
+
+private:
+	TSharedRef<FTreeSitterParser> Parser;
+};
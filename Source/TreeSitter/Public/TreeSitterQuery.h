@@ -0,0 +1,71 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/StringView.h"
+#include "Internationalization/Regex.h"
+#include "Templates/SharedPointer.h"
+
+class FTreeSitterSource;
+struct TSLanguage;
+struct TSQuery;
+struct TSQueryMatch;
+
+/**
+ * Owning wrapper around a compiled TSQuery.
+ *
+ * A compiled query is immutable and can be shared across threads, only the TSQueryCursor running it must not be.
+ */
+class TREESITTER_API FTreeSitterQuery : public TSharedFromThis<FTreeSitterQuery>
+{
+public:
+	FTreeSitterQuery(const TSLanguage* InLanguage, const FString& InQuerySource);
+	~FTreeSitterQuery();
+
+	/** Whether the query compiled successfully, see GetError() otherwise */
+	bool IsValid() const;
+
+	TSQuery* Get() const;
+	const TSLanguage* GetLanguage() const;
+	const FString& GetError() const;
+
+	/** xxHash64 of the query source, to tell whether results computed with another version of the query are stale */
+	uint64 GetSourceHash() const;
+
+	/** Returns the capture index for the given name (without the leading @), INDEX_NONE if not found */
+	int32 FindCaptureIndex(const FName& InCaptureName) const;
+	FName GetCaptureName(const uint32 InCaptureIndex) const;
+
+	/**
+	 * Evaluates the #eq?, #not-eq?, #match? and #not-match? predicates of the pattern of a match, which tree-sitter
+	 * leaves to the caller. Other predicates and directives (e.g. #set!) are ignored.
+	 */
+	bool MatchesPredicates(const TSQueryMatch& InMatch, const FTreeSitterSource& InSource) const;
+
+	/** Text covered by all the nodes of a capture in a match, empty if the capture is not part of it */
+	static FStringView GetCaptureView(const TSQueryMatch& InMatch, const int32 InCapture, const FTreeSitterSource& InSource);
+
+private:
+	/** Text predicate comparing a capture to a string, a pattern or another capture */
+	struct FPredicate
+	{
+		int32 Capture = INDEX_NONE;
+		int32 OtherCapture = INDEX_NONE;
+		FString Value;
+		TOptional<FRegexPattern> Pattern;
+		bool bNegated = false;
+	};
+
+	void CompilePredicates();
+
+	TSQuery* Query = nullptr;
+	const TSLanguage* Language = nullptr;
+	FString Error;
+	uint64 SourceHash = 0;
+
+	/** Capture names, indexed by capture id */
+	TArray<FName> CaptureNames;
+
+	/** Text predicates of each pattern */
+	TArray<TArray<FPredicate>> PatternPredicates;
+};
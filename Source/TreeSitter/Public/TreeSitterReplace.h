@@ -0,0 +1,72 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FTreeSitterQuery;
+class FTreeSitterSource;
+struct TSNode;
+struct TSTree;
+
+/** Replacement of a UTF-8 byte range of a source */
+struct FTreeSitterTextEdit
+{
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+	FString Replacement;
+};
+
+/**
+ * Structural search and replace: every match of a query is replaced by a template.
+ *
+ * - The replaced range is the node captured as @match when the query has such a capture, the range covering all the
+ *   captures of the match otherwise.
+ * - In the template, `$name` or `${name}` inserts the text of the @name capture (from its first to its last node for a
+ *   quantified capture), and `$$` a dollar sign.
+ * - The #eq?, #not-eq?, #match? and #not-match? predicates are evaluated (see FTreeSitterQuery::MatchesPredicates()).
+ *
+ * Overlapping matches are resolved in favor of the outermost one, nested matches only being replaced by another run
+ * over the result.
+ */
+class TREESITTER_API FTreeSitterReplacer
+{
+public:
+	FTreeSitterReplacer(const TSharedRef<const FTreeSitterQuery>& InQuery, const FString& InTemplate);
+
+	/** Whether the query compiled and the template only references captures of the query, see GetError() otherwise */
+	bool IsValid() const;
+	const FString& GetError() const;
+
+	const TSharedRef<const FTreeSitterQuery>& GetQuery() const { return Query; }
+
+	/** Appends the edits replacing every match under InNode, sorted by start and non-overlapping */
+	void FindEdits(const TSNode& InNode, const FTreeSitterSource& InSource, TArray<FTreeSitterTextEdit>& OutEdits) const;
+
+private:
+	/** Literal text, or the text of a capture */
+	struct FTemplateSegment
+	{
+		FString Text;
+		int32 Capture = INDEX_NONE;
+	};
+
+	void CompileTemplate(const FString& InTemplate);
+
+	TSharedRef<const FTreeSitterQuery> Query;
+	TArray<FTemplateSegment> Segments;
+
+	int32 MatchCapture = INDEX_NONE;
+	FString Error;
+};
+
+namespace UE::TreeSitter
+{
+	/**
+	 * Applies sorted, non-overlapping edits (see FTreeSitterReplacer::FindEdits()) to a source in a single pass.
+	 *
+	 * When given the tree of InSource, also applies each edit to it with ts_tree_edit(), so that it can be handed to
+	 * FTreeSitterParser::Parse() as the old tree for an incremental reparse of the result.
+	 */
+	TREESITTER_API TSharedRef<const FTreeSitterSource> ApplyEdits(const FTreeSitterSource& InSource, TConstArrayView<FTreeSitterTextEdit> InEdits, TSTree* InOutTree = nullptr);
+}
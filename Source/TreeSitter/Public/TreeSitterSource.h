@@ -0,0 +1,55 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/StringView.h"
+#include "Templates/SharedPointer.h"
+
+struct TSInputEdit;
+struct TSNode;
+struct TSPoint;
+
+/**
+ * Immutable, ref-counted source buffer shared by a parsed document and everything reading from it.
+ *
+ * Tree-sitter ranges are UTF-8 byte offsets. The buffer keeps both the UTF-8 encoding handed to the parser and the
+ * original text, so that any node range can be read back as a string view instead of copying the document around.
+ */
+class TREESITTER_API FTreeSitterSource
+{
+public:
+	static TSharedRef<const FTreeSitterSource> Create(FString InText);
+
+	explicit FTreeSitterSource(FString InText);
+
+	const FString& GetText() const;
+
+	/** UTF-8 encoding of the text, as handed to the parser */
+	const ANSICHAR* GetUTF8() const;
+	uint32 GetUTF8Length() const;
+
+	/** Returns a view of the text between two UTF-8 byte offsets. Only valid as long as this buffer is alive. */
+	FStringView GetView(const uint32 InStartByte, const uint32 InEndByte) const;
+	FStringView GetView(const TSNode& InNode) const;
+
+	/** Converts a UTF-8 byte offset into a character index of the text */
+	int32 GetCharIndex(const uint32 InByteOffset) const;
+
+	/** Row / byte column of a byte offset, as tree-sitter expects them */
+	TSPoint GetPoint(const uint32 InByteOffset) const;
+
+	/**
+	 * Computes the single edit turning InPreviousSource into this one (common prefix and suffix are left untouched),
+	 * to be applied on the previous tree with ts_tree_edit() before an incremental reparse.
+	 *
+	 * @return false if both sources are identical
+	 */
+	bool ComputeEdit(const FTreeSitterSource& InPreviousSource, TSInputEdit& OutEdit) const;
+
+private:
+	FString Text;
+	TArray<ANSICHAR> UTF8;
+
+	/** Character index for each byte offset, left empty for pure ASCII text where both are the same */
+	TArray<int32> ByteToCharIndex;
+};
@@ -0,0 +1,19 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+DECLARE_STATS_GROUP(TEXT("TreeSitter"), STATGROUP_TreeSitter, STATCAT_Advanced);
+
+/** Parse, query and markdown rendering timings and counts, shared by every TreeSitter module (`-csvCategories=TreeSitter`) */
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(TREESITTER_API, TreeSitter);
+
+namespace UE::TreeSitter
+{
+	/** Nearest-rank percentile of timing samples, InPercentile in [0, 1]. 0 without samples. */
+	TREESITTER_API double GetPercentile(TArray<double> InSamples, const double InPercentile);
+}
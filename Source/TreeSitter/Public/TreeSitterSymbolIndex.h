@@ -0,0 +1,119 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "TreeSitterTags.h"
+#include <atomic>
+
+class FTreeSitterQuery;
+class FTreeSitterSource;
+enum class ETreeSitterLanguage : uint8;
+struct TSNode;
+
+/** Result of a symbol search: a tag and the file it was found in */
+struct FTreeSitterSymbolLocation
+{
+	FString Path;
+	FTreeSitterTag Tag;
+};
+
+/**
+ * In-memory index of the definitions and references of a set of files, out of their `tags.scm` queries (see
+ * UE::TreeSitter::ExtractTags()), for go-to-symbol without a language server.
+ *
+ * Files are updated independently, whenever their tree changes, and only touch their own records. Names are interned
+ * once and kept in case-insensitive order, so that prefix searches are a binary search.
+ *
+ * Safe to update and search from any thread.
+ */
+class TREESITTER_API FTreeSitterSymbolIndex
+{
+public:
+	/** Replaces the symbols of a file with the tags of its current tree */
+	void UpdateFile(const FString& InPath, const FTreeSitterQuery& InTagsQuery, const TSNode& InRootNode, const FTreeSitterSource& InSource);
+
+	/**
+	 * Parses a file and replaces its symbols, unless its content didn't change since the last update.
+	 *
+	 * @return false if the language has no grammar or tags query
+	 */
+	bool UpdateFile(const FString& InPath, const ETreeSitterLanguage InLanguage, const FTreeSitterSource& InSource);
+
+	void RemoveFile(const FString& InPath);
+
+	void Empty();
+
+	/**
+	 * Symbols whose name starts with InPrefix (ignoring case), definitions first, then by name.
+	 *
+	 * @param InMaxResults Stops searching once reached, <= 0 for no limit
+	 */
+	void FindSymbols(const FStringView InPrefix, TArray<FTreeSitterSymbolLocation>& OutSymbols, const int32 InMaxResults = 100, const bool bInDefinitionsOnly = false) const;
+
+	int32 GetFileCount() const;
+	int32 GetSymbolCount() const;
+
+private:
+	/** FTreeSitterTag, with its name interned */
+	struct FSymbolRecord
+	{
+		int32 NameId = INDEX_NONE;
+		FName Kind;
+		uint32 StartByte = 0;
+		uint32 EndByte = 0;
+		uint32 Row = 0;
+		bool bIsDefinition = false;
+	};
+
+	/** Symbols[Start, Start + Num) of a file sharing a name */
+	struct FNameSymbols
+	{
+		int32 NameId = INDEX_NONE;
+		int32 Start = 0;
+		int32 Num = 0;
+	};
+
+	struct FFileSymbols
+	{
+		FString Path;
+
+		/** Hash of the content the symbols were extracted from, 0 when unknown */
+		uint64 ContentHash = 0;
+
+		/** Grouped by name, in source order within a name */
+		TArray<FSymbolRecord> Symbols;
+
+		/** Distinct names of Symbols, sorted by id */
+		TArray<FNameSymbols> Names;
+	};
+
+	void SetFileSymbols(const FString& InPath, const uint64 InContentHash, const TArray<FTreeSitterTag>& InTags);
+	void RemoveFileSymbols(const int32 InFileId);
+
+	/** Merges names added since the last search into SortedNameIds */
+	void SortPendingNames() const;
+
+	void AddSymbols(const FStringView InPrefix, const bool bInDefinitions, const int32 InMaxResults, TArray<FTreeSitterSymbolLocation>& OutSymbols) const;
+
+	mutable FRWLock Lock;
+
+	TArray<FFileSymbols> Files;
+	TMap<FString, int32> FileIds;
+	TArray<int32> FreeFileIds;
+
+	/** Interned names, never removed so that ids stay stable */
+	TArray<FString> Names;
+	TMap<FString, int32> NameIds;
+
+	/** Files using each name */
+	TArray<TArray<int32>> NameFiles;
+
+	/** Name ids in case-insensitive order, and the ones still to be merged in */
+	mutable TArray<int32> SortedNameIds;
+	mutable TArray<int32> PendingNameIds;
+	mutable std::atomic<bool> bHasPendingNames = false;
+
+	int32 SymbolCount = 0;
+};
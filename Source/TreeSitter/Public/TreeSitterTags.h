@@ -0,0 +1,35 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FTreeSitterQuery;
+class FTreeSitterSource;
+struct TSNode;
+
+/** Symbol definition or reference captured by a `tags.scm` query */
+struct FTreeSitterTag
+{
+	/** Text of the @name capture */
+	FString Name;
+
+	/** Suffix of the @definition.<kind> or @reference.<kind> capture, e.g. "function", "class", "call" */
+	FName Kind;
+
+	bool bIsDefinition = false;
+
+	/** UTF-8 byte range and 0-based row of the @name capture */
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+	uint32 Row = 0;
+};
+
+namespace UE::TreeSitter
+{
+	/**
+	 * Runs a tags query (see ITreeSitterModule::FindQuery(Language, "tags")) over a tree, following the tree-sitter
+	 * tagging conventions: each match has a @name capture, and a @definition.<kind> or @reference.<kind> one.
+	 */
+	TREESITTER_API void ExtractTags(const FTreeSitterQuery& InQuery, const TSNode& InRootNode, const FTreeSitterSource& InSource, TArray<FTreeSitterTag>& OutTags);
+}
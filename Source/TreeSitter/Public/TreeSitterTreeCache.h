@@ -0,0 +1,45 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FTreeSitterFlatTree;
+class FTreeSitterSource;
+enum class ETreeSitterLanguage : uint8;
+
+/**
+ * On-disk cache of parse results, as FTreeSitterFlatTree tables keyed by the xxHash64 of the parsed UTF-8 content.
+ *
+ * Entries are stored in <Directory>/<Language>/<ContentHash>.tstc and memory-mapped back when found. They're ignored
+ * (and overwritten on the next store) when written by another tree-sitter language ABI or grammar revision, so that
+ * updating a grammar library never serves stale trees, or when their node table is malformed.
+ *
+ * Only flat tree consumers benefit from it: queries and incremental edits need a TSTree, that tree-sitter can't
+ * rebuild out of a cached table.
+ */
+class TREESITTER_API FTreeSitterTreeCache
+{
+public:
+	/** Uses Saved/TreeSitter/TreeCache if InDirectory is empty */
+	explicit FTreeSitterTreeCache(const FString& InDirectory = FString());
+
+	/** Key of a content in the cache */
+	static uint64 HashContent(const FTreeSitterSource& InSource);
+
+	/** Loads the cached tree of a content, if any and still valid. Safe to call from any thread. */
+	TSharedPtr<const FTreeSitterFlatTree> Find(const ETreeSitterLanguage InLanguage, const uint64 InContentHash) const;
+
+	/** Writes a tree to the cache, replacing any previous entry atomically. Safe to call from any thread. */
+	bool Store(const ETreeSitterLanguage InLanguage, const uint64 InContentHash, const FTreeSitterFlatTree& InTree) const;
+
+	/** Returns the cached tree of a source, parsing and storing it on a miss. Null if the grammar couldn't be loaded. */
+	TSharedPtr<const FTreeSitterFlatTree> FindOrParse(const ETreeSitterLanguage InLanguage, const FTreeSitterSource& InSource, bool* bOutCacheHit = nullptr) const;
+
+	const FString& GetDirectory() const { return Directory; }
+
+private:
+	FString GetEntryPath(const ETreeSitterLanguage InLanguage, const uint64 InContentHash) const;
+
+	FString Directory;
+};
@@ -1,15 +1,19 @@
 ﻿// Copyright 2024 Mickael Daniel. All Rights Reserved.
 
+using System.IO;
 using UnrealBuildTool;
 
 public class TreeSitter : ModuleRules
 {
 	public TreeSitter(ReadOnlyTargetRules Target) : base(Target)
 	{
+		// Runtime core: parsers, languages, trees and queries only. Slate rendering lives in TreeSitterMarkdown, and the
+		// playground / console commands in TreeSitterEditor, so that game and server targets only load what they parse with.
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
 				"Core",
+				"CoreUObject",
 				"TreeSitterLibrary", 
 			}
 		);
@@ -18,29 +22,11 @@ public class TreeSitter : ModuleRules
 		PrivateDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"CoreUObject",
-				"Engine",
-				"InputCore",
 				"Projects",
-				"Slate",
-				"SlateCore",
 			}
 		);
 
-		// TODO Move to Editor module
-		if (Target.bBuildEditor)
-		{
-			PrivateDependencyModuleNames.AddRange(
-				new string[]
-				{
-					"UnrealEd"
-				}
-			);
-		}
-
-		if (Target.bWithLiveCoding)
-		{
-			PrivateDependencyModuleNames.Add("LiveCoding");
-		}
+		// Queries are read from disk by ITreeSitterModule::FindQuery(), staged so that packaged targets find them too
+		RuntimeDependencies.Add(Path.Combine(PluginDirectory, "Resources", "Queries", "..."), StagedFileType.UFS);
 	}
 }
\ No newline at end of file
@@ -0,0 +1,413 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterBenchmarkCommandlet.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "ITreeSitterModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "TreeSitterCommandletUtils.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterMemory.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::Private
+{
+	struct FBenchmarkSettings
+	{
+		TArray<FString> CorpusDirectories;
+
+		/** Languages to benchmark, all of them when empty */
+		TArray<ETreeSitterLanguage> Languages;
+
+		/** Unmeasured runs before the measured ones, to warm up caches and the parser pool */
+		int32 WarmupCount = 1;
+		int32 RepeatCount = 5;
+
+		/** Length of the scripted edit sequence replayed on each file for incremental reparses */
+		int32 EditCount = 20;
+
+		FString OutputPath;
+	};
+
+	struct FBenchmarkCorpus
+	{
+		ETreeSitterLanguage Language = ETreeSitterLanguage::JavaScript;
+		TArray<TSharedRef<const FTreeSitterSource>> Sources;
+		int64 Bytes = 0;
+	};
+
+	struct FBenchmarkResult
+	{
+		ETreeSitterLanguage Language = ETreeSitterLanguage::JavaScript;
+		int32 FileCount = 0;
+		int64 Bytes = 0;
+
+		/** Median over the measured runs, for the whole corpus */
+		double FullParseSeconds = 0.0;
+
+		int32 IncrementalReparseCount = 0;
+		double IncrementalMedianMs = 0.0;
+		double IncrementalP95Ms = 0.0;
+
+		/** Median over the measured runs, for the whole corpus */
+		double QuerySeconds = 0.0;
+		int64 QueryMatchCount = 0;
+
+		/** Highest memory allocated by tree-sitter while benchmarking this language alone */
+		uint64 PeakAllocatedBytes = 0;
+
+		static double GetMBps(const int64 InBytes, const double InSeconds)
+		{
+			return InSeconds > 0.0 ? static_cast<double>(InBytes) / (1024.0 * 1024.0) / InSeconds : 0.0;
+		}
+	};
+
+	static FBenchmarkSettings ParseSettings(const FString& InParams)
+	{
+		FBenchmarkSettings Settings;
+
+		FString CorpusValue;
+		if (FParse::Value(*InParams, TEXT("Corpus="), CorpusValue, false))
+		{
+			CorpusValue.ParseIntoArray(Settings.CorpusDirectories, TEXT("+"));
+		}
+		else if (const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TreeSitter")))
+		{
+			// Small smoke corpus: the plugin's own descriptor and docs
+			Settings.CorpusDirectories.Add(Plugin->GetBaseDir());
+		}
+
+		Settings.Languages = ParseLanguages(InParams, TEXT("TreeSitterBenchmark"));
+
+		FParse::Value(*InParams, TEXT("Warmup="), Settings.WarmupCount);
+		FParse::Value(*InParams, TEXT("Repeat="), Settings.RepeatCount);
+		FParse::Value(*InParams, TEXT("Edits="), Settings.EditCount);
+		Settings.WarmupCount = FMath::Max(Settings.WarmupCount, 0);
+		Settings.RepeatCount = FMath::Max(Settings.RepeatCount, 1);
+		Settings.EditCount = FMath::Max(Settings.EditCount, 0);
+
+		if (!FParse::Value(*InParams, TEXT("Output="), Settings.OutputPath, false))
+		{
+			Settings.OutputPath = FPaths::ProjectSavedDir() / TEXT("TreeSitter") / FString::Printf(TEXT("Benchmark-%s.json"), *FDateTime::Now().ToString());
+		}
+
+		return Settings;
+	}
+
+	static TArray<FBenchmarkCorpus> LoadCorpora(const FBenchmarkSettings& InSettings)
+	{
+		TMap<ETreeSitterLanguage, FBenchmarkCorpus> Corpora;
+		// Same order from one run to the other, results are compared across runs
+		const TArray<TPair<FString, ETreeSitterLanguage>> Files = FindLanguageFiles(InSettings.CorpusDirectories, [&InSettings](const ETreeSitterLanguage InLanguage)
+		{
+			return InSettings.Languages.IsEmpty() || InSettings.Languages.Contains(InLanguage);
+		});
+
+		for (const TPair<FString, ETreeSitterLanguage>& File : Files)
+		{
+			FString Text;
+			if (!FFileHelper::LoadFileToString(Text, *File.Key))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("TreeSitterBenchmark: failed to read %s"), *File.Key);
+				continue;
+			}
+
+			FBenchmarkCorpus& Corpus = Corpora.FindOrAdd(File.Value);
+			Corpus.Language = File.Value;
+
+			const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(MoveTemp(Text));
+			Corpus.Bytes += Source->GetUTF8Length();
+			Corpus.Sources.Add(Source);
+		}
+
+		TArray<FBenchmarkCorpus> Result;
+		Corpora.GenerateValueArray(Result);
+		Result.Sort([](const FBenchmarkCorpus& A, const FBenchmarkCorpus& B)
+		{
+			return A.Language < B.Language;
+		});
+		return Result;
+	}
+
+	static void BenchmarkFullParse(const FBenchmarkSettings& InSettings, const FBenchmarkCorpus& InCorpus, const FTreeSitterParser& InParser, FBenchmarkResult& OutResult)
+	{
+		TArray<double> Durations;
+		TArray<TSTree*> Trees;
+		Trees.Reserve(InCorpus.Sources.Num());
+
+		for (int32 Run = 0; Run < InSettings.WarmupCount + InSettings.RepeatCount; ++Run)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			for (const TSharedRef<const FTreeSitterSource>& Source : InCorpus.Sources)
+			{
+				Trees.Add(InParser.Parse(Source->GetUTF8(), Source->GetUTF8Length()));
+			}
+
+			const double Duration = FPlatformTime::Seconds() - StartTime;
+			if (Run >= InSettings.WarmupCount)
+			{
+				Durations.Add(Duration);
+			}
+
+			// Freeing trees is left out of the measure
+			for (TSTree* Tree : Trees)
+			{
+				ts_tree_delete(Tree);
+			}
+
+			Trees.Reset();
+		}
+
+		OutResult.FullParseSeconds = GetPercentile(Durations, 0.5);
+	}
+
+	static void BenchmarkIncrementalParse(const FBenchmarkSettings& InSettings, const FBenchmarkCorpus& InCorpus, const FTreeSitterParser& InParser, FBenchmarkResult& OutResult)
+	{
+		TArray<double> Latencies;
+
+		for (int32 Run = 0; Run < InSettings.WarmupCount + InSettings.RepeatCount; ++Run)
+		{
+			const bool bMeasured = Run >= InSettings.WarmupCount;
+			for (const TSharedRef<const FTreeSitterSource>& Source : InCorpus.Sources)
+			{
+				TSTree* Tree = InParser.Parse(Source->GetUTF8(), Source->GetUTF8Length());
+				TSharedRef<const FTreeSitterSource> CurrentSource = Source;
+
+				// Scripted sequence: a space typed at positions spread over the document, removed again by the next edit
+				const int32 PairCount = FMath::DivideAndRoundUp(InSettings.EditCount, 2);
+				for (int32 EditIndex = 0; EditIndex < InSettings.EditCount && Tree; ++EditIndex)
+				{
+					FString Text = CurrentSource->GetText();
+					const int32 Position = static_cast<int32>(static_cast<int64>(EditIndex / 2 + 1) * Source->GetText().Len() / (PairCount + 1));
+					if (EditIndex % 2 == 0)
+					{
+						Text.InsertAt(Position, TEXT(' '));
+					}
+					else
+					{
+						Text.RemoveAt(Position, 1);
+					}
+
+					const TSharedRef<const FTreeSitterSource> EditedSource = FTreeSitterSource::Create(MoveTemp(Text));
+
+					TSInputEdit Edit;
+					if (!EditedSource->ComputeEdit(*CurrentSource, Edit))
+					{
+						continue;
+					}
+
+					ts_tree_edit(Tree, &Edit);
+
+					const double StartTime = FPlatformTime::Seconds();
+					TSTree* NewTree = InParser.Parse(EditedSource->GetUTF8(), EditedSource->GetUTF8Length(), Tree);
+					const double Duration = FPlatformTime::Seconds() - StartTime;
+
+					if (bMeasured)
+					{
+						Latencies.Add(Duration * 1000.0);
+					}
+
+					ts_tree_delete(Tree);
+					Tree = NewTree;
+					CurrentSource = EditedSource;
+				}
+
+				if (Tree)
+				{
+					ts_tree_delete(Tree);
+				}
+			}
+		}
+
+		OutResult.IncrementalReparseCount = Latencies.Num();
+		OutResult.IncrementalMedianMs = GetPercentile(Latencies, 0.5);
+		OutResult.IncrementalP95Ms = GetPercentile(Latencies, 0.95);
+	}
+
+	static void BenchmarkQuery(const FBenchmarkSettings& InSettings, const FBenchmarkCorpus& InCorpus, const FTreeSitterParser& InParser, FBenchmarkResult& OutResult)
+	{
+		// Captures every named node, so that the cost is driven by the tree size and not by a particular grammar
+		const FTreeSitterQuery Query(InParser.GetLanguage(), TEXT("(_) @node"));
+		if (!Query.IsValid())
+		{
+			return;
+		}
+
+		TArray<TSTree*> Trees;
+		for (const TSharedRef<const FTreeSitterSource>& Source : InCorpus.Sources)
+		{
+			if (TSTree* Tree = InParser.Parse(Source->GetUTF8(), Source->GetUTF8Length()))
+			{
+				Trees.Add(Tree);
+			}
+		}
+
+		TArray<double> Durations;
+		TSQueryCursor* Cursor = ts_query_cursor_new();
+
+		for (int32 Run = 0; Run < InSettings.WarmupCount + InSettings.RepeatCount; ++Run)
+		{
+			int64 MatchCount = 0;
+
+			const double StartTime = FPlatformTime::Seconds();
+			for (TSTree* Tree : Trees)
+			{
+				ts_query_cursor_exec(Cursor, Query.Get(), ts_tree_root_node(Tree));
+
+				TSQueryMatch Match;
+				while (ts_query_cursor_next_match(Cursor, &Match))
+				{
+					++MatchCount;
+				}
+			}
+
+			const double Duration = FPlatformTime::Seconds() - StartTime;
+			if (Run >= InSettings.WarmupCount)
+			{
+				Durations.Add(Duration);
+			}
+
+			OutResult.QueryMatchCount = MatchCount;
+		}
+
+		ts_query_cursor_delete(Cursor);
+		for (TSTree* Tree : Trees)
+		{
+			ts_tree_delete(Tree);
+		}
+
+		OutResult.QuerySeconds = GetPercentile(Durations, 0.5);
+	}
+
+	static FString ResultsToCSV(const TArray<FBenchmarkResult>& InResults)
+	{
+		FString Output = TEXT("Language,Files,Bytes,FullParseMs,FullParseMBps,IncrementalReparses,IncrementalMedianMs,IncrementalP95Ms,QueryMs,QueryMBps,QueryMatches,PeakAllocatedMB\n");
+		for (const FBenchmarkResult& Result : InResults)
+		{
+			Output += FString::Printf(
+				TEXT("%s,%d,%lld,%.3f,%.3f,%d,%.4f,%.4f,%.3f,%.3f,%lld,%.1f\n"),
+				GetLanguageName(Result.Language),
+				Result.FileCount,
+				Result.Bytes,
+				Result.FullParseSeconds * 1000.0,
+				FBenchmarkResult::GetMBps(Result.Bytes, Result.FullParseSeconds),
+				Result.IncrementalReparseCount,
+				Result.IncrementalMedianMs,
+				Result.IncrementalP95Ms,
+				Result.QuerySeconds * 1000.0,
+				FBenchmarkResult::GetMBps(Result.Bytes, Result.QuerySeconds),
+				Result.QueryMatchCount,
+				static_cast<double>(Result.PeakAllocatedBytes) / (1024.0 * 1024.0)
+			);
+		}
+
+		return Output;
+	}
+
+	static FString ResultsToJson(const FBenchmarkSettings& InSettings, const TArray<FBenchmarkResult>& InResults)
+	{
+		const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("Warmup"), InSettings.WarmupCount);
+		Root->SetNumberField(TEXT("Repeat"), InSettings.RepeatCount);
+		Root->SetNumberField(TEXT("Edits"), InSettings.EditCount);
+
+		TArray<TSharedPtr<FJsonValue>> ResultValues;
+		for (const FBenchmarkResult& Result : InResults)
+		{
+			const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+			Object->SetStringField(TEXT("Language"), GetLanguageName(Result.Language));
+			Object->SetNumberField(TEXT("Files"), Result.FileCount);
+			Object->SetNumberField(TEXT("Bytes"), static_cast<double>(Result.Bytes));
+			Object->SetNumberField(TEXT("FullParseMs"), Result.FullParseSeconds * 1000.0);
+			Object->SetNumberField(TEXT("FullParseMBps"), FBenchmarkResult::GetMBps(Result.Bytes, Result.FullParseSeconds));
+			Object->SetNumberField(TEXT("IncrementalReparses"), Result.IncrementalReparseCount);
+			Object->SetNumberField(TEXT("IncrementalMedianMs"), Result.IncrementalMedianMs);
+			Object->SetNumberField(TEXT("IncrementalP95Ms"), Result.IncrementalP95Ms);
+			Object->SetNumberField(TEXT("QueryMs"), Result.QuerySeconds * 1000.0);
+			Object->SetNumberField(TEXT("QueryMBps"), FBenchmarkResult::GetMBps(Result.Bytes, Result.QuerySeconds));
+			Object->SetNumberField(TEXT("QueryMatches"), static_cast<double>(Result.QueryMatchCount));
+			Object->SetNumberField(TEXT("PeakAllocatedMB"), static_cast<double>(Result.PeakAllocatedBytes) / (1024.0 * 1024.0));
+			ResultValues.Add(MakeShared<FJsonValueObject>(Object));
+		}
+
+		Root->SetArrayField(TEXT("Results"), ResultValues);
+
+		FString Output;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Root, Writer);
+		return Output;
+	}
+}
+
+UTreeSitterBenchmarkCommandlet::UTreeSitterBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTreeSitterBenchmarkCommandlet::Main(const FString& Params)
+{
+	using namespace UE::TreeSitter::Private;
+
+	const FBenchmarkSettings Settings = ParseSettings(Params);
+	const TArray<FBenchmarkCorpus> Corpora = LoadCorpora(Settings);
+	if (Corpora.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterBenchmark: no file to parse in %s"), *FString::Join(Settings.CorpusDirectories, TEXT(", ")));
+		return 1;
+	}
+
+	TArray<FBenchmarkResult> Results;
+	for (const FBenchmarkCorpus& Corpus : Corpora)
+	{
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(Corpus.Language);
+		if (!LanguageParser)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TreeSitterBenchmark: skipping %s, grammar not available"), GetLanguageName(Corpus.Language));
+			continue;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("TreeSitterBenchmark: %s, %d files (%lld bytes)"), GetLanguageName(Corpus.Language), Corpus.Sources.Num(), Corpus.Bytes);
+
+		FBenchmarkResult& Result = Results.AddDefaulted_GetRef();
+		Result.Language = Corpus.Language;
+		Result.FileCount = Corpus.Sources.Num();
+		Result.Bytes = Corpus.Bytes;
+
+		// Trees of the previous language are freed by now, the peak only accounts for this one
+		UE::TreeSitter::ResetPeakAllocatedBytes();
+
+		const FTreeSitterPooledParser Parser(LanguageParser());
+		BenchmarkFullParse(Settings, Corpus, Parser.Get(), Result);
+		BenchmarkIncrementalParse(Settings, Corpus, Parser.Get(), Result);
+		BenchmarkQuery(Settings, Corpus, Parser.Get(), Result);
+
+		Result.PeakAllocatedBytes = UE::TreeSitter::GetPeakAllocatedBytes();
+	}
+
+	const FString CSV = ResultsToCSV(Results);
+	UE_LOG(LogTemp, Display, TEXT("TreeSitterBenchmark results:\n%s"), *CSV);
+
+	const bool bWriteCSV = FPaths::GetExtension(Settings.OutputPath).Equals(TEXT("csv"), ESearchCase::IgnoreCase);
+	const FString Output = bWriteCSV ? CSV : ResultsToJson(Settings, Results);
+	if (!FFileHelper::SaveStringToFile(Output, *Settings.OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterBenchmark: failed to write %s"), *Settings.OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("TreeSitterBenchmark: results written to %s"), *Settings.OutputPath);
+	return 0;
+}
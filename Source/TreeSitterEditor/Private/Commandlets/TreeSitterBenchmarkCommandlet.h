@@ -0,0 +1,32 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "TreeSitterBenchmarkCommandlet.generated.h"
+
+/**
+ * Headless parse throughput benchmark, to track regressions when grammars or the tree-sitter runtime are upgraded.
+ *
+ * Files of the corpus directories are bucketed per language (by extension), then for each language measures:
+ *
+ * - Full parse throughput (MB/s) of the whole corpus
+ * - Incremental reparse latency (median / p95) over a scripted sequence of edits
+ * - Query throughput (MB/s, matches) of a query capturing every named node
+ * - Peak memory allocated by tree-sitter while benchmarking the language (parsers, trees, queries and cursors)
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=TreeSitterBenchmark [-Corpus=<Dir>+<Dir>] [-Language=Json] [-Warmup=1]
+ *        [-Repeat=5] [-Edits=20] [-Output=<Path>.json|.csv]
+ */
+UCLASS()
+class UTreeSitterBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTreeSitterBenchmarkCommandlet();
+
+	//~ Begin UCommandlet
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet
+};
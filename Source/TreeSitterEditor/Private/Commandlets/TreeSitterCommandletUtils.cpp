@@ -0,0 +1,53 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterCommandletUtils.h"
+
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "TreeSitterLanguages.h"
+
+namespace UE::TreeSitter::Private
+{
+	TArray<FString> ParseRoots(const FString& InParams)
+	{
+		TArray<FString> Roots;
+
+		FString RootsValue;
+		if (FParse::Value(*InParams, TEXT("Roots="), RootsValue, false))
+		{
+			RootsValue.ParseIntoArray(Roots, TEXT("+"));
+		}
+		else
+		{
+			Roots = { FPaths::GameSourceDir(), FPaths::ProjectConfigDir(), FPaths::ProjectContentDir() };
+		}
+
+		return Roots;
+	}
+
+	TArray<ETreeSitterLanguage> ParseLanguages(const FString& InParams, const TCHAR* InCommandletName)
+	{
+		TArray<ETreeSitterLanguage> Languages;
+
+		FString LanguageValue;
+		if (FParse::Value(*InParams, TEXT("Language="), LanguageValue, false))
+		{
+			TArray<FString> LanguageNames;
+			LanguageValue.ParseIntoArray(LanguageNames, TEXT("+"));
+			for (const FString& LanguageName : LanguageNames)
+			{
+				ETreeSitterLanguage Language;
+				if (FindLanguageByName(LanguageName, Language))
+				{
+					Languages.AddUnique(Language);
+				}
+				else
+				{
+					UE_LOG(LogTemp, Warning, TEXT("%s: unknown language '%s'"), InCommandletName, *LanguageName);
+				}
+			}
+		}
+
+		return Languages;
+	}
+}
@@ -0,0 +1,17 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class ETreeSitterLanguage : uint8;
+
+/** Command line parsing shared by the TreeSitter commandlets */
+namespace UE::TreeSitter::Private
+{
+	/** -Roots=A+B, the project Source, Config and Content directories when not given */
+	TArray<FString> ParseRoots(const FString& InParams);
+
+	/** -Language=A+B, empty when not given. Unknown names are skipped with a warning prefixed by InCommandletName. */
+	TArray<ETreeSitterLanguage> ParseLanguages(const FString& InParams, const TCHAR* InCommandletName);
+}
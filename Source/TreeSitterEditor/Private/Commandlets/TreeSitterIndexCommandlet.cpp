@@ -0,0 +1,438 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterIndexCommandlet.h"
+
+#include "Algo/AnyOf.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Hash/xxhash.h"
+#include "HAL/PlatformTime.h"
+#include "ITreeSitterModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "TreeSitterCommandletUtils.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterNode.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterTags.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::Private
+{
+	/** Bumped whenever the index layout or what gets extracted changes, older indices are rebuilt from scratch */
+	static constexpr int32 IndexVersion = 2;
+
+	struct FIndexSettings
+	{
+		TArray<FString> Roots;
+
+		/** Languages to index, all of them when empty */
+		TArray<ETreeSitterLanguage> Languages;
+
+		FString IndexPath;
+
+		/** Ignores the previous entries of the files in Roots and Languages, reparsing them */
+		bool bForce = false;
+	};
+
+	struct FIndexEntry
+	{
+		/** Relative to the project directory */
+		FString Path;
+		ETreeSitterLanguage Language = ETreeSitterLanguage::Json;
+		/** Empty when the file couldn't be parsed, so that it's never reused as is */
+		FString Hash;
+		int64 Bytes = 0;
+		int32 ErrorCount = 0;
+		TArray<FTreeSitterTag> Tags;
+	};
+
+	/** What the entries of a language were extracted with, they're reparsed when any of it changes */
+	struct FIndexLanguage
+	{
+		FString GrammarRevision;
+
+		/** Of the tags query source, empty without one */
+		FString TagsHash;
+
+		bool operator==(const FIndexLanguage& InOther) const
+		{
+			return GrammarRevision == InOther.GrammarRevision && TagsHash == InOther.TagsHash;
+		}
+	};
+
+	static FIndexSettings ParseIndexSettings(const FString& InParams)
+	{
+		FIndexSettings Settings;
+
+		Settings.Roots = ParseRoots(InParams);
+		Settings.Languages = ParseLanguages(InParams, TEXT("TreeSitterIndex"));
+
+		if (!FParse::Value(*InParams, TEXT("Index="), Settings.IndexPath, false))
+		{
+			Settings.IndexPath = FPaths::ProjectSavedDir() / TEXT("TreeSitter") / TEXT("Index.json");
+		}
+
+		Settings.bForce = FParse::Param(*InParams, TEXT("Force"));
+		return Settings;
+	}
+
+	static TArray<FIndexEntry> FindIndexFiles(const FIndexSettings& InSettings)
+	{
+		const TArray<TPair<FString, ETreeSitterLanguage>> Files = FindLanguageFiles(InSettings.Roots, [&InSettings](const ETreeSitterLanguage InLanguage)
+		{
+			return InSettings.Languages.IsEmpty() || InSettings.Languages.Contains(InLanguage);
+		});
+
+		// Sorted by path, so that the index diffs nicely from one run to the other
+		TArray<FIndexEntry> Entries;
+		Entries.Reserve(Files.Num());
+		for (const TPair<FString, ETreeSitterLanguage>& File : Files)
+		{
+			FIndexEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Path = File.Key;
+			FPaths::MakePathRelativeTo(Entry.Path, *FPaths::ProjectDir());
+			Entry.Language = File.Value;
+		}
+
+		return Entries;
+	}
+
+	/** Whether a file is covered by the roots and languages of this run, other entries are kept as they were */
+	static bool IsInIndexScope(const FIndexSettings& InSettings, const FIndexEntry& InEntry)
+	{
+		if (!InSettings.Languages.IsEmpty() && !InSettings.Languages.Contains(InEntry.Language))
+		{
+			return false;
+		}
+
+		const FString FullPath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir() / InEntry.Path);
+		return Algo::AnyOf(InSettings.Roots, [&FullPath](const FString& InRoot)
+		{
+			return FPaths::IsUnderDirectory(FullPath, FPaths::ConvertRelativePathToFull(InRoot));
+		});
+	}
+
+	/**
+	 * Entries of the previous index, but the ones of languages whose grammar or tags query changed.
+	 *
+	 * @param OutLanguages What the languages of the previous index were extracted with
+	 */
+	static TMap<FString, FIndexEntry> LoadIndex(const FString& InIndexPath, const TMap<ETreeSitterLanguage, FIndexLanguage>& InLanguages, TMap<ETreeSitterLanguage, FIndexLanguage>& OutLanguages)
+	{
+		TMap<FString, FIndexEntry> Entries;
+
+		FString Json;
+		if (!FFileHelper::LoadFileToString(Json, *InIndexPath))
+		{
+			return Entries;
+		}
+
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid() || Root->GetIntegerField(TEXT("Version")) != IndexVersion)
+		{
+			UE_LOG(LogTemp, Display, TEXT("TreeSitterIndex: %s is outdated, rebuilding it"), *InIndexPath);
+			return Entries;
+		}
+
+		const TSharedPtr<FJsonObject>* LanguagesObject = nullptr;
+		if (Root->TryGetObjectField(TEXT("Languages"), LanguagesObject))
+		{
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& LanguageValue : (*LanguagesObject)->Values)
+			{
+				ETreeSitterLanguage Language;
+				const TSharedPtr<FJsonObject> LanguageObject = LanguageValue.Value->AsObject();
+				if (LanguageObject.IsValid() && FindLanguageByName(LanguageValue.Key, Language))
+				{
+					OutLanguages.Add(Language, { LanguageObject->GetStringField(TEXT("Grammar")), LanguageObject->GetStringField(TEXT("Tags")) });
+				}
+			}
+		}
+
+		// Languages whose grammar or tags query changed since the index was written, or that it didn't have yet
+		TSet<ETreeSitterLanguage> OutdatedLanguages;
+		for (const TPair<ETreeSitterLanguage, FIndexLanguage>& Language : InLanguages)
+		{
+			const FIndexLanguage* IndexedLanguage = OutLanguages.Find(Language.Key);
+			if (!IndexedLanguage)
+			{
+				OutdatedLanguages.Add(Language.Key);
+			}
+			else if (!(*IndexedLanguage == Language.Value))
+			{
+				UE_LOG(LogTemp, Display, TEXT("TreeSitterIndex: %s grammar or tags query changed, reindexing its files"), GetLanguageName(Language.Key));
+				OutdatedLanguages.Add(Language.Key);
+			}
+		}
+
+		for (const TSharedPtr<FJsonValue>& FileValue : Root->GetArrayField(TEXT("Files")))
+		{
+			const TSharedPtr<FJsonObject> FileObject = FileValue->AsObject();
+
+			FIndexEntry Entry;
+			if (!FileObject.IsValid() || !FindLanguageByName(FileObject->GetStringField(TEXT("Language")), Entry.Language) || OutdatedLanguages.Contains(Entry.Language))
+			{
+				continue;
+			}
+
+			Entry.Path = FileObject->GetStringField(TEXT("Path"));
+			Entry.Hash = FileObject->GetStringField(TEXT("Hash"));
+			Entry.Bytes = static_cast<int64>(FileObject->GetNumberField(TEXT("Bytes")));
+			Entry.ErrorCount = FileObject->GetIntegerField(TEXT("Errors"));
+
+			for (const TSharedPtr<FJsonValue>& TagValue : FileObject->GetArrayField(TEXT("Tags")))
+			{
+				const TSharedPtr<FJsonObject> TagObject = TagValue->AsObject();
+				if (!TagObject.IsValid())
+				{
+					continue;
+				}
+
+				FTreeSitterTag& Tag = Entry.Tags.AddDefaulted_GetRef();
+				Tag.Name = TagObject->GetStringField(TEXT("Name"));
+				Tag.Kind = FName(TagObject->GetStringField(TEXT("Kind")));
+				Tag.bIsDefinition = TagObject->GetBoolField(TEXT("Definition"));
+				Tag.Row = TagObject->GetIntegerField(TEXT("Row"));
+				Tag.StartByte = TagObject->GetIntegerField(TEXT("Start"));
+				Tag.EndByte = TagObject->GetIntegerField(TEXT("End"));
+			}
+
+			Entries.Add(Entry.Path, MoveTemp(Entry));
+		}
+
+		return Entries;
+	}
+
+	static bool SaveIndex(const FString& InIndexPath, const TMap<ETreeSitterLanguage, FIndexLanguage>& InLanguages, const TArray<FIndexEntry>& InEntries)
+	{
+		const TSharedRef<FJsonObject> LanguagesObject = MakeShared<FJsonObject>();
+		for (const TPair<ETreeSitterLanguage, FIndexLanguage>& Language : InLanguages)
+		{
+			const TSharedRef<FJsonObject> LanguageObject = MakeShared<FJsonObject>();
+			LanguageObject->SetStringField(TEXT("Grammar"), Language.Value.GrammarRevision);
+			LanguageObject->SetStringField(TEXT("Tags"), Language.Value.TagsHash);
+			LanguagesObject->SetObjectField(GetLanguageName(Language.Key), LanguageObject);
+		}
+
+		TArray<TSharedPtr<FJsonValue>> FileValues;
+		FileValues.Reserve(InEntries.Num());
+
+		for (const FIndexEntry& Entry : InEntries)
+		{
+			const TSharedRef<FJsonObject> FileObject = MakeShared<FJsonObject>();
+			FileObject->SetStringField(TEXT("Path"), Entry.Path);
+			FileObject->SetStringField(TEXT("Language"), GetLanguageName(Entry.Language));
+			FileObject->SetStringField(TEXT("Hash"), Entry.Hash);
+			FileObject->SetNumberField(TEXT("Bytes"), static_cast<double>(Entry.Bytes));
+			FileObject->SetNumberField(TEXT("Errors"), Entry.ErrorCount);
+
+			TArray<TSharedPtr<FJsonValue>> TagValues;
+			TagValues.Reserve(Entry.Tags.Num());
+			for (const FTreeSitterTag& Tag : Entry.Tags)
+			{
+				const TSharedRef<FJsonObject> TagObject = MakeShared<FJsonObject>();
+				TagObject->SetStringField(TEXT("Name"), Tag.Name);
+				TagObject->SetStringField(TEXT("Kind"), Tag.Kind.ToString());
+				TagObject->SetBoolField(TEXT("Definition"), Tag.bIsDefinition);
+				TagObject->SetNumberField(TEXT("Row"), Tag.Row);
+				TagObject->SetNumberField(TEXT("Start"), Tag.StartByte);
+				TagObject->SetNumberField(TEXT("End"), Tag.EndByte);
+				TagValues.Add(MakeShared<FJsonValueObject>(TagObject));
+			}
+			FileObject->SetArrayField(TEXT("Tags"), TagValues);
+
+			FileValues.Add(MakeShared<FJsonValueObject>(FileObject));
+		}
+
+		const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetNumberField(TEXT("Version"), IndexVersion);
+		Root->SetObjectField(TEXT("Languages"), LanguagesObject);
+		Root->SetArrayField(TEXT("Files"), FileValues);
+
+		FString Output;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		return FJsonSerializer::Serialize(Root, Writer) && FFileHelper::SaveStringToFile(Output, *InIndexPath);
+	}
+
+	/**
+	 * Parses a file whose content changed, extracting error count and tags
+	 *
+	 * @return false if the parser gave up on the file
+	 */
+	static bool IndexFile(const TArray<uint8>& InContent, const TSLanguage* InLanguage, const FTreeSitterQuery* InTagsQuery, FIndexEntry& OutEntry)
+	{
+		FString Text;
+		FFileHelper::BufferToString(Text, InContent.GetData(), InContent.Num());
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(MoveTemp(Text));
+
+		const FTreeSitterPooledParser Parser(InLanguage);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		if (!Tree)
+		{
+			return false;
+		}
+
+		const TSNode Root = ts_tree_root_node(Tree);
+		OutEntry.ErrorCount = CountSyntaxErrors(Root);
+
+		if (InTagsQuery)
+		{
+			ExtractTags(*InTagsQuery, Root, *Source, OutEntry.Tags);
+		}
+
+		ts_tree_delete(Tree);
+		return true;
+	}
+}
+
+UTreeSitterIndexCommandlet::UTreeSitterIndexCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTreeSitterIndexCommandlet::Main(const FString& Params)
+{
+	using namespace UE::TreeSitter::Private;
+
+	const FIndexSettings Settings = ParseIndexSettings(Params);
+
+	TArray<FIndexEntry> Entries = FindIndexFiles(Settings);
+	if (Entries.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterIndex: no file to index in %s"), *FString::Join(Settings.Roots, TEXT(", ")));
+		return 1;
+	}
+
+	// Grammars and queries are loaded up front on the game thread, workers only borrow parsers and run queries
+	TMap<ETreeSitterLanguage, const TSLanguage*> Languages;
+	TMap<ETreeSitterLanguage, TSharedPtr<const FTreeSitterQuery>> TagsQueries;
+	TMap<ETreeSitterLanguage, FIndexLanguage> IndexLanguages;
+	for (const FIndexEntry& Entry : Entries)
+	{
+		if (!Languages.Contains(Entry.Language))
+		{
+			ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(Entry.Language);
+			Languages.Add(Entry.Language, LanguageParser ? LanguageParser() : nullptr);
+			const TSharedPtr<const FTreeSitterQuery>& TagsQuery = TagsQueries.Add(Entry.Language, ITreeSitterModule::Get().FindQuery(Entry.Language, TEXT("tags")));
+
+			FIndexLanguage& IndexLanguage = IndexLanguages.Add(Entry.Language);
+			IndexLanguage.GrammarRevision = ITreeSitterModule::Get().GetGrammarRevision(Entry.Language);
+			IndexLanguage.TagsHash = TagsQuery.IsValid() ? FString::Printf(TEXT("%016llx"), TagsQuery->GetSourceHash()) : FString();
+		}
+	}
+
+	TMap<ETreeSitterLanguage, FIndexLanguage> PreviousLanguages;
+	TMap<FString, FIndexEntry> PreviousEntries = LoadIndex(Settings.IndexPath, IndexLanguages, PreviousLanguages);
+
+	TArray<uint8> bReused;
+	bReused.SetNumZeroed(Entries.Num());
+	TArray<uint8> bFailed;
+	bFailed.SetNumZeroed(Entries.Num());
+
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(Entries.Num(), [&Settings, &Entries, &PreviousEntries, &Languages, &TagsQueries, &bReused, &bFailed](const int32 Index)
+	{
+		FIndexEntry& Entry = Entries[Index];
+
+		TArray<uint8> Content;
+		const TSLanguage* Language = Languages.FindRef(Entry.Language);
+		if (!Language || !FFileHelper::LoadFileToArray(Content, *(FPaths::ProjectDir() / Entry.Path)))
+		{
+			bFailed[Index] = true;
+			return;
+		}
+
+		Entry.Bytes = Content.Num();
+		Entry.Hash = FString::Printf(TEXT("%016llx"), FXxHash64::HashBuffer(Content.GetData(), Content.Num()).Hash);
+
+		if (const FIndexEntry* PreviousEntry = Settings.bForce ? nullptr : PreviousEntries.Find(Entry.Path))
+		{
+			if (PreviousEntry->Hash == Entry.Hash && PreviousEntry->Language == Entry.Language)
+			{
+				Entry = *PreviousEntry;
+				bReused[Index] = true;
+				return;
+			}
+		}
+
+		if (!IndexFile(Content, Language, TagsQueries.FindRef(Entry.Language).Get(), Entry))
+		{
+			Entry.Hash.Reset();
+		}
+	}, EParallelForFlags::Unbalanced);
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+
+	int32 ReusedCount = 0;
+	int32 UnparsedCount = 0;
+	int32 ErrorFileCount = 0;
+	int32 TagCount = 0;
+	TArray<FIndexEntry> IndexedEntries;
+	IndexedEntries.Reserve(Entries.Num());
+	for (int32 Index = 0; Index < Entries.Num(); ++Index)
+	{
+		if (bFailed[Index])
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TreeSitterIndex: failed to read %s, or its grammar is not available"), *Entries[Index].Path);
+			continue;
+		}
+
+		if (Entries[Index].Hash.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TreeSitterIndex: failed to parse %s, it will be parsed again on the next run"), *Entries[Index].Path);
+			++UnparsedCount;
+		}
+
+		ReusedCount += bReused[Index];
+		ErrorFileCount += Entries[Index].ErrorCount > 0 ? 1 : 0;
+		TagCount += Entries[Index].Tags.Num();
+		IndexedEntries.Add(MoveTemp(Entries[Index]));
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("TreeSitterIndex: %d files in %.2f s, %d parsed, %d unchanged, %d failed to parse, %d with syntax errors, %d tags"),
+		IndexedEntries.Num(),
+		Duration,
+		IndexedEntries.Num() - ReusedCount - UnparsedCount,
+		ReusedCount,
+		UnparsedCount,
+		ErrorFileCount,
+		TagCount
+	);
+
+	// Runs restricted to some roots or languages leave the entries of the other files as they were. Entries in scope
+	// that weren't found again are of deleted files.
+	const int32 ScopedEntryCount = IndexedEntries.Num();
+	for (TPair<FString, FIndexEntry>& PreviousEntry : PreviousEntries)
+	{
+		if (!IsInIndexScope(Settings, PreviousEntry.Value))
+		{
+			IndexedEntries.Add(MoveTemp(PreviousEntry.Value));
+		}
+	}
+
+	if (IndexedEntries.Num() > ScopedEntryCount)
+	{
+		UE_LOG(LogTemp, Display, TEXT("TreeSitterIndex: %d entries of other roots or languages kept"), IndexedEntries.Num() - ScopedEntryCount);
+		IndexedEntries.Sort([](const FIndexEntry& InA, const FIndexEntry& InB) { return InA.Path < InB.Path; });
+	}
+
+	// Languages of the kept entries keep what they were extracted with
+	TMap<ETreeSitterLanguage, FIndexLanguage> SavedLanguages = MoveTemp(PreviousLanguages);
+	SavedLanguages.Append(IndexLanguages);
+
+	if (!SaveIndex(Settings.IndexPath, SavedLanguages, IndexedEntries))
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterIndex: failed to write %s"), *Settings.IndexPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("TreeSitterIndex: index written to %s"), *Settings.IndexPath);
+	return 0;
+}
@@ -0,0 +1,31 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "TreeSitterIndexCommandlet.generated.h"
+
+/**
+ * Parses every file of a project with a known grammar, across all cores, and writes a persistent index of per-file
+ * content hashes, syntax error counts and symbol tags (see Resources/Queries/<Language>/tags.scm).
+ *
+ * Re-runs read the previous index back and only reparse files whose content hash changed. Runs restricted to some
+ * roots or languages only update the entries of those, the others are kept as they were.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=TreeSitterIndex [-Roots=<Dir>+<Dir>] [-Language=Cpp+Json]
+ *        [-Index=<Path>.json] [-Force]
+ *
+ * Roots default to the project Source, Config and Content directories, and the index to Saved/TreeSitter/Index.json.
+ */
+UCLASS()
+class UTreeSitterIndexCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTreeSitterIndexCommandlet();
+
+	//~ Begin UCommandlet
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet
+};
@@ -0,0 +1,247 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterLintCommandlet.h"
+
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "ITreeSitterModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Serialization/JsonSerializer.h"
+#include "TreeSitterCommandletUtils.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterLint.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::Private
+{
+	struct FLintSettings
+	{
+		TArray<FString> Roots;
+
+		/** Languages to lint, all of those with rules when empty */
+		TArray<ETreeSitterLanguage> Languages;
+
+		/** Rules replacing the bundled ones of the single language to lint */
+		FString RulesPath;
+	};
+
+	struct FLintEntry
+	{
+		FString Path;
+		ETreeSitterLanguage Language = ETreeSitterLanguage::Json;
+		TArray<FTreeSitterLintDiagnostic> Diagnostics;
+		bool bFailed = false;
+	};
+
+	static FLintSettings ParseLintSettings(const FString& InParams)
+	{
+		FLintSettings Settings;
+
+		Settings.Roots = ParseRoots(InParams);
+		Settings.Languages = ParseLanguages(InParams, TEXT("TreeSitterLint"));
+		FParse::Value(*InParams, TEXT("Rules="), Settings.RulesPath, false);
+		return Settings;
+	}
+
+	static bool LoadLintRules(const FString& InRulesPath, TArray<FTreeSitterLintRule>& OutRules)
+	{
+		FString Json;
+		if (!FFileHelper::LoadFileToString(Json, *InRulesPath))
+		{
+			return false;
+		}
+
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Root) || !Root.IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("TreeSitterLint: %s is not valid JSON"), *InRulesPath);
+			return false;
+		}
+
+		for (const TSharedPtr<FJsonValue>& RuleValue : Root->GetArrayField(TEXT("Rules")))
+		{
+			const TSharedPtr<FJsonObject> RuleObject = RuleValue->AsObject();
+			if (!RuleObject.IsValid())
+			{
+				continue;
+			}
+
+			FTreeSitterLintRule& Rule = OutRules.AddDefaulted_GetRef();
+			Rule.Id = FName(RuleObject->GetStringField(TEXT("Id")));
+			Rule.Query = RuleObject->GetStringField(TEXT("Query"));
+			Rule.Message = RuleObject->GetStringField(TEXT("Message"));
+
+			const FString Severity = RuleObject->GetStringField(TEXT("Severity"));
+			Rule.Severity = Severity == TEXT("Error") ? ETreeSitterLintSeverity::Error : Severity == TEXT("Info") ? ETreeSitterLintSeverity::Info : ETreeSitterLintSeverity::Warning;
+		}
+
+		return true;
+	}
+
+	static TArray<FLintEntry> FindLintFiles(const FLintSettings& InSettings, const TMap<ETreeSitterLanguage, TSharedPtr<const FTreeSitterLinter>>& InLinters)
+	{
+		TArray<FLintEntry> Entries;
+		for (TPair<FString, ETreeSitterLanguage>& File : FindLanguageFiles(InSettings.Roots, [&InLinters](const ETreeSitterLanguage InLanguage) { return InLinters.Contains(InLanguage); }))
+		{
+			FLintEntry& Entry = Entries.AddDefaulted_GetRef();
+			Entry.Path = MoveTemp(File.Key);
+			Entry.Language = File.Value;
+		}
+
+		return Entries;
+	}
+
+	static void LintFile(const FTreeSitterLinter& InLinter, const TSLanguage* InLanguage, FLintEntry& OutEntry)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *OutEntry.Path))
+		{
+			OutEntry.bFailed = true;
+			return;
+		}
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(MoveTemp(Text));
+		const FTreeSitterPooledParser Parser(InLanguage);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		if (!Tree)
+		{
+			OutEntry.bFailed = true;
+			return;
+		}
+
+		InLinter.Lint(Tree, *Source, OutEntry.Diagnostics);
+		ts_tree_delete(Tree);
+	}
+}
+
+UTreeSitterLintCommandlet::UTreeSitterLintCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTreeSitterLintCommandlet::Main(const FString& Params)
+{
+	using namespace UE::TreeSitter::Private;
+
+	const FLintSettings Settings = ParseLintSettings(Params);
+	if (!Settings.RulesPath.IsEmpty() && Settings.Languages.Num() != 1)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterLint: -Rules= requires a single -Language="));
+		return 1;
+	}
+
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("TreeSitter"));
+	const FString RulesDir = Plugin.IsValid() ? Plugin->GetBaseDir() / TEXT("Resources/Lint") : FString();
+
+	// Linters are built up front on the game thread, workers only borrow parsers and run the combined queries
+	TMap<ETreeSitterLanguage, TSharedPtr<const FTreeSitterLinter>> Linters;
+	TMap<ETreeSitterLanguage, const TSLanguage*> Languages;
+	for (const ETreeSitterLanguage Language : {
+		ETreeSitterLanguage::JavaScript,
+		ETreeSitterLanguage::Json,
+		ETreeSitterLanguage::Markdown,
+		ETreeSitterLanguage::C,
+		ETreeSitterLanguage::Cpp,
+		ETreeSitterLanguage::Python,
+		ETreeSitterLanguage::Yaml,
+	})
+	{
+		if (!Settings.Languages.IsEmpty() && !Settings.Languages.Contains(Language))
+		{
+			continue;
+		}
+
+		const FString RulesPath = Settings.RulesPath.IsEmpty() ? RulesDir / GetLanguageName(Language) + TEXT(".json") : Settings.RulesPath;
+		TArray<FTreeSitterLintRule> Rules;
+		if (!LoadLintRules(RulesPath, Rules) || Rules.IsEmpty())
+		{
+			continue;
+		}
+
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(Language);
+		const TSLanguage* Grammar = LanguageParser ? LanguageParser() : nullptr;
+		if (!Grammar)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TreeSitterLint: grammar of %s is not available"), GetLanguageName(Language));
+			continue;
+		}
+
+		const TSharedRef<const FTreeSitterLinter> Linter = MakeShared<FTreeSitterLinter>(Grammar, MoveTemp(Rules));
+		if (!Linter->IsValid())
+		{
+			UE_LOG(LogTemp, Error, TEXT("TreeSitterLint: %s: %s"), *RulesPath, *Linter->GetError());
+			return 1;
+		}
+
+		Linters.Add(Language, Linter);
+		Languages.Add(Language, Grammar);
+	}
+
+	if (Linters.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterLint: no lint rules found"));
+		return 1;
+	}
+
+	TArray<FLintEntry> Entries = FindLintFiles(Settings, Linters);
+
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(Entries.Num(), [&Entries, &Linters, &Languages](const int32 Index)
+	{
+		FLintEntry& Entry = Entries[Index];
+		LintFile(*Linters.FindChecked(Entry.Language), Languages.FindChecked(Entry.Language), Entry);
+	}, EParallelForFlags::Unbalanced);
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+
+	int32 ErrorCount = 0;
+	int32 WarningCount = 0;
+	int32 InfoCount = 0;
+	for (const FLintEntry& Entry : Entries)
+	{
+		if (Entry.bFailed)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TreeSitterLint: failed to read or parse %s"), *Entry.Path);
+			continue;
+		}
+
+		const TArray<FTreeSitterLintRule>& Rules = Linters.FindChecked(Entry.Language)->GetRules();
+		for (const FTreeSitterLintDiagnostic& Diagnostic : Entry.Diagnostics)
+		{
+			const FTreeSitterLintRule& Rule = Rules[Diagnostic.Rule];
+			switch (Rule.Severity)
+			{
+			case ETreeSitterLintSeverity::Error:
+				++ErrorCount;
+				UE_LOG(LogTemp, Error, TEXT("%s(%u): Error: %s [%s]"), *Entry.Path, Diagnostic.Row + 1, *Rule.Message, *Rule.Id.ToString());
+				break;
+			case ETreeSitterLintSeverity::Warning:
+				++WarningCount;
+				UE_LOG(LogTemp, Warning, TEXT("%s(%u): Warning: %s [%s]"), *Entry.Path, Diagnostic.Row + 1, *Rule.Message, *Rule.Id.ToString());
+				break;
+			case ETreeSitterLintSeverity::Info:
+				++InfoCount;
+				UE_LOG(LogTemp, Display, TEXT("%s(%u): Info: %s [%s]"), *Entry.Path, Diagnostic.Row + 1, *Rule.Message, *Rule.Id.ToString());
+				break;
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("TreeSitterLint: %d files in %.2f s, %d errors, %d warnings, %d infos"),
+		Entries.Num(),
+		Duration,
+		ErrorCount,
+		WarningCount,
+		InfoCount
+	);
+
+	return ErrorCount > 0 ? 1 : 0;
+}
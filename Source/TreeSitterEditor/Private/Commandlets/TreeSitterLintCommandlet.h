@@ -0,0 +1,32 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "TreeSitterLintCommandlet.generated.h"
+
+/**
+ * Lints every file of a project with the query-based rules of its language (see FTreeSitterLinter), across all cores.
+ *
+ * Rules are read from Resources/Lint/<Language>.json, as an array of { "Id", "Severity", "Message", "Query" } objects
+ * under "Rules". Diagnostics are logged as <Path>(<Line>): <Severity>: <Message> [<Id>], and the commandlet fails if
+ * any of them is an error.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=TreeSitterLint [-Roots=<Dir>+<Dir>] [-Language=Json+JavaScript]
+ *        [-Rules=<Path>.json]
+ *
+ * Roots default to the project Source, Config and Content directories. -Rules= replaces the bundled rules, and
+ * requires a single -Language=.
+ */
+UCLASS()
+class UTreeSitterLintCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTreeSitterLintCommandlet();
+
+	//~ Begin UCommandlet
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet
+};
@@ -0,0 +1,243 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterReplaceCommandlet.h"
+
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "ITreeSitterModule.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "TreeSitterCommandletUtils.h"
+#include "TreeSitterLanguages.h"
+#include "TreeSitterNode.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterReplace.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::Private
+{
+	struct FReplaceSettings
+	{
+		TArray<FString> Roots;
+		ETreeSitterLanguage Language = ETreeSitterLanguage::Json;
+		FString QuerySource;
+		FString Template;
+
+		/** Reports the edits without writing any file */
+		bool bDryRun = false;
+
+		/** Writes files even when the replacement introduces syntax errors */
+		bool bAllowErrors = false;
+	};
+
+	struct FReplaceEntry
+	{
+		FString Path;
+		int32 EditCount = 0;
+		int32 ErrorCountBefore = 0;
+		int32 ErrorCountAfter = 0;
+		bool bFailed = false;
+		bool bWritten = false;
+	};
+
+	static bool ParseReplaceSettings(const FString& InParams, FReplaceSettings& OutSettings)
+	{
+		FString LanguageName;
+		if (!FParse::Value(*InParams, TEXT("Language="), LanguageName, false) || !FindLanguageByName(LanguageName, OutSettings.Language))
+		{
+			UE_LOG(LogTemp, Error, TEXT("TreeSitterReplace: missing or unknown -Language="));
+			return false;
+		}
+
+		FString QueryPath;
+		if (!FParse::Value(*InParams, TEXT("Query="), QueryPath, false) || !FFileHelper::LoadFileToString(OutSettings.QuerySource, *QueryPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("TreeSitterReplace: missing -Query= or failed to read '%s'"), *QueryPath);
+			return false;
+		}
+
+		FString TemplatePath;
+		if (FParse::Value(*InParams, TEXT("TemplateFile="), TemplatePath, false))
+		{
+			if (!FFileHelper::LoadFileToString(OutSettings.Template, *TemplatePath))
+			{
+				UE_LOG(LogTemp, Error, TEXT("TreeSitterReplace: failed to read '%s'"), *TemplatePath);
+				return false;
+			}
+		}
+		else if (!FParse::Value(*InParams, TEXT("Template="), OutSettings.Template, false))
+		{
+			UE_LOG(LogTemp, Error, TEXT("TreeSitterReplace: missing -Template= or -TemplateFile="));
+			return false;
+		}
+
+		OutSettings.Roots = ParseRoots(InParams);
+		OutSettings.bDryRun = FParse::Param(*InParams, TEXT("DryRun"));
+		OutSettings.bAllowErrors = FParse::Param(*InParams, TEXT("AllowErrors"));
+		return true;
+	}
+
+	static TArray<FReplaceEntry> FindReplaceFiles(const FReplaceSettings& InSettings)
+	{
+		TArray<FReplaceEntry> Entries;
+		for (TPair<FString, ETreeSitterLanguage>& File : FindLanguageFiles(InSettings.Roots, [&InSettings](const ETreeSitterLanguage InLanguage) { return InLanguage == InSettings.Language; }))
+		{
+			Entries.AddDefaulted_GetRef().Path = MoveTemp(File.Key);
+		}
+
+		return Entries;
+	}
+
+	/** Replaces every match in a file, reparsing the result incrementally to check it for new syntax errors */
+	static void ReplaceInFile(const FReplaceSettings& InSettings, const TSLanguage* InLanguage, const FTreeSitterReplacer& InReplacer, FReplaceEntry& OutEntry)
+	{
+		TArray<uint8> Content;
+		if (!FFileHelper::LoadFileToArray(Content, *OutEntry.Path))
+		{
+			OutEntry.bFailed = true;
+			return;
+		}
+
+		const bool bHasBOM = Content.Num() >= 3 && Content[0] == 0xEF && Content[1] == 0xBB && Content[2] == 0xBF;
+
+		FString Text;
+		FFileHelper::BufferToString(Text, Content.GetData(), Content.Num());
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(MoveTemp(Text));
+
+		const FTreeSitterPooledParser Parser(InLanguage);
+		TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		if (!Tree)
+		{
+			OutEntry.bFailed = true;
+			return;
+		}
+
+		TArray<FTreeSitterTextEdit> Edits;
+		InReplacer.FindEdits(ts_tree_root_node(Tree), *Source, Edits);
+		OutEntry.EditCount = Edits.Num();
+		if (Edits.IsEmpty())
+		{
+			ts_tree_delete(Tree);
+			return;
+		}
+
+		OutEntry.ErrorCountBefore = CountSyntaxErrors(ts_tree_root_node(Tree));
+
+		const TSharedRef<const FTreeSitterSource> NewSource = ApplyEdits(*Source, Edits, Tree);
+		TSTree* NewTree = Parser->Parse(NewSource->GetUTF8(), NewSource->GetUTF8Length(), Tree);
+		ts_tree_delete(Tree);
+		if (!NewTree)
+		{
+			OutEntry.bFailed = true;
+			return;
+		}
+
+		OutEntry.ErrorCountAfter = CountSyntaxErrors(ts_tree_root_node(NewTree));
+		ts_tree_delete(NewTree);
+
+		if (InSettings.bDryRun || (OutEntry.ErrorCountAfter > OutEntry.ErrorCountBefore && !InSettings.bAllowErrors))
+		{
+			return;
+		}
+
+		const FFileHelper::EEncodingOptions Encoding = bHasBOM ? FFileHelper::EEncodingOptions::ForceUTF8 : FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM;
+		OutEntry.bWritten = FFileHelper::SaveStringToFile(NewSource->GetText(), *OutEntry.Path, Encoding);
+		OutEntry.bFailed = !OutEntry.bWritten;
+	}
+}
+
+UTreeSitterReplaceCommandlet::UTreeSitterReplaceCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UTreeSitterReplaceCommandlet::Main(const FString& Params)
+{
+	using namespace UE::TreeSitter::Private;
+
+	FReplaceSettings Settings;
+	if (!ParseReplaceSettings(Params, Settings))
+	{
+		return 1;
+	}
+
+	ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(Settings.Language);
+	const TSLanguage* Language = LanguageParser ? LanguageParser() : nullptr;
+	if (!Language)
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterReplace: grammar of %s is not available"), UE::TreeSitter::GetLanguageName(Settings.Language));
+		return 1;
+	}
+
+	// Compiled once and shared by every worker, only query cursors are per file
+	const FTreeSitterReplacer Replacer(MakeShared<FTreeSitterQuery>(Language, Settings.QuerySource), Settings.Template);
+	if (!Replacer.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("TreeSitterReplace: %s"), *Replacer.GetError());
+		return 1;
+	}
+
+	TArray<FReplaceEntry> Entries = FindReplaceFiles(Settings);
+
+	const double StartTime = FPlatformTime::Seconds();
+	ParallelFor(Entries.Num(), [&Settings, Language, &Replacer, &Entries](const int32 Index)
+	{
+		ReplaceInFile(Settings, Language, Replacer, Entries[Index]);
+	}, EParallelForFlags::Unbalanced);
+	const double Duration = FPlatformTime::Seconds() - StartTime;
+
+	int32 MatchedFileCount = 0;
+	int32 EditCount = 0;
+	int32 WrittenCount = 0;
+	int32 RejectedCount = 0;
+	for (const FReplaceEntry& Entry : Entries)
+	{
+		if (Entry.bFailed)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("TreeSitterReplace: failed to read, parse or write %s"), *Entry.Path);
+			continue;
+		}
+
+		if (Entry.EditCount == 0)
+		{
+			continue;
+		}
+
+		++MatchedFileCount;
+		EditCount += Entry.EditCount;
+		WrittenCount += Entry.bWritten;
+
+		if (Entry.ErrorCountAfter > Entry.ErrorCountBefore)
+		{
+			RejectedCount += !Entry.bWritten && !Settings.bDryRun;
+			UE_LOG(LogTemp, Warning, TEXT("TreeSitterReplace: %s: %d replacements introduce %d syntax errors%s"),
+				*Entry.Path,
+				Entry.EditCount,
+				Entry.ErrorCountAfter - Entry.ErrorCountBefore,
+				Entry.bWritten ? TEXT("") : TEXT(", left untouched")
+			);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Display, TEXT("TreeSitterReplace: %s: %d replacements"), *Entry.Path, Entry.EditCount);
+		}
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("TreeSitterReplace: %d files in %.2f s, %d replacements in %d files, %d written, %d rejected%s"),
+		Entries.Num(),
+		Duration,
+		EditCount,
+		MatchedFileCount,
+		WrittenCount,
+		RejectedCount,
+		Settings.bDryRun ? TEXT(" (dry run)") : TEXT("")
+	);
+
+	return RejectedCount > 0 ? 1 : 0;
+}
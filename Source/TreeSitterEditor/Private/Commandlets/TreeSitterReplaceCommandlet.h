@@ -0,0 +1,31 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "TreeSitterReplaceCommandlet.generated.h"
+
+/**
+ * Structural search and replace over every file of a language, across all cores (see FTreeSitterReplacer).
+ *
+ * Each file is parsed, every match of the query is replaced by the template in a single pass, and the result is
+ * reparsed incrementally from the edited tree. Files where the replacement introduces syntax errors are left untouched
+ * unless -AllowErrors is given.
+ *
+ * Usage: UnrealEditor-Cmd <Project> -run=TreeSitterReplace -Language=JavaScript -Query=<Path>.scm
+ *        (-Template=<Text> | -TemplateFile=<Path>) [-Roots=<Dir>+<Dir>] [-DryRun] [-AllowErrors]
+ *
+ * Roots default to the project Source, Config and Content directories.
+ */
+UCLASS()
+class UTreeSitterReplaceCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UTreeSitterReplaceCommandlet();
+
+	//~ Begin UCommandlet
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet
+};
@@ -11,7 +11,11 @@ void STreeSitterCodeEditor::Construct(const FArguments& InArgs)
 	[
 		SAssignNew(EditBox, SMultiLineEditableTextBox)
 		.Text(InArgs._InitialText)
+		.Marshaller(InArgs._Marshaller)
 		.OnTextChanged(InArgs._OnTextChanged)
+		.OnKeyDownHandler(InArgs._OnKeyDownHandler)
+		.OnVScrollBarUserScrolled(InArgs._OnVScrollBarUserScrolled)
+		.OnCursorMoved(InArgs._OnCursorMoved)
 	];
 }
 
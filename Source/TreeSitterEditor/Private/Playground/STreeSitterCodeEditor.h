@@ -4,7 +4,9 @@
 
 #include "Framework/SlateDelegates.h"
 #include "Widgets/SCompoundWidget.h"
+#include "Widgets/Text/SMultiLineEditableText.h"
 
+class ITextLayoutMarshaller;
 class SMultiLineEditableTextBox;
 
 class STreeSitterCodeEditor : public SCompoundWidget
@@ -13,6 +15,10 @@ public:
     SLATE_BEGIN_ARGS(STreeSitterCodeEditor) {}
         SLATE_ARGUMENT(FText, InitialText)
         SLATE_EVENT(FOnTextChanged, OnTextChanged)
+        SLATE_ARGUMENT(TSharedPtr<ITextLayoutMarshaller>, Marshaller)
+        SLATE_EVENT(FOnKeyDown, OnKeyDownHandler)
+        SLATE_EVENT(FOnUserScrolled, OnVScrollBarUserScrolled)
+        SLATE_EVENT(SMultiLineEditableText::FOnCursorMoved, OnCursorMoved)
     SLATE_END_ARGS()
 
     void Construct(const FArguments& InArgs);
@@ -2,10 +2,10 @@
 
 #include "STreeSitterMarkdownPlayground.h"
 
-#include "Components/VerticalBox.h"
 #include "Editor.h"
-#include "Playground/STreeSitterCodeEditor.h"
-#include "Markdown/STreeSitterMarkdown.h"
+#include "STreeSitterCodeEditor.h"
+#include "STreeSitterMarkdown.h"
+#include "Widgets/SBoxPanel.h"
 
 STreeSitterMarkdownPlayground::~STreeSitterMarkdownPlayground()
 {
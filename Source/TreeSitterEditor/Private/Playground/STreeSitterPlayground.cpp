@@ -6,7 +6,12 @@
 #include "ITreeSitterModule.h"
 #include "STreeSitterCodeEditor.h"
 #include "STreeSitterTreeViewer.h"
+#include "TreeSitterHighlightMarshaller.h"
+#include "TreeSitterHighlighter.h"
+#include "TreeSitterLocals.h"
 #include "TreeSitterParser.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
 #include "Widgets/Input/SCheckBox.h"
 #include "Widgets/Input/SMultiLineEditableTextBox.h"
 #include "tree_sitter/api.h"
@@ -93,6 +98,7 @@ Baz is *Foobar* and ***foo***
 
 STreeSitterPlayground::~STreeSitterPlayground()
 {
+	ResetParsedTree();
 	Parser.Reset();
 	CodeText.Reset();
 }
@@ -103,13 +109,18 @@ void STreeSitterPlayground::Construct(const FArguments& InArgs)
 	Parser->SetLanguage(ETreeSitterLanguage::Json);
 
 	CodeText = MakeShared<FString>();
+	HighlightMarshaller = FTreeSitterHighlightMarshaller::Create();
 
 	SelectedLanguage = UEnum::GetValueAsName(ETreeSitterLanguage::Json);
 	AvailableLanguages = {
 		UEnum::GetValueAsName(ETreeSitterLanguage::Json),
 		UEnum::GetValueAsName(ETreeSitterLanguage::JavaScript),
 		UEnum::GetValueAsName(ETreeSitterLanguage::Markdown),
-		UEnum::GetValueAsName(ETreeSitterLanguage::MarkdownInline)
+		UEnum::GetValueAsName(ETreeSitterLanguage::MarkdownInline),
+		UEnum::GetValueAsName(ETreeSitterLanguage::C),
+		UEnum::GetValueAsName(ETreeSitterLanguage::Cpp),
+		UEnum::GetValueAsName(ETreeSitterLanguage::Python),
+		UEnum::GetValueAsName(ETreeSitterLanguage::Yaml)
 	};
 
 	ChildSlot
@@ -166,7 +177,11 @@ void STreeSitterPlayground::Construct(const FArguments& InArgs)
 			.FillWidth(0.5f)
 			[
 				SAssignNew(CodeEditor, STreeSitterCodeEditor)
+				.Marshaller(HighlightMarshaller)
 				.OnTextChanged(this, &STreeSitterPlayground::OnCodeChanged)
+				.OnKeyDownHandler(this, &STreeSitterPlayground::HandleCodeKeyDown)
+				.OnVScrollBarUserScrolled(this, &STreeSitterPlayground::HandleCodeScrolled)
+				.OnCursorMoved(this, &STreeSitterPlayground::HandleCodeCursorMoved)
 			]
 
 			+ SHorizontalBox::Slot()
@@ -196,15 +211,143 @@ void STreeSitterPlayground::OnCodeChanged(const FText& NewText)
 	}
 }
 
-void STreeSitterPlayground::ProcessPendingCode() const
+void STreeSitterPlayground::ProcessPendingCode()
 {
 	check(CodeText.IsValid());
-	
-	TSTree* Tree = Parser->Parse(*CodeText);
-	const TSNode RootNode = ts_tree_root_node(Tree);
 
+	const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(*CodeText);
+
+	// Reparse the previous tree with the edit applied, so that only the edited parts are parsed and resolved again
+	TSInputEdit Edit;
+	const bool bIncremental = ParsedTree && ParsedSource.IsValid();
+	if (bIncremental)
+	{
+		if (!Source->ComputeEdit(*ParsedSource, Edit))
+		{
+			return;
+		}
+
+		ts_tree_edit(ParsedTree, &Edit);
+	}
+
+	TSTree* Tree = Parser->Parse(Source->GetUTF8(), Source->GetUTF8Length(), ParsedTree);
+	if (!Tree)
+	{
+		ResetParsedTree();
+		return;
+	}
+
+	const TSNode RootNode = ts_tree_root_node(Tree);
 	TreeViewer->UpdateTree(RootNode, CodeText.ToSharedRef());
-	ts_tree_delete(Tree);
+
+	if (!LocalsQuery.IsValid())
+	{
+		Locals.Reset();
+	}
+	else if (bIncremental && Locals.IsValid())
+	{
+		Locals = Locals->Update(Edit, ParsedTree, Tree, *Source);
+	}
+	else
+	{
+		Locals = FTreeSitterLocals::Build(LocalsQuery.ToSharedRef(), Tree, *Source);
+	}
+
+	if (Highlighter.IsValid())
+	{
+		// Only the blocks reached by the edit are queried again
+		if (bIncremental)
+		{
+			Highlighter->UpdateTree(Edit, ParsedTree, Tree, Source);
+		}
+		else
+		{
+			Highlighter->SetTree(Tree, Source);
+		}
+		HighlightMarshaller->MakeDirty();
+	}
+
+	ResetParsedTree();
+	ParsedTree = Tree;
+	ParsedSource = Source;
+}
+
+void STreeSitterPlayground::ResetParsedTree()
+{
+	if (ParsedTree)
+	{
+		ts_tree_delete(ParsedTree);
+		ParsedTree = nullptr;
+	}
+}
+
+FReply STreeSitterPlayground::HandleCodeKeyDown(const FGeometry& InGeometry, const FKeyEvent& InKeyEvent)
+{
+	if (InKeyEvent.GetKey() == EKeys::F12)
+	{
+		GoToDefinition();
+		return FReply::Handled();
+	}
+
+	return FReply::Unhandled();
+}
+
+void STreeSitterPlayground::GoToDefinition() const
+{
+	if (!Locals.IsValid() || !ParsedSource.IsValid())
+	{
+		return;
+	}
+
+	// Lines of the edit box are the lines of the parsed text, offsets are in characters
+	const FString& Text = ParsedSource->GetText();
+	const FTextLocation CursorLocation = CodeEditor->GetEditBox()->GetCursorLocation();
+
+	int32 CharIndex = 0;
+	for (int32 Line = 0; Line < CursorLocation.GetLineIndex() && CharIndex != INDEX_NONE; ++Line)
+	{
+		CharIndex = Text.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromStart, CharIndex);
+		CharIndex = CharIndex != INDEX_NONE ? CharIndex + 1 : INDEX_NONE;
+	}
+	if (CharIndex == INDEX_NONE)
+	{
+		return;
+	}
+	CharIndex = FMath::Min(CharIndex + CursorLocation.GetOffset(), Text.Len());
+
+	const uint32 ByteOffset = FPlatformString::ConvertedLength<UTF8CHAR>(*Text, CharIndex);
+	const int32 Definition = Locals->FindDefinitionAt(ByteOffset);
+	if (Definition == INDEX_NONE)
+	{
+		return;
+	}
+
+	const int32 DefinitionCharIndex = ParsedSource->GetCharIndex(Locals->GetDefinitions()[Definition].StartByte);
+	const int32 LineStart = Text.Find(TEXT("\n"), ESearchCase::CaseSensitive, ESearchDir::FromEnd, DefinitionCharIndex) + 1;
+	int32 LineIndex = 0;
+	for (int32 Index = 0; Index < LineStart; ++Index)
+	{
+		LineIndex += Text[Index] == TEXT('\n') ? 1 : 0;
+	}
+
+	CodeEditor->GetEditBox()->GoTo(FTextLocation(LineIndex, DefinitionCharIndex - LineStart));
+}
+
+void STreeSitterPlayground::HandleCodeScrolled(const float InScrollOffsetFraction)
+{
+	if (!Highlighter.IsValid())
+	{
+		return;
+	}
+
+	// The scroll offset is a fraction of the whole text, the margin of the marshaller covers the viewport height
+	const int32 FirstLine = FMath::FloorToInt32(InScrollOffsetFraction * Highlighter->GetLineCount());
+	HighlightMarshaller->SetVisibleLines(FirstLine, FirstLine + 1);
+}
+
+void STreeSitterPlayground::HandleCodeCursorMoved(const FTextLocation& InLocation)
+{
+	HighlightMarshaller->SetVisibleLines(InLocation.GetLineIndex(), InLocation.GetLineIndex() + 1);
 }
 
 void STreeSitterPlayground::HandleSelectedLanguageChanged(FName InSelectedLanguage, ESelectInfo::Type InSelectInfo)
@@ -221,7 +364,15 @@ void STreeSitterPlayground::HandleSelectedLanguageChanged(FName InSelectedLangua
 		CodeEditor->GetEditBox()->SetText(FText::FromString(*CodeText));
 	}
 	
+	// Trees of the previous language can't be reparsed with the new one
 	Parser->SetLanguage(Language);
+	ResetParsedTree();
+	Locals.Reset();
+	LocalsQuery = ITreeSitterModule::Get().FindQuery(Language, TEXT("locals"));
+
+	const TSharedPtr<const FTreeSitterQuery> HighlightsQuery = ITreeSitterModule::Get().FindQuery(Language, TEXT("highlights"));
+	Highlighter = HighlightsQuery.IsValid() ? MakeShared<FTreeSitterHighlighter>(HighlightsQuery.ToSharedRef()) : TSharedPtr<FTreeSitterHighlighter>();
+	HighlightMarshaller->SetHighlighter(Highlighter);
 	ProcessPendingCode();
 }
 
@@ -6,9 +6,15 @@
 #include "Widgets/Input/SComboBox.h"
 #include "Widgets/SCompoundWidget.h"
 
+class FTreeSitterHighlightMarshaller;
+class FTreeSitterHighlighter;
+class FTreeSitterLocals;
 class FTreeSitterParser;
+class FTreeSitterQuery;
+class FTreeSitterSource;
 class STreeSitterTreeViewer;
 class STreeSitterCodeEditor;
+struct TSTree;
 
 class STreeSitterPlayground : public SCompoundWidget
 {
@@ -28,6 +34,20 @@ private:
 	TSharedPtr<STreeSitterTreeViewer> TreeViewer;
 	TSharedPtr<FTreeSitterParser> Parser;
 
+	/** Locals query of the selected language, if it has one */
+	TSharedPtr<const FTreeSitterQuery> LocalsQuery;
+
+	/** Highlighter of the selected language, if it has a highlights query, fed with each parse */
+	TSharedPtr<FTreeSitterHighlighter> Highlighter;
+	TSharedPtr<FTreeSitterHighlightMarshaller> HighlightMarshaller;
+
+	/** Source and locals of the last parse, for go-to-definition */
+	TSharedPtr<const FTreeSitterSource> ParsedSource;
+	TSharedPtr<const FTreeSitterLocals> Locals;
+
+	/** Tree of the last parse, edited and reparsed incrementally on each change until the language changes */
+	TSTree* ParsedTree = nullptr;
+
 	// TSharedPtr<SComboBox<ETreeSitterLanguage>> ComboBox;
 	TSharedPtr<SComboBox<FName>> ComboBox;
 	
@@ -45,7 +65,16 @@ private:
 	TSharedPtr<FString> CodeText;
 
 	void OnCodeChanged(const FText& NewText);
-	void ProcessPendingCode() const;
+	void ProcessPendingCode();
+	void ResetParsedTree();
+
+	/** F12: moves the cursor to the definition of the identifier under it */
+	FReply HandleCodeKeyDown(const FGeometry& InGeometry, const FKeyEvent& InKeyEvent);
+	void GoToDefinition() const;
+
+	/** Keeps the highlighted lines around the visible ones, so that only those get queried */
+	void HandleCodeScrolled(const float InScrollOffsetFraction);
+	void HandleCodeCursorMoved(const FTextLocation& InLocation);
 	
 	void HandleSelectedLanguageChanged(FName InSelectedLanguage, ESelectInfo::Type InSelectInfo);
 	static TSharedRef<SWidget> MakeWidgetForComboBox(FName InValue);
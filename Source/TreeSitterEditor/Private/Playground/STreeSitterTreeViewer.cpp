@@ -68,8 +68,7 @@ void STreeSitterTreeViewer::UpdateTree(const TSNode& InRootNode, const TSharedRe
 {
 	CodeText = InCodeText;
 
-	TreeItems.Empty();
-	PopulateTree(InRootNode, nullptr, 0);
+	BuildTreeItems(InRootNode, TreeItems);
 	TreeView->RequestTreeRefresh();
 	ExpandTreeView(TreeView.ToSharedRef());
 }
@@ -160,74 +159,59 @@ void STreeSitterTreeViewer::GetTreeChildren(TSharedPtr<FTreeSitterNode> InItem,
 	OutChildren = InItem->Children;
 }
 
-void STreeSitterTreeViewer::PopulateTree(const TSNode& InNode, const TSharedPtr<FTreeSitterNode>& InParent, const uint32 InDepth)
+void STreeSitterTreeViewer::BuildTreeItems(const TSNode& InRootNode, TArray<TSharedPtr<FTreeSitterNode>>& OutTreeItems)
 {
-	// const char* UTF8Source = TCHAR_TO_UTF8(*CodeText.ToString());
-	
-	const TSharedRef<FTreeSitterNode> NewNode = MakeShared<FTreeSitterNode>(InNode, InDepth);
-
-	char* NodeString = ts_node_string(InNode);
-	NewNode->SExpression = FString(UTF8_TO_TCHAR(NodeString));
-	free(NodeString);
+	OutTreeItems.Reset();
+	if (ts_node_is_null(InRootNode))
+	{
+		return;
+	}
 
-	NewNode->FieldName = GetNodeFieldName(InNode);
+	// Item created for each node of the current path, anonymous ones included, indexed by depth
+	TArray<TSharedPtr<FTreeSitterNode>, TInlineAllocator<64>> Path;
 
-	if (NewNode->bIsNamed)
+	TSTreeCursor Cursor = ts_tree_cursor_new(InRootNode);
+	uint32 Depth = 0;
+	bool bDone = false;
+	while (!bDone)
 	{
-		if (InParent)
+		const TSharedRef<FTreeSitterNode> NewNode = MakeShared<FTreeSitterNode>(ts_tree_cursor_current_node(&Cursor), Depth);
+		if (const char* FieldName = ts_tree_cursor_current_field_name(&Cursor))
 		{
-			InParent->Children.Add(NewNode);
+			NewNode->FieldName = FName(FieldName);
 		}
-		else
+
+		if (NewNode->bIsNamed)
 		{
-			TreeItems.Add(NewNode);
+			if (Depth == 0)
+			{
+				OutTreeItems.Add(NewNode);
+			}
+			else
+			{
+				Path[Depth - 1]->Children.Add(NewNode);
+			}
 		}
-	}
 
-	const uint32 ChildCount = ts_node_child_count(InNode);
-	for (uint32 i = 0; i < ChildCount; i++)
-	{
-		PopulateTree(ts_node_child(InNode, i), NewNode, InDepth + 1);
-	}
-}
+		Path.SetNum(Depth + 1);
+		Path[Depth] = NewNode;
 
-FName STreeSitterTreeViewer::GetNodeFieldName(const TSNode& InNode)
-{
-	FName FieldName;
-	const TSNode NodeParent = ts_node_parent(InNode);
-	if (ts_node_is_null(NodeParent))
-	{
-		return MoveTemp(FieldName);
-	}
-	
-	// TODO This can be done only once when language parser is set
-	const TSLanguage* NodeLanguage = ts_node_language(InNode);
-	TArray<TSFieldId> FieldIds = GetFieldIdsForLanguage(NodeLanguage);
-	
-	for (const TSFieldId Id : FieldIds)
-	{
-		const TSNode FoundNode = ts_node_child_by_field_id(NodeParent, Id);
-		if (!ts_node_is_null(FoundNode) && ts_node_eq(FoundNode, InNode))
+		if (ts_tree_cursor_goto_first_child(&Cursor))
 		{
-			FieldName = FName(ts_language_field_name_for_id(NodeLanguage, Id));
-			break;
+			++Depth;
+			continue;
 		}
-	}
-
-	return MoveTemp(FieldName);
-}
 
-TArray<TSFieldId> STreeSitterTreeViewer::GetFieldIdsForLanguage(const TSLanguage* InLanguage)
-{
-	const uint32 Field_Count = ts_language_field_count(InLanguage);
-	
-	TArray<TSFieldId> FieldIds;
-	for (uint32 i = 1; i < Field_Count; ++i)
-	{
-		const char* FieldNameId = ts_language_field_name_for_id(InLanguage, i);
-		const TSFieldId FieldId = ts_language_field_id_for_name(InLanguage, FieldNameId, strlen(FieldNameId));
-		FieldIds.Add(FieldId);
+		while (!ts_tree_cursor_goto_next_sibling(&Cursor))
+		{
+			if (!ts_tree_cursor_goto_parent(&Cursor))
+			{
+				bDone = true;
+				break;
+			}
+			--Depth;
+		}
 	}
 
-	return MoveTemp(FieldIds);
+	ts_tree_cursor_delete(&Cursor);
 }
@@ -6,9 +6,6 @@
 
 struct FTreeSitterNode;
 struct TSNode;
-struct TSLanguage;
-
-using TSFieldId = uint16_t;
 
 class STreeSitterTreeViewer : public SCompoundWidget
 {
@@ -32,6 +29,12 @@ public:
 	void ExpandTreeView(const TSharedRef<STreeSitterView>& InTreeView);
 	void SetItemExpansionRecursive(const TSharedPtr<FTreeSitterNode>& InTreeItem, bool bInExpansionState);
 
+	/**
+	 * Builds the items displayed for a tree, only named nodes being attached. Walks the tree once with a cursor, which
+	 * also provides the field name of each node, so that the cost is linear in the node count.
+	 */
+	static void BuildTreeItems(const TSNode& InRootNode, TArray<TSharedPtr<FTreeSitterNode>>& OutTreeItems);
+
 private:
 	TArray<TSharedPtr<FTreeSitterNode>> TreeItems;
 	TSharedPtr<STreeSitterView> TreeView;
@@ -42,11 +45,4 @@ private:
 	static TSharedRef<ITableRow> GenerateRow(TSharedPtr<FTreeSitterNode> InItem, const TSharedRef<STableViewBase>& InOwnerTable);
 
 	static void GetTreeChildren(TSharedPtr<FTreeSitterNode> InItem, TArray<TSharedPtr<FTreeSitterNode>>& OutChildren);
-
-	void PopulateTree(const TSNode& InNode, const TSharedPtr<FTreeSitterNode>& InParent, const uint32 InDepth);
-
-	/** Tries to find the corresponding field names for this node, if any */
-	static FName GetNodeFieldName(const TSNode& InNode);
-
-	static TArray<TSFieldId> GetFieldIdsForLanguage(const TSLanguage* InLanguage);
 };
@@ -0,0 +1,151 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterHighlightMarshaller.h"
+
+#include "Framework/Text/SlateTextRun.h"
+#include "Framework/Text/TextLayout.h"
+#include "Styling/CoreStyle.h"
+#include "TreeSitterHighlighter.h"
+
+namespace UE::TreeSitter::Highlight
+{
+	/** Color of a capture, from its first segment ("function" for "function.method") */
+	static FLinearColor GetCaptureColor(const FName InCaptureName, const FLinearColor& InDefaultColor)
+	{
+		static const TMap<FString, FLinearColor> Colors = {
+			{ TEXT("keyword"), FLinearColor(0.78f, 0.47f, 0.87f) },
+			{ TEXT("string"), FLinearColor(0.81f, 0.57f, 0.47f) },
+			{ TEXT("escape"), FLinearColor(0.84f, 0.73f, 0.49f) },
+			{ TEXT("number"), FLinearColor(0.71f, 0.81f, 0.66f) },
+			{ TEXT("boolean"), FLinearColor(0.34f, 0.61f, 0.84f) },
+			{ TEXT("constant"), FLinearColor(0.34f, 0.61f, 0.84f) },
+			{ TEXT("comment"), FLinearColor(0.42f, 0.6f, 0.33f) },
+			{ TEXT("function"), FLinearColor(0.86f, 0.86f, 0.67f) },
+			{ TEXT("type"), FLinearColor(0.31f, 0.79f, 0.69f) },
+			{ TEXT("property"), FLinearColor(0.61f, 0.86f, 1.f) },
+			{ TEXT("variable"), FLinearColor(0.61f, 0.86f, 1.f) },
+			{ TEXT("operator"), FLinearColor(0.83f, 0.83f, 0.83f) },
+			{ TEXT("punctuation"), FLinearColor(0.6f, 0.6f, 0.6f) },
+		};
+
+		FString Name = InCaptureName.ToString();
+		Name.Split(TEXT("."), &Name, nullptr);
+
+		const FLinearColor* Color = Colors.Find(Name);
+		return Color ? *Color : InDefaultColor;
+	}
+}
+
+TSharedRef<FTreeSitterHighlightMarshaller> FTreeSitterHighlightMarshaller::Create()
+{
+	return MakeShared<FTreeSitterHighlightMarshaller>();
+}
+
+FTreeSitterHighlightMarshaller::FTreeSitterHighlightMarshaller()
+{
+	DefaultStyle = FCoreStyle::Get().GetWidgetStyle<FTextBlockStyle>("NormalText");
+	DefaultStyle.SetFont(FCoreStyle::GetDefaultFontStyle("Mono", 10));
+}
+
+void FTreeSitterHighlightMarshaller::SetText(const FString& SourceString, FTextLayout& TargetTextLayout)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterHighlightMarshaller::SetText);
+
+	TArray<FTextRange> LineRanges;
+	FTextRange::CalculateLineRangesFromString(SourceString, LineRanges);
+
+	TArray<TArray<FTreeSitterHighlightSpan>> LineSpans;
+	if (Highlighter.IsValid())
+	{
+		Highlighter->GetLineSpans(HighlightedFirstLine, HighlightedEndLine, LineSpans);
+	}
+
+	TArray<FTextLayout::FNewLineData> LinesToAdd;
+	LinesToAdd.Reserve(LineRanges.Num());
+
+	// Capture of each character of a line, inner spans coming after and overriding outer ones
+	TArray<int32> CharCaptures;
+
+	for (int32 LineIndex = 0; LineIndex < LineRanges.Num(); ++LineIndex)
+	{
+		const FTextRange& LineRange = LineRanges[LineIndex];
+		TSharedRef<FString> LineText = MakeShared<FString>(SourceString.Mid(LineRange.BeginIndex, LineRange.Len()));
+		const int32 LineLength = LineText->Len();
+
+		TArray<TSharedRef<IRun>> Runs;
+
+		const int32 SpansIndex = LineIndex - HighlightedFirstLine;
+		if (!LineSpans.IsValidIndex(SpansIndex) || LineSpans[SpansIndex].IsEmpty())
+		{
+			Runs.Add(FSlateTextRun::Create(FRunInfo(), LineText, DefaultStyle, FTextRange(0, LineLength)));
+			LinesToAdd.Emplace(MoveTemp(LineText), MoveTemp(Runs));
+			continue;
+		}
+
+		CharCaptures.Init(INDEX_NONE, LineLength);
+		for (const FTreeSitterHighlightSpan& Span : LineSpans[SpansIndex])
+		{
+			// The text may have been edited since the last parse
+			for (int32 Column = FMath::Max(Span.StartColumn, 0); Column < FMath::Min(Span.EndColumn, LineLength); ++Column)
+			{
+				CharCaptures[Column] = Span.Capture;
+			}
+		}
+
+		int32 RunStart = 0;
+		for (int32 Column = 1; Column <= LineLength; ++Column)
+		{
+			if (Column == LineLength || CharCaptures[Column] != CharCaptures[RunStart])
+			{
+				const FTextBlockStyle& Style = CharCaptures[RunStart] == INDEX_NONE ? DefaultStyle : GetCaptureStyle(CharCaptures[RunStart]);
+				Runs.Add(FSlateTextRun::Create(FRunInfo(), LineText, Style, FTextRange(RunStart, Column)));
+				RunStart = Column;
+			}
+		}
+
+		if (Runs.IsEmpty())
+		{
+			Runs.Add(FSlateTextRun::Create(FRunInfo(), LineText, DefaultStyle, FTextRange(0, 0)));
+		}
+		LinesToAdd.Emplace(MoveTemp(LineText), MoveTemp(Runs));
+	}
+
+	TargetTextLayout.AddLines(LinesToAdd);
+}
+
+void FTreeSitterHighlightMarshaller::GetText(FString& TargetString, const FTextLayout& SourceTextLayout)
+{
+	SourceTextLayout.GetAsText(TargetString);
+}
+
+void FTreeSitterHighlightMarshaller::SetHighlighter(const TSharedPtr<FTreeSitterHighlighter>& InHighlighter)
+{
+	Highlighter = InHighlighter;
+	CaptureStyles.Reset();
+	MakeDirty();
+}
+
+void FTreeSitterHighlightMarshaller::SetVisibleLines(const int32 InFirstLine, const int32 InEndLine)
+{
+	if (InFirstLine >= HighlightedFirstLine && InEndLine <= HighlightedEndLine)
+	{
+		return;
+	}
+
+	HighlightedFirstLine = FMath::Max(InFirstLine - VisibleLinesMargin, 0);
+	HighlightedEndLine = InEndLine + VisibleLinesMargin;
+	MakeDirty();
+}
+
+const FTextBlockStyle& FTreeSitterHighlightMarshaller::GetCaptureStyle(const uint16 InCapture)
+{
+	if (const FTextBlockStyle* Style = CaptureStyles.Find(InCapture))
+	{
+		return *Style;
+	}
+
+	FTextBlockStyle Style = DefaultStyle;
+	const FLinearColor Color = UE::TreeSitter::Highlight::GetCaptureColor(Highlighter->GetCaptureName(InCapture), DefaultStyle.ColorAndOpacity.GetSpecifiedColor());
+	Style.SetColorAndOpacity(FSlateColor(Color));
+	return CaptureStyles.Add(InCapture, MoveTemp(Style));
+}
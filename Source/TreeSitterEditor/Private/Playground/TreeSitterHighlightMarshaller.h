@@ -0,0 +1,49 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Framework/Text/BaseTextLayoutMarshaller.h"
+#include "Styling/SlateTypes.h"
+
+class FTreeSitterHighlighter;
+
+/**
+ * Marshals the playground code into runs colored from a FTreeSitterHighlighter.
+ *
+ * Only the lines around the visible ones (see SetVisibleLines()) get highlighted runs, every other line being a single
+ * plain run, so that the highlights query only ever runs on the blocks scrolled to.
+ */
+class FTreeSitterHighlightMarshaller : public FBaseTextLayoutMarshaller
+{
+public:
+	/** Extra lines highlighted above and below the visible ones, so that small scrolls do not re-marshal */
+	static constexpr int32 VisibleLinesMargin = 64;
+
+	static TSharedRef<FTreeSitterHighlightMarshaller> Create();
+
+	FTreeSitterHighlightMarshaller();
+
+	//~ Begin ITextLayoutMarshaller
+	virtual void SetText(const FString& SourceString, FTextLayout& TargetTextLayout) override;
+	virtual void GetText(FString& TargetString, const FTextLayout& SourceTextLayout) override;
+	//~ End ITextLayoutMarshaller
+
+	/** Highlighter of the current language and tree, or null to show plain text */
+	void SetHighlighter(const TSharedPtr<FTreeSitterHighlighter>& InHighlighter);
+
+	/** Dirties the marshaller only if [InFirstLine, InEndLine) goes past the lines already highlighted */
+	void SetVisibleLines(const int32 InFirstLine, const int32 InEndLine);
+
+private:
+	const FTextBlockStyle& GetCaptureStyle(const uint16 InCapture);
+
+	TSharedPtr<FTreeSitterHighlighter> Highlighter;
+
+	FTextBlockStyle DefaultStyle;
+
+	/** Style of each capture of the highlights query, built on first use */
+	TMap<uint16, FTextBlockStyle> CaptureStyles;
+
+	int32 HighlightedFirstLine = 0;
+	int32 HighlightedEndLine = VisibleLinesMargin;
+};
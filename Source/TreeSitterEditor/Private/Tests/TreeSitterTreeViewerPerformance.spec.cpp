@@ -0,0 +1,75 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "Playground/STreeSitterTreeViewer.h"
+#include "Tests/TreeSitterPerformanceTest.h"
+#include "TreeSitterNode.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterTreeViewerPerformanceSpec, "TreeSitter.Performance.TreeViewer", EAutomationTestFlags::PerfFilter | EAutomationTestFlags_ApplicationContextMask)
+END_DEFINE_SPEC(FTreeSitterTreeViewerPerformanceSpec)
+
+void FTreeSitterTreeViewerPerformanceSpec::Define()
+{
+	It("should build the items of a large tree within budget", [this]()
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJavaScript(200));
+
+		const FTreeSitterParser Parser;
+		Parser.SetLanguage(ETreeSitterLanguage::JavaScript);
+		TSTree* Tree = Parser.Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		if (!TestNotNull(TEXT("Tree"), Tree))
+		{
+			return;
+		}
+
+		TArray<TSharedPtr<FTreeSitterNode>> TreeItems;
+		UE::TreeSitter::Tests::TestPerformance(*this, TEXT("TreeViewer.BuildItems"), [&TreeItems, Tree]()
+		{
+			STreeSitterTreeViewer::BuildTreeItems(ts_tree_root_node(Tree), TreeItems);
+		});
+
+		TestEqual(TEXT("Root items"), TreeItems.Num(), 1);
+		ts_tree_delete(Tree);
+	});
+
+	It("should build the items of a tree in linear time", [this]()
+	{
+		const FTreeSitterParser Parser;
+		Parser.SetLanguage(ETreeSitterLanguage::JavaScript);
+
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJavaScript(50));
+		const TSharedRef<const FTreeSitterSource> LargerSource = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateJavaScript(50 * UE::TreeSitter::Tests::ScalingInputFactor));
+		TSTree* Tree = Parser.Parse(Source->GetUTF8(), Source->GetUTF8Length());
+		TSTree* LargerTree = Parser.Parse(LargerSource->GetUTF8(), LargerSource->GetUTF8Length());
+		if (TestNotNull(TEXT("Tree"), Tree) && TestNotNull(TEXT("Larger tree"), LargerTree))
+		{
+			// Items are allocated by the engine and not by tree-sitter, so only the time tells about the scaling here
+			TArray<TSharedPtr<FTreeSitterNode>> TreeItems;
+			UE::TreeSitter::Tests::TestLinearScaling(*this, TEXT("TreeViewer.BuildItems.Scaling"), [&TreeItems, Tree]()
+			{
+				STreeSitterTreeViewer::BuildTreeItems(ts_tree_root_node(Tree), TreeItems);
+			}, [&TreeItems, LargerTree]()
+			{
+				STreeSitterTreeViewer::BuildTreeItems(ts_tree_root_node(LargerTree), TreeItems);
+			});
+		}
+
+		if (Tree)
+		{
+			ts_tree_delete(Tree);
+		}
+		if (LargerTree)
+		{
+			ts_tree_delete(LargerTree);
+		}
+	});
+}
+
+#endif
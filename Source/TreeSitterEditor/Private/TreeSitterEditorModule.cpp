@@ -0,0 +1,424 @@
+﻿// Copyright 2024 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterEditorModule.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Docking/TabManager.h"
+#include "HAL/IConsoleManager.h"
+#include "ITreeSitterModule.h"
+#include "Modules/ModuleManager.h"
+#include "Playground/STreeSitterMarkdownPlayground.h"
+#include "Playground/STreeSitterPlayground.h"
+#include "Styling/AppStyle.h"
+#include "TreeSitterMemory.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/SWindow.h"
+#include "tree_sitter/api.h"
+
+#define LOCTEXT_NAMESPACE "TreeSitter"
+
+void FTreeSitterEditorModule::StartupModule()
+{
+	UE::TreeSitter::InstallAllocator();
+	RegisterConsoleCommands();
+}
+
+void FTreeSitterEditorModule::ShutdownModule()
+{
+	UnregisterConsoleCommands();
+	SlateWindows.Reset();
+}
+
+void FTreeSitterEditorModule::RegisterConsoleCommands()
+{
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("TreeSitter.Test"),
+		TEXT("Prints out a simple test case AST"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FTreeSitterEditorModule::ExecuteTestCommand),
+		ECVF_Default
+	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("TreeSitter.Playground"),
+		TEXT("Opens the slate widget for testing"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FTreeSitterEditorModule::ExecuteWidgetCommand),
+		ECVF_Default
+	));
+
+	ConsoleCommands.Add(IConsoleManager::Get().RegisterConsoleCommand(
+		TEXT("TreeSitter.GenerateMarkdownSlateWidget"),
+		TEXT("Opens the slate widget for testing"),
+		FConsoleCommandWithArgsDelegate::CreateRaw(this, &FTreeSitterEditorModule::ExecuteGenerateMarkdownSlateWidgetCommand),
+		ECVF_Default
+	));
+}
+
+void FTreeSitterEditorModule::ExecuteTestCommand(const TArray<FString>& InArgs) const
+{
+	CheckTreeSitter();
+	CheckTreeSitterMarkdown();
+}
+
+void FTreeSitterEditorModule::ExecuteGenerateMarkdownSlateWidgetCommand(const TArray<FString>& InArgs)
+{
+	const FVector2f WindowSize(850.f, 650.f);
+
+	const FText Title = LOCTEXT("WindowTitle", "TreeSitter Playground");
+
+	const TSharedRef<SWidget> ContentWidget = SNew(STreeSitterMarkdownPlayground);
+	const TSharedPtr<SWindow> Window = OpenWindow(ContentWidget, Title, WindowSize);
+	Window->SetOnWindowClosed(FOnWindowClosed::CreateRaw(this, &FTreeSitterEditorModule::HandleWindowClosed));
+	SlateWindows.Add(Window);
+}
+
+TSharedPtr<SWindow> FTreeSitterEditorModule::OpenWindow(const TSharedRef<SWidget>& InWidgetContent, const FText& InTitle, const FVector2f& InWindowSize)
+{
+	TSharedPtr<SWindow> Window = SNew(SWindow)
+		.Title(InTitle)
+		.HasCloseButton(true)
+		.SupportsMaximize(false)
+		.SupportsMinimize(false)
+		.SupportsTransparency(EWindowTransparency::PerWindow)
+		.InitialOpacity(1.f)
+		.AutoCenter(EAutoCenter::PreferredWorkArea)
+		.ClientSize(InWindowSize)
+		[
+			SNew(SBorder)
+			.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
+			[
+				SNew(SVerticalBox)
+				+SVerticalBox::Slot()
+				.FillHeight(1)
+				[
+					InWidgetContent
+				]
+			]
+		];
+
+	Window->SetOnWindowClosed(FOnWindowClosed::CreateRaw(this, &FTreeSitterEditorModule::HandleWindowClosed));
+
+	if (FGlobalTabmanager::Get()->GetRootWindow().IsValid())
+	{
+		FSlateApplication::Get().AddWindowAsNativeChild(Window.ToSharedRef(), FGlobalTabmanager::Get()->GetRootWindow().ToSharedRef());
+	}
+	else
+	{
+		FSlateApplication::Get().AddWindow(Window.ToSharedRef());
+	}
+
+	return Window;
+}
+
+void FTreeSitterEditorModule::HandleWindowClosed(const TSharedRef<SWindow>& InWindow)
+{
+	SlateWindows.RemoveAll([InWindow](const TSharedPtr<SWindow>& Window)
+	{
+		return Window == InWindow;
+	});
+}
+
+void FTreeSitterEditorModule::UnregisterConsoleCommands()
+{
+	for (IConsoleCommand* ConsoleCommand : ConsoleCommands)
+	{
+		IConsoleManager::Get().UnregisterConsoleObject(ConsoleCommand);
+	}
+
+	ConsoleCommands.Empty();
+}
+
+void FTreeSitterEditorModule::ExecuteWidgetCommand(const TArray<FString>& InArgs)
+{
+	const FVector2f WindowSize(1280.f, 1080.f);
+
+	const FText Title = LOCTEXT("WindowTitle", "TreeSitter Playground");
+
+	const TSharedRef<SWidget> ContentWidget = SNew(STreeSitterPlayground);
+	const TSharedPtr<SWindow> Window = OpenWindow(ContentWidget, Title, WindowSize);
+	Window->SetOnWindowClosed(FOnWindowClosed::CreateRaw(this, &FTreeSitterEditorModule::HandleWindowClosed));
+	SlateWindows.Add(Window);
+}
+
+void FTreeSitterEditorModule::CheckTreeSitter() const
+{
+	// Create a parser.
+	TSParser* Parser = ts_parser_new();
+
+	// Set the parser's language (JSON in this case).
+	ts_parser_set_language(Parser, ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::Json)());
+
+	// Build a syntax tree based on source code stored in a string.
+	const char* SourceCode = "[1, null]";
+	TSTree* Tree = ts_parser_parse_string(
+		Parser,
+		nullptr,
+		SourceCode,
+		strlen(SourceCode)
+	);
+
+	check(Tree);
+
+	// Get the root node of the syntax tree.
+	const TSNode RootNode = ts_tree_root_node(Tree);
+
+	// Get some child nodes.
+	const TSNode ArrayNode = ts_node_named_child(RootNode, 0);
+	const TSNode NumberNode = ts_node_named_child(ArrayNode, 0);
+
+	// Check that the nodes have the expected types.
+	check(strcmp(ts_node_type(RootNode), "document") == 0);
+	check(strcmp(ts_node_type(ArrayNode), "array") == 0);
+	check(strcmp(ts_node_type(NumberNode), "number") == 0);
+
+	// Check that the nodes have the expected child counts.
+	check(ts_node_child_count(RootNode) == 1);
+	check(ts_node_child_count(ArrayNode) == 5);
+	check(ts_node_named_child_count(ArrayNode) == 2);
+	check(ts_node_child_count(NumberNode) == 0);
+
+	UE_LOG(LogTemp, Display, TEXT("Tree pointer: %p"), Tree)
+	UE_LOG(LogTemp, Display, TEXT("InParser pointer: %p"), Parser)
+
+	// Print the syntax tree as an S-expression.
+	char* String = ts_node_string(RootNode);
+	UE_LOG(LogTemp, Display, TEXT("Syntax tree: %hs"), String);
+
+	// Free all the heap-allocated memory.
+	UE::TreeSitter::Free(String);
+	ts_tree_delete(Tree);
+	ts_parser_delete(Parser);
+}
+
+void FTreeSitterEditorModule::CheckTreeSitterMarkdown() const
+{
+	// Create a parser.
+	TSParser* Parser = ts_parser_new();
+
+	// Set the parser's language (JSON in this case).
+	ts_parser_set_language(Parser, ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::Markdown)());
+
+	// Build a syntax tree based on source code stored in a string.
+	const char* Markdown = R"_Markdown(# Heading 1
+
+Yo, is it okay like this ?
+
+And what about **this** ?
+
+## Heading 2
+
+Yo
+
+Here is a list of items:
+
+- Foo
+- Bar
+- Baz is *Foobar* and ***foo*** 
+
+
+## Heading 2
+
+What about code blocks
+
+### Heading 3
+
+Some code
+
+```cpp
+FString Foo = TEXT("Foo");
+```
+
+---
+
+Bottom line after HR
+)_Markdown";
+
+	TSTree* Tree = ts_parser_parse_string(
+		Parser,
+		nullptr,
+		Markdown,
+		strlen(Markdown)
+	);
+
+	check(Tree);
+
+	// Double parse shenanigans
+	// https://tree-sitter.github.io/tree-sitter/using-parsers/3-advanced-parsing.html#multi-language-documents
+	// https://github.com/tree-sitter-grammars/tree-sitter-markdown#standalone-usage
+
+	// Find ranges of inline nodes
+	// Get the root node of the syntax tree.
+	const TSNode RootNode = ts_tree_root_node(Tree);
+
+	TArray<TSRange> Ranges;
+	GetInlineTSRanges(RootNode, Ranges);
+
+	ts_parser_set_language(Parser, ITreeSitterModule::Get().GetLanguageParser(ETreeSitterLanguage::MarkdownInline)());
+	const bool bSuccessParse = ts_parser_set_included_ranges(Parser, Ranges.GetData(), Ranges.Num());
+	// constexpr bool bSuccessParse = false;
+	TSTree* InlineTree = ts_parser_parse_string(Parser, nullptr, Markdown, strlen(Markdown));
+	
+	const TSNode InlineRootNode = ts_tree_root_node(InlineTree);
+	
+	DebugASTNodeInfo(Markdown, RootNode);
+	
+	UE_LOG(LogTemp, Display, TEXT("--- DebugASTNodeInfo below InlineRootNode - SuccessParse: %s"), *LexToString(bSuccessParse));
+	DebugASTNodeInfo(Markdown, InlineRootNode);
+
+	// Free all the heap-allocated memory.
+	ts_tree_delete(InlineTree);
+	ts_tree_delete(Tree);
+	ts_parser_delete(Parser);
+}
+
+FString FTreeSitterEditorModule::GetNodeTextForRanges(const FString& InSource, const TSPoint& InStartPoint, const TSPoint& InEndPoint)
+{
+	FString LocalSource = InSource;
+
+	TArray<FString> Lines;
+	InSource.ParseIntoArray(Lines, TEXT("\n"), false);
+
+	const int32 StartRow = InStartPoint.row;
+	const int32 StartColumn = InStartPoint.column;
+
+	const int32 EndRow = InEndPoint.row;
+	const int32 EndColumn = InEndPoint.column;
+
+	if (!Lines.IsValidIndex(StartRow) || !Lines.IsValidIndex(EndRow))
+	{
+		return {};
+	}
+
+	const FString StartLine = Lines[StartRow];
+	FString EndLine = Lines[EndRow];
+
+	const int32 Count = StartLine.Len() - EndColumn;
+	return StartLine.Mid(StartColumn, Count);
+}
+
+bool FTreeSitterEditorModule::GetInlineTSRanges(const TSNode& InNode, TArray<TSRange>& OutRanges)
+{
+	if (strcmp(ts_node_type(InNode), "inline") == 0)
+	{
+		OutRanges.Add(TSRange({
+			.start_point = ts_node_start_point(InNode),
+			.end_point = ts_node_end_point(InNode),
+			.start_byte = ts_node_start_byte(InNode),
+			.end_byte = ts_node_end_byte(InNode)
+		}));
+	}
+	
+	const uint32 ChildCount = ts_node_child_count(InNode);
+	// has children?
+	if (ChildCount <= 0)
+	{
+		return false;
+	}
+
+	// TODO: Pretty sure I'd have to recursively search for those, inline nodes in inline nodes possible ?
+	for (uint32 i = 0; i < ChildCount; ++i)
+	{
+		const TSNode CurrentNode = ts_node_child(InNode, i);
+		if (const uint32_t ChildChildCount = ts_node_child_count(CurrentNode); ChildChildCount > 0)
+		{
+			GetInlineTSRanges(CurrentNode, OutRanges);
+			continue;
+		}
+			
+		if (strcmp(ts_node_type(CurrentNode), "inline") == 0)
+		{
+			OutRanges.Add(TSRange({
+				.start_point = ts_node_start_point(CurrentNode),
+				.end_point = ts_node_end_point(CurrentNode),
+				.start_byte = ts_node_start_byte(CurrentNode),
+				.end_byte = ts_node_end_byte(CurrentNode)
+			}));
+		}
+	}
+
+	return true;
+}
+
+void FTreeSitterEditorModule::DebugASTNodeInfo(const FString& InSource, const TSNode& InNode, const FString& InPadding)
+{
+	constexpr bool bDisplayExpression = false;
+	auto DebugNode = [InPadding, InSource](const TSNode& Node, const FString& InPrefix = TEXT(""))
+	{
+		const FString NodeType = ts_node_type(Node);
+		char* NodeStringUTF8 = ts_node_string(Node);
+		const FString NodeString = UTF8_TO_TCHAR(NodeStringUTF8);
+		UE::TreeSitter::Free(NodeStringUTF8);
+		const TSSymbol NodeSymbol = ts_node_symbol(Node);
+		// const TSSymbol NodeSymbol = ts_node_grammar_symbol(Node);
+
+		const TSPoint StartPoint = ts_node_start_point(Node);
+		const TSPoint EndPoint = ts_node_end_point(Node);
+
+		if (bDisplayExpression)
+		{
+			UE_LOG(LogTemp, Display, TEXT("%s[%d]%s%s - %s"), *InPrefix, NodeSymbol, *InPadding, *NodeType, *NodeString);
+		}
+		else
+		{
+			UE_LOG(
+				LogTemp,
+				Display,
+				TEXT("%s[%d]%s%s ; [%d, %d] - [%d, %d] - %s"),
+				*InPrefix,
+				NodeSymbol,
+				*InPadding,
+				*NodeType,
+				StartPoint.row,
+				StartPoint.column,
+				EndPoint.row,
+				EndPoint.column,
+				*GetNodeTextForRanges(InSource, StartPoint, EndPoint)
+			);
+		}
+	};
+	
+	// if (strcmp(NodeType, "inline") == 0)
+	// {
+	// 	UE_LOG(LogTemp, Display, TEXT("INLINE"), *InPadding, NodeType, *NodeString);
+	// 	return;
+	// }
+	
+	// has children?
+	const uint32 ChildCount = ts_node_child_count(InNode);
+	if (ChildCount <= 0)
+	{
+		// For leaf nodes (no children), print the text content
+		DebugNode(InNode);
+		return;
+	}
+
+	DebugNode(InNode, TEXT(""));
+	for (uint32 i = 0; i < ChildCount; i++)
+	{
+		TSNode ChildNode = ts_node_child(InNode, i);
+		const char* ChildType = ts_node_type(ChildNode);
+		// const TSSymbol ChildSymbol = ts_node_symbol(ChildNode);
+		const TSSymbol ChildSymbol = ts_node_grammar_symbol(ChildNode);
+		
+		// UE_LOG(LogTemp, Display, TEXT("\t %hs (%hs)"), ChildType, ts_node_string(ChildNode));
+
+		// if (strcmp(ChildType, "inline") == 0)
+		// {
+		// 	continue;
+		// }
+
+		if (const uint32_t ChildChildCount = ts_node_child_count(ChildNode); ChildChildCount > 0)
+		{
+			DebugASTNodeInfo(InSource, ChildNode, InPadding + TEXT("\t"));
+		}
+		else
+		{
+			// For leaf nodes (no children), print the text content
+			DebugNode(ChildNode);
+		}
+	}
+}
+
+IMPLEMENT_MODULE(FTreeSitterEditorModule, TreeSitterEditor);
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,54 @@
+﻿// Copyright 2024 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Internationalization/Text.h"
+#include "Math/Vector2D.h"
+#include "Modules/ModuleInterface.h"
+
+class SWidget;
+class SWindow;
+struct IConsoleCommand;
+struct TSNode;
+struct TSPoint;
+struct TSRange;
+
+/** Editor only tooling on top of the runtime module: playground windows and debug console commands */
+class FTreeSitterEditorModule : public IModuleInterface
+{
+public:
+	//~ Begin IModuleInterface
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+	//~ End IModuleInterface
+
+private:
+	/** References of registered console commands via IConsoleManager */
+	TArray<IConsoleCommand*> ConsoleCommands;
+	
+	/** Reference to opened slate widget windows */
+	TArray<TSharedPtr<SWindow>> SlateWindows;
+
+	/** Called from StartupModule and sets up console commands for the plugin via IConsoleManager */
+	void RegisterConsoleCommands();
+	
+	/** Called from ShutdownModule and clears out previously registered console commands */
+	void UnregisterConsoleCommands();
+	
+	void ExecuteWidgetCommand(const TArray<FString>& InArgs);
+	void ExecuteTestCommand(const TArray<FString>& InArgs) const;
+	
+	void ExecuteGenerateMarkdownSlateWidgetCommand(const TArray<FString>& InArgs);
+	
+	TSharedPtr<SWindow> OpenWindow(const TSharedRef<SWidget>& InWidgetContent, const FText& InTitle = FText::GetEmpty(), const FVector2f& InWindowSize = FVector2f(1280.f, 1080.f));
+	void HandleWindowClosed(const TSharedRef<SWindow>& InWindow);
+	
+	void CheckTreeSitter() const;
+	void CheckTreeSitterMarkdown() const;
+
+	static FString GetNodeTextForRanges(const FString& InSource, const TSPoint& InStartPoint, const TSPoint& InEndPoint);
+
+	static bool GetInlineTSRanges(const TSNode& InNode, TArray<TSRange>& OutRanges);
+	
+	static void DebugASTNodeInfo(const FString& InSource, const TSNode& InNode, const FString& InPadding = TEXT(""));
+};
@@ -0,0 +1,27 @@
+﻿// Copyright 2024 Mickael Daniel. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class TreeSitterEditor : ModuleRules
+{
+	public TreeSitterEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"InputCore",
+				"Json",
+				"Projects",
+				"Slate",
+				"SlateCore",
+				"TreeSitter",
+				"TreeSitterLibrary", 
+				"TreeSitterMarkdown",
+				"UnrealEd",
+			}
+		);
+	}
+}
@@ -0,0 +1,44 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "STreeSitterMarkdownBlockquote.h"
+
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/SBoxPanel.h"
+
+STreeSitterMarkdownBlockquote::~STreeSitterMarkdownBlockquote()
+{
+}
+
+void STreeSitterMarkdownBlockquote::Construct(const FArguments& InArgs)
+{
+	const FColor BorderColor = FColor::FromHex(TEXT("#3d444d"));
+	const FColor TextColor = FColor::FromHex(TEXT("#9198a1"));
+	
+	ChildSlot
+	[
+		SNew(SHorizontalBox)
+
+		+ SHorizontalBox::Slot()
+		// .MinWidth(1.f)
+		.AutoWidth()
+		.Padding(0.f, 0.f, 8.f, 0.f)
+		[
+			SNew(SBorder)
+			.BorderImage(FAppStyle::GetBrush("ErrorReporting.Box"))
+			.BorderBackgroundColor(BorderColor)
+		]
+		+ SHorizontalBox::Slot()
+		// .FillWidth(1.f)
+		.VAlign(VAlign_Bottom)
+		// .Padding(0.f, 8.f)
+		[
+			SNew(SBorder)
+			.BorderImage(FAppStyle::GetBrush("NoBorder"))
+			.ColorAndOpacity(FLinearColor(TextColor))
+			.Padding(FMargin(0.f, 8.f, 0.f, 0.f))
+			[
+				InArgs._Content.Widget
+			]
+		]
+	];
+}
@@ -0,0 +1,22 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+
+class STreeSitterMarkdownBlockquote : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STreeSitterMarkdownBlockquote)
+		{
+		}
+
+		/** Quoted blocks */
+		SLATE_DEFAULT_SLOT(FArguments, Content)
+
+	SLATE_END_ARGS()
+	
+	virtual ~STreeSitterMarkdownBlockquote() override;
+
+	void Construct(const FArguments& InArgs);
+};
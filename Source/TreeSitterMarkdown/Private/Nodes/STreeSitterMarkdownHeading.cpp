@@ -2,61 +2,19 @@
 
 #include "STreeSitterMarkdownHeading.h"
 
-#include "Components/VerticalBox.h"
-#include "Markdown/TreeSitterSlateMarkdown.h"
-#include "TreeSitterNode.h"
+#include "TreeSitterMarkdownRenderModel.h"
 #include "Widgets/Layout/SBorder.h"
+#include "Widgets/SBoxPanel.h"
 #include "Widgets/Text/STextBlock.h"
 
-#define LOCTEXT_NAMESPACE "TreeSitter"
-
 STreeSitterMarkdownHeading::~STreeSitterMarkdownHeading()
 {
 }
 
-void STreeSitterMarkdownHeading::Construct(const FArguments& InArgs, const TSharedRef<FTreeSitterNode>& InNode)
+void STreeSitterMarkdownHeading::Construct(const FArguments& InArgs, const FTreeSitterMarkdownRenderBlock& InBlock)
 {
-	using namespace UE::TreeSitter;
-
-	const TSNode& TreeNode = InNode->Node;
-	if (ts_node_is_null(TreeNode))
-	{
-		ChildSlot
-		[
-
-			SNew(STextBlock)
-			.Text(FText::Format(LOCTEXT("InvalidTreeNode", "Tree node is invalid for: {0}"), FText::FromName(InNode->NodeType)))
-		];
-		return;
-	}
-	
-	const FString OriginalSource = InArgs._InitialMarkdown;
-	const FString Text = OriginalSource.Mid(InNode->StartByte, InNode->EndByte - InNode->StartByte);
-	
-	// const FString Text = UE::TreeSitter::ExtractNodeText(InNode, InArgs._InitialMarkdown);
-	// Extract heading level
-
-	// Get first child, which is expected to be an atx_h[1-6]_marker
-	const TSNode HeadingMarkerNode = ts_node_child(TreeNode, 0);
-	int32 HeadingLevel = 1;
-
-	if (!ts_node_is_null(HeadingMarkerNode))
-	{
-		// Try to extract the heading level info out of the marker type:
-		// atx_h1_marker => H1
-		// atx_h2_marker => H2
-		// etc.
-		const FString HeadingNodeType = FString(ts_node_type(HeadingMarkerNode));
-		const FString HeadingLevelString = HeadingNodeType.Mid(5, 1);
-		HeadingLevel = FCString::Atoi(*HeadingLevelString);
-	}
-
-	// Extract inner heading_content text
-	constexpr const TCHAR* FieldNameKey = TEXT("heading_content");
-	const char* FieldName = TCHAR_TO_UTF8(FieldNameKey);
-
-	const TSNode HeadingContentNode = ts_node_child_by_field_name(TreeNode, FieldName, strlen(FieldName));
-	const FString Content = ts_node_is_null(HeadingContentNode) ? TEXT("") : ExtractNodeText(HeadingContentNode, OriginalSource);
+	const int32 HeadingLevel = InBlock.HeadingLevel;
+	const FString& Content = InBlock.Text;
 
 	const FString FontName = FPaths::EngineContentDir() / TEXT("Slate/Fonts/Roboto-Bold.ttf");
 
@@ -154,5 +112,3 @@ void STreeSitterMarkdownHeading::Construct(const FArguments& InArgs, const TShar
 		TextBlock
 	];
 }
-
-#undef LOCTEXT_NAMESPACE
\ No newline at end of file
@@ -0,0 +1,21 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+
+struct FTreeSitterMarkdownRenderBlock;
+
+class STreeSitterMarkdownHeading : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STreeSitterMarkdownHeading)
+		{
+		}
+
+	SLATE_END_ARGS()
+
+	virtual ~STreeSitterMarkdownHeading() override;
+
+	void Construct(const FArguments& InArgs, const FTreeSitterMarkdownRenderBlock& InBlock);
+};
@@ -0,0 +1,44 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "STreeSitterMarkdownParagraph.h"
+
+#include "Framework/Text/SlateHyperlinkRun.h"
+#include "TreeSitterMarkdownInline.h"
+#include "TreeSitterMarkdownRenderModel.h"
+#include "Widgets/Text/SRichTextBlock.h"
+
+namespace UE::TreeSitter::Private
+{
+	static void OnMarkdownLinkClicked(const FSlateHyperlinkRun::FMetadata& InMetadata)
+	{
+		const FString* Url = InMetadata.Find(TEXT("href"));
+		if (!Url)
+		{
+			return;
+		}
+
+		// Documents are not trusted, only open what a browser would
+		if (Url->StartsWith(TEXT("https://")) || Url->StartsWith(TEXT("http://")) || Url->StartsWith(TEXT("mailto:")))
+		{
+			FPlatformProcess::LaunchURL(**Url, nullptr, nullptr);
+		}
+	}
+}
+
+STreeSitterMarkdownParagraph::~STreeSitterMarkdownParagraph()
+{
+}
+
+void STreeSitterMarkdownParagraph::Construct(const FArguments& InArgs, const FTreeSitterMarkdownRenderBlock& InBlock)
+{
+	// The whole paragraph is a single text layout, inline nodes only became runs within it
+	ChildSlot
+	[
+		SNew(SRichTextBlock)
+		.Text(FText::FromString(InBlock.RichText))
+		.TextStyle(FAppStyle::Get(), "NormalText")
+		.DecoratorStyleSet(&FAppStyle::Get())
+		.AutoWrapText(true)
+		+ SRichTextBlock::HyperlinkDecorator(UE::TreeSitter::MarkdownLinkDecoratorId, FSlateHyperlinkRun::FOnClick::CreateStatic(&UE::TreeSitter::Private::OnMarkdownLinkClicked))
+	];
+}
@@ -0,0 +1,103 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "STreeSitterMarkdownTable.h"
+
+#include "TreeSitterMarkdownRenderModel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "Widgets/Views/SListView.h"
+
+void STreeSitterMarkdownTableRow::Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& InOwnerTableView, const TSharedPtr<FTreeSitterMarkdownTableListItem>& InListItem)
+{
+	ListItem = InListItem;
+	SMultiColumnTableRow::Construct(
+		FSuperRowType::FArguments().Padding(1.0f),
+		InOwnerTableView
+	);
+}
+
+TSharedRef<SWidget> STreeSitterMarkdownTableRow::GenerateWidgetForColumn(const FName& InColumnName)
+{
+	TSharedRef<SBox> BoxWrapper = SNew(SBox)
+		.Padding(FMargin(4.0f, 0.0f))
+		.VAlign(VAlign_Center);
+
+	const FTreeSitterMarkdownTable& Table = *ListItem->Table;
+	const int32 ColumnIndex = InColumnName.GetNumber();
+	if (ColumnIndex < Table.ColumnCount)
+	{
+		BoxWrapper->SetContent(SNew(STextBlock)
+			.Text(FText::FromStringView(Table.GetCell(ListItem->Row, ColumnIndex)))
+			.ToolTipText(FText::FromStringView(Table.GetCell(0, ColumnIndex)))
+		);
+	}
+
+	return BoxWrapper;
+}
+
+STreeSitterMarkdownTable::~STreeSitterMarkdownTable()
+{
+}
+
+void STreeSitterMarkdownTable::Construct(const FArguments& InArgs, const FTreeSitterMarkdownRenderBlock& InBlock)
+{
+	const int32 ColumnCount = InBlock.Table.ColumnCount;
+	if (ColumnCount <= 0)
+	{
+		return;
+	}
+
+	// Shared by every row, cells are only turned into text by the visible rows
+	const TSharedRef<const FTreeSitterMarkdownTable> Table = MakeShared<FTreeSitterMarkdownTable>(InBlock.Table);
+
+	const TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow);
+
+	// First row of cells is the header, each one being a column
+	for (int32 ColumnIndex = 0; ColumnIndex < ColumnCount; ColumnIndex++)
+	{
+		const SHeaderRow::FColumn::FArguments Column = SHeaderRow::Column(GetColumnId(ColumnIndex))
+			.DefaultLabel(FText::FromStringView(Table->GetCell(0, ColumnIndex)))
+			.FillWidth(0.2f);
+
+		HeaderRow->AddColumn(Column);
+	}
+
+	// Any row coming after is a list item
+	ListItems.Reset(Table->GetRowCount());
+	for (int32 Row = 1; Row < Table->GetRowCount(); Row++)
+	{
+		TSharedPtr<FTreeSitterMarkdownTableListItem> Item = MakeShared<FTreeSitterMarkdownTableListItem>();
+		Item->Table = Table;
+		Item->Row = Row;
+		ListItems.Add(Item);
+	}
+
+	ChildSlot
+	[
+		SAssignNew(ListView, SListView<TSharedPtr<FTreeSitterMarkdownTableListItem>>)
+		.ListItemsSource(&ListItems)
+		.HeaderRow(HeaderRow)
+		.OnGenerateRow(this, &STreeSitterMarkdownTable::GenerateRow)
+	];
+}
+
+FName STreeSitterMarkdownTable::GetColumnId(const int32 InColumnIndex)
+{
+	return FName(TEXT("Column"), InColumnIndex);
+}
+
+TSharedRef<ITableRow> STreeSitterMarkdownTable::GenerateRow(TSharedPtr<FTreeSitterMarkdownTableListItem> InCells, const TSharedRef<STableViewBase>& TableViewBase)
+{
+	// const FString Output = FString::Join(*InCells.Get(), TEXT(" - "));
+	
+	//
+	// TSharedRef<STableRow<TSharedPtr<FString>>> TableRow = SNew(STableRow<TSharedPtr<FString>>, TableViewBase);
+	//
+	//
+	// return SNew(STableRow<TSharedPtr<FText>>, TableViewBase)
+	// 	.Padding(FMargin(16, 4, 16, 4))
+	// 	[
+	// 		SNew(STextBlock).Text(FText::FromString(Output))
+	// 	];
+
+	return SNew(STreeSitterMarkdownTableRow, TableViewBase, InCells);
+}
@@ -4,16 +4,15 @@
 
 #include "Widgets/Views/STableRow.h"
 
-class FTreeSitterParser;
 class SBorder;
-struct FTreeSitterNode;
+struct FTreeSitterMarkdownRenderBlock;
+struct FTreeSitterMarkdownTable;
 
+/** Row of a table, its cells being read from the shared table */
 struct FTreeSitterMarkdownTableListItem
 {
-	// FName ColumnName;
-	// FString CellContent;
-
-	TMap<FName, FString> ColumnNamesToCellContent;
+	TSharedPtr<const FTreeSitterMarkdownTable> Table;
+	int32 Row = 0;
 };
 
 class STreeSitterMarkdownTableRow : public SMultiColumnTableRow<TSharedPtr<FString>>
@@ -41,19 +40,17 @@ public:
 		{
 		}
 
-		SLATE_ARGUMENT(FString, InitialMarkdown)
-
 	SLATE_END_ARGS()
 
 	virtual ~STreeSitterMarkdownTable() override;
 
-	void Construct(const FArguments& InArgs, const TSharedRef<FTreeSitterNode>& InNode);
+	void Construct(const FArguments& InArgs, const FTreeSitterMarkdownRenderBlock& InBlock);
 
-	// Static method to create an instance, used by the custom widget registry
-	static TSharedRef<SWidget> MakeInstance(const TSharedRef<FTreeSitterNode>& InNode, const FString& InSource)
-	{
-		return SNew(STreeSitterMarkdownTable, InNode).InitialMarkdown(InSource);
-	}
+	/**
+	 * Column ids are "Column" numbered by index, so that arbitrary header text never ends up in the name table.
+	 * FName(TEXT("Column"), Index).GetNumber() gives the index back.
+	 */
+	static FName GetColumnId(const int32 InColumnIndex);
 
 private:
 
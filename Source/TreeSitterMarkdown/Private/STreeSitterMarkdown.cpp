@@ -0,0 +1,181 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "STreeSitterMarkdown.h"
+
+#include "Async/Async.h"
+#include "TreeSitterMarkdownRenderModel.h"
+#include "TreeSitterSlateMarkdown.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/SBoxPanel.h"
+
+STreeSitterMarkdown::~STreeSitterMarkdown()
+{
+	Blocks.Reset();
+	Model.Reset();
+}
+
+void STreeSitterMarkdown::Construct(const FArguments& InArgs)
+{
+	MarkdownSource = FTreeSitterSource::Create(InArgs._InitialMarkdown);
+	bVirtualized = InArgs._Virtualized;
+
+	// List views scroll by item and only measure the rows they generate, blocks heights don't have to be known upfront
+	TSharedRef<SWidget> BlocksWidget = bVirtualized ?
+		StaticCastSharedRef<SWidget>(SAssignNew(BlocksListView, SBlockListView)
+			.ListItemsSource(&Blocks)
+			.SelectionMode(ESelectionMode::None)
+			.OnGenerateRow(this, &STreeSitterMarkdown::GenerateBlockRow)) :
+		StaticCastSharedRef<SWidget>(SAssignNew(BlocksBox, SVerticalBox));
+
+    ChildSlot
+    [
+		SAssignNew(Container, SBorder)
+		.Padding(8.f, 8.f)
+		.BorderImage(FAppStyle::GetBrush("Border"))
+		[
+			BlocksWidget
+		]
+    ];
+
+	if (InArgs._RenderModel.IsValid())
+	{
+		SetRenderModel(InArgs._RenderModel.ToSharedRef());
+		return;
+	}
+
+	RequestBuild();
+}
+
+const TSharedPtr<const FTreeSitterSource>& STreeSitterMarkdown::GetMarkdownSource() const
+{
+	return MarkdownSource;
+}
+
+void STreeSitterMarkdown::SetMarkdownSource(const FString& InMarkdownSource)
+{
+	if (MarkdownSource.IsValid() && MarkdownSource->GetText() == InMarkdownSource)
+	{
+		return;
+	}
+
+	// New buffer rather than in place, widgets built from the previous one may still reference it
+	MarkdownSource = FTreeSitterSource::Create(InMarkdownSource);
+	RequestBuild();
+}
+
+FString STreeSitterMarkdown::GetMarkdownSourceText() const
+{
+	return MarkdownSource.IsValid() ? MarkdownSource->GetText() : TEXT("");
+}
+
+void STreeSitterMarkdown::SetRenderModel(const TSharedRef<const FTreeSitterMarkdownRenderModel>& InModel)
+{
+	++LatestBuildId;
+	MarkdownSource = InModel->GetSource();
+	ApplyModel(InModel);
+}
+
+void STreeSitterMarkdown::RequestBuild()
+{
+	check(MarkdownSource.IsValid());
+
+	const uint32 BuildId = ++LatestBuildId;
+	const TWeakPtr<STreeSitterMarkdown> WeakThis = SharedThis(this);
+
+	// Parsing and extraction run on a worker, only widget creation comes back to the game thread
+	FTreeSitterMarkdownRenderModel::BuildAsync(MarkdownSource.ToSharedRef(), Model)
+		.Then([WeakThis, BuildId](TFuture<TSharedPtr<FTreeSitterMarkdownRenderModel>> InFuture)
+		{
+			TSharedPtr<FTreeSitterMarkdownRenderModel> NewModel = InFuture.Get();
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, BuildId, NewModel = MoveTemp(NewModel)]()
+			{
+				const TSharedPtr<STreeSitterMarkdown> This = WeakThis.Pin();
+				if (This.IsValid() && NewModel.IsValid() && This->LatestBuildId == BuildId)
+				{
+					This->ApplyModel(NewModel.ToSharedRef());
+				}
+			});
+		});
+}
+
+void STreeSitterMarkdown::ApplyModel(const TSharedRef<const FTreeSitterMarkdownRenderModel>& InModel)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(STreeSitterMarkdown::ApplyModel);
+	CSV_SCOPED_TIMING_STAT(TreeSitter, MarkdownGenerateWidgets);
+	check(IsInGameThread());
+	Model = InModel;
+
+	// Blocks of the previous pass, up for grabs by any new block with the same key (duplicated blocks included)
+	TMultiMap<uint64, TSharedPtr<FTreeSitterMarkdownBlock>> ReusableBlocks;
+	ReusableBlocks.Reserve(Blocks.Num());
+	for (const TSharedPtr<FTreeSitterMarkdownBlock>& Block : Blocks)
+	{
+		ReusableBlocks.Add(Block->Key, Block);
+	}
+
+	Blocks.Reset();
+	Blocks.Reserve(InModel->GetBlocks().Num());
+
+	for (const FTreeSitterMarkdownRenderBlock& RenderBlock : InModel->GetBlocks())
+	{
+		TSharedPtr<FTreeSitterMarkdownBlock> Block;
+		if (const TSharedPtr<FTreeSitterMarkdownBlock>* ReusableBlock = ReusableBlocks.Find(RenderBlock.Key))
+		{
+			Block = *ReusableBlock;
+			ReusableBlocks.RemoveSingle(RenderBlock.Key, Block);
+		}
+		else
+		{
+			Block = MakeShared<FTreeSitterMarkdownBlock>();
+			Block->Key = RenderBlock.Key;
+		}
+
+		Block->RenderBlock = &RenderBlock;
+		Blocks.Add(Block);
+	}
+
+	if (bVirtualized)
+	{
+		// Reused blocks are the same items, the list view keeps their rows around
+		BlocksListView->RequestListRefresh();
+		return;
+	}
+
+	int32 RebuiltCount = 0;
+	BlocksBox->ClearChildren();
+	for (const TSharedPtr<FTreeSitterMarkdownBlock>& Block : Blocks)
+	{
+		RebuiltCount += Block->Widget.IsValid() ? 0 : 1;
+
+		BlocksBox->AddSlot()
+		.AutoHeight()
+		[
+			GetOrCreateBlockWidget(*Block)
+		];
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("STreeSitterMarkdown: rebuilt %d out of %d blocks"), RebuiltCount, Blocks.Num());
+}
+
+TSharedRef<SWidget> STreeSitterMarkdown::GetOrCreateBlockWidget(FTreeSitterMarkdownBlock& InBlock) const
+{
+	if (!InBlock.Widget.IsValid())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(STreeSitterMarkdown::CreateBlockWidget);
+		check(Model.IsValid() && InBlock.RenderBlock);
+		InBlock.Widget = UE::TreeSitter::MakeMarkdownBlockWidget(*InBlock.RenderBlock, *Model);
+	}
+
+	return InBlock.Widget.ToSharedRef();
+}
+
+TSharedRef<ITableRow> STreeSitterMarkdown::GenerateBlockRow(TSharedPtr<FTreeSitterMarkdownBlock> InBlock, const TSharedRef<STableViewBase>& InOwnerTable) const
+{
+	return SNew(STableRow<TSharedPtr<FTreeSitterMarkdownBlock>>, InOwnerTable)
+		.ShowSelection(false)
+		[
+			GetOrCreateBlockWidget(*InBlock)
+		];
+}
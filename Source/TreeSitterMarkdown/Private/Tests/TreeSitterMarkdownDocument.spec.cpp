@@ -0,0 +1,79 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterMarkdownDocument.h"
+#include "TreeSitterMemory.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+BEGIN_DEFINE_SPEC(FTreeSitterMarkdownDocumentSpec, "TreeSitter.TreeSitterMarkdownDocument", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+END_DEFINE_SPEC(FTreeSitterMarkdownDocumentSpec)
+
+void FTreeSitterMarkdownDocumentSpec::Define()
+{
+	Describe("Injections", [this]()
+	{
+		It("should parse inline ranges and fenced code blocks with their own grammar", [this]()
+		{
+			const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(TEXT("# Title\n\nSome *inline* text\n\n```json\n[1, null]\n```\n\n```unknown\nfoo\n```\n"));
+
+			const TSharedRef<FTreeSitterMarkdownDocument> Document = FTreeSitterMarkdownDocument::Parse(Source);
+			if (!TestNotNull("Block tree", Document->GetBlockTree()))
+			{
+				return;
+			}
+
+			const TArray<FTreeSitterMarkdownInjection>& Injections = Document->GetInjections();
+
+			// Heading content, paragraph and the json code block. The unknown language is skipped.
+			TestEqual("Injection count", Injections.Num(), 3);
+
+			for (int32 Index = 1; Index < Injections.Num(); ++Index)
+			{
+				TestTrue("Injections are sorted", Injections[Index - 1].Range.start_byte < Injections[Index].Range.start_byte);
+			}
+
+			for (const FTreeSitterMarkdownInjection& Injection : Injections)
+			{
+				TestNotNull("Injection is parsed", Injection.Tree);
+			}
+
+			const FTreeSitterMarkdownInjection& CodeBlock = Injections.Last();
+			TestTrue("Code block language", CodeBlock.Language == ETreeSitterLanguage::Json);
+			if (CodeBlock.Tree)
+			{
+				TestEqual("Code block root", FString(ts_node_type(ts_tree_root_node(CodeBlock.Tree))), TEXT("document"));
+			}
+
+			TestTrue("Lookup by start byte", Document->FindInjection(CodeBlock.Range.start_byte) == &CodeBlock);
+			TestNull("Lookup misses", Document->FindInjection(CodeBlock.Range.start_byte + 1));
+		});
+
+		It("should leave block continuations out of inline injections", [this]()
+		{
+			// The second "> " belongs to the block quote, within the inline range of the paragraph
+			const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(TEXT("> Some *quoted\n> text* here\n"));
+			const TSharedRef<FTreeSitterMarkdownDocument> Document = FTreeSitterMarkdownDocument::Parse(Source);
+
+			const TArray<FTreeSitterMarkdownInjection>& Injections = Document->GetInjections();
+			if (!TestEqual("Injection count", Injections.Num(), 1) || !TestNotNull("Injection is parsed", Injections[0].Tree))
+			{
+				return;
+			}
+
+			const uint32 ContinuationByte = 15;
+			TestEqual("Included ranges", Injections[0].IncludedRanges.Num(), 2);
+			for (const TSRange& Range : Injections[0].IncludedRanges)
+			{
+				TestFalse("Continuation left out", Range.start_byte <= ContinuationByte && ContinuationByte < Range.end_byte);
+			}
+
+			uint32 TreeRangeCount = 0;
+			TSRange* TreeRanges = ts_tree_included_ranges(Injections[0].Tree, &TreeRangeCount);
+			UE::TreeSitter::Free(TreeRanges);
+			TestEqual("Parsed ranges", TreeRangeCount, 2u);
+		});
+	});
+}
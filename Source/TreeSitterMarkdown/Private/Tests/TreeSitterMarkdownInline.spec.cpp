@@ -0,0 +1,69 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterMarkdownDocument.h"
+#include "TreeSitterMarkdownInline.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+BEGIN_DEFINE_SPEC(FTreeSitterMarkdownInlineSpec, "TreeSitter.TreeSitterMarkdownInline", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	/** Depth first search for the first node of the given type */
+	static TSNode FindNode(const TSNode& InNode, const ANSICHAR* InType)
+	{
+		if (FCStringAnsi::Strcmp(ts_node_type(InNode), InType) == 0)
+		{
+			return InNode;
+		}
+
+		for (uint32 Index = 0; Index < ts_node_named_child_count(InNode); ++Index)
+		{
+			const TSNode Found = FindNode(ts_node_named_child(InNode, Index), InType);
+			if (!ts_node_is_null(Found))
+			{
+				return Found;
+			}
+		}
+
+		return TSNode();
+	}
+
+	FString MakeParagraphRichText(const FString& InMarkdown)
+	{
+		const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(InMarkdown);
+		const TSharedRef<FTreeSitterMarkdownDocument> Document = FTreeSitterMarkdownDocument::Parse(Source);
+		if (!TestNotNull("Block tree", Document->GetBlockTree()))
+		{
+			return FString();
+		}
+
+		const TSNode Paragraph = FindNode(Document->GetRootNode(), "paragraph");
+		if (!TestFalse("Paragraph found", ts_node_is_null(Paragraph)))
+		{
+			return FString();
+		}
+
+		return UE::TreeSitter::MakeMarkdownRichText(Paragraph, *Document);
+	}
+
+END_DEFINE_SPEC(FTreeSitterMarkdownInlineSpec)
+
+void FTreeSitterMarkdownInlineSpec::Define()
+{
+	Describe("MakeMarkdownRichText", [this]()
+	{
+		It("should convert inline nodes into style and hyperlink runs", [this]()
+		{
+			TestEqual("Markup",
+				MakeParagraphRichText(TEXT("Some *em*, **strong** and `code` [link](https://example.com) \\*")),
+				TEXT("Some <RichTextBlock.Italic>em</>, <RichTextBlock.Bold>strong</> and <MessageLog>code</> <a id=\"markdown\" href=\"https://example.com\">link</> *"));
+		});
+
+		It("should collapse soft line breaks and escape markup characters", [this]()
+		{
+			TestEqual("Markup", MakeParagraphRichText(TEXT("a < b\n  & c")), TEXT("a &lt; b &amp; c"));
+		});
+	});
+}
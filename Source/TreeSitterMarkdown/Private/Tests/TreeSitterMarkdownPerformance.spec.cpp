@@ -0,0 +1,58 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "Framework/Application/SlateApplication.h"
+#include "Tests/TreeSitterPerformanceTest.h"
+#include "TreeSitterMarkdownRenderModel.h"
+#include "TreeSitterSlateMarkdown.h"
+#include "TreeSitterSource.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+BEGIN_DEFINE_SPEC(FTreeSitterMarkdownPerformanceSpec, "TreeSitter.Performance.Markdown", EAutomationTestFlags::PerfFilter | EAutomationTestFlags_ApplicationContextMask)
+
+	TSharedPtr<const FTreeSitterSource> Source;
+
+END_DEFINE_SPEC(FTreeSitterMarkdownPerformanceSpec)
+
+void FTreeSitterMarkdownPerformanceSpec::Define()
+{
+	BeforeEach([this]()
+	{
+		Source = FTreeSitterSource::Create(UE::TreeSitter::Tests::GenerateMarkdown(200));
+	});
+
+	AfterEach([this]()
+	{
+		Source.Reset();
+	});
+
+	It("should build the render model of a large document within budget", [this]()
+	{
+		const TSharedRef<const FTreeSitterSource> SourceRef = Source.ToSharedRef();
+		UE::TreeSitter::Tests::TestPerformance(*this, TEXT("Markdown.BuildModel"), [&SourceRef]()
+		{
+			FTreeSitterMarkdownRenderModel::Build(SourceRef);
+		});
+	});
+
+	It("should generate the widgets of a large document within budget", [this]()
+	{
+		if (!FSlateApplication::IsInitialized())
+		{
+			AddWarning(TEXT("Slate is not initialized, skipping widget generation"));
+			return;
+		}
+
+		// Widgets are created out of an already built model, only their instantiation is measured
+		const TSharedRef<FTreeSitterMarkdownRenderModel> Model = FTreeSitterMarkdownRenderModel::Build(Source.ToSharedRef());
+		UE::TreeSitter::Tests::TestPerformance(*this, TEXT("Markdown.GenerateWidgets"), [&Model]()
+		{
+			UE::TreeSitter::GenerateMarkdownSlateWidget(*Model);
+		});
+	});
+}
+
+#endif
@@ -0,0 +1,100 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "ITreeSitterModule.h"
+#include "Misc/AutomationTest.h"
+
+#include "TreeSitterMarkdownRenderModel.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "TreeSitterSource.h"
+
+BEGIN_DEFINE_SPEC(FTreeSitterMarkdownRenderModelSpec, "TreeSitter.TreeSitterMarkdownRenderModel", EAutomationTestFlags::ProductFilter | EAutomationTestFlags_ApplicationContextMask)
+END_DEFINE_SPEC(FTreeSitterMarkdownRenderModelSpec)
+
+void FTreeSitterMarkdownRenderModelSpec::Define()
+{
+	Describe("Build", [this]()
+	{
+		It("should extract headings, paragraphs, code blocks and tables out of sections", [this]()
+		{
+			const TSharedRef<const FTreeSitterSource> Source = FTreeSitterSource::Create(TEXT("## Title\n\nSome *text*\n\n```json\n[1, null]\n```\n\n| A | B |\n| - | - |\n| 1 |\n"));
+			const TSharedRef<FTreeSitterMarkdownRenderModel> Model = FTreeSitterMarkdownRenderModel::Build(Source);
+
+			const TArray<FTreeSitterMarkdownRenderBlock>& Blocks = Model->GetBlocks();
+			if (!TestEqual("Block count", Blocks.Num(), 4))
+			{
+				return;
+			}
+
+			TestTrue("Heading kind", Blocks[0].Kind == ETreeSitterMarkdownBlockKind::Heading);
+			TestEqual("Heading level", Blocks[0].HeadingLevel, 2);
+			TestEqual("Heading text", Blocks[0].Text, TEXT("Title"));
+
+			TestTrue("Paragraph kind", Blocks[1].Kind == ETreeSitterMarkdownBlockKind::Paragraph);
+			TestEqual("Paragraph runs", Blocks[1].RichText, TEXT("Some <RichTextBlock.Italic>text</>"));
+
+			TestTrue("Code block kind", Blocks[2].Kind == ETreeSitterMarkdownBlockKind::CodeBlock);
+			TestEqual("Code block text", Blocks[2].Text, TEXT("[1, null]"));
+			TestTrue("Code block language", Blocks[2].CodeLanguage.IsSet() && Blocks[2].CodeLanguage.GetValue() == ETreeSitterLanguage::Json);
+
+			TestTrue("Table kind", Blocks[3].Kind == ETreeSitterMarkdownBlockKind::Table);
+			TestEqual("Table columns", Blocks[3].Table.ColumnCount, 2);
+			TestEqual("Table rows", Blocks[3].Table.GetRowCount(), 2);
+			TestEqual("Table cells", Blocks[3].Table.Text, TEXT("AB1"));
+			TestTrue("Table cell ends", Blocks[3].Table.CellEnds == TArray<int32>({ 1, 2, 3, 3 }));
+			TestTrue("Table cell", Blocks[3].Table.GetCell(1, 0) == TEXT("1"));
+		});
+
+		It("should give unchanged blocks the same key after an edit", [this]()
+		{
+			const TSharedRef<FTreeSitterMarkdownRenderModel> Model = FTreeSitterMarkdownRenderModel::Build(FTreeSitterSource::Create(TEXT("# A\n\nFirst\n\nSecond\n")));
+			const TSharedRef<FTreeSitterMarkdownRenderModel> EditedModel = FTreeSitterMarkdownRenderModel::Build(FTreeSitterSource::Create(TEXT("# A\n\nFirst!\n\nSecond\n")), &Model.Get());
+
+			if (!TestEqual("Block count", Model->GetBlocks().Num(), 3) || !TestEqual("Edited block count", EditedModel->GetBlocks().Num(), 3))
+			{
+				return;
+			}
+
+			TestEqual("Heading key", EditedModel->GetBlocks()[0].Key, Model->GetBlocks()[0].Key);
+			TestNotEqual("Edited paragraph key", EditedModel->GetBlocks()[1].Key, Model->GetBlocks()[1].Key);
+			TestEqual("Last paragraph key", EditedModel->GetBlocks()[2].Key, Model->GetBlocks()[2].Key);
+		});
+	});
+
+	Describe("Serialize", [this]()
+	{
+		It("should round trip blocks without document nor nodes", [this]()
+		{
+			const TSharedRef<FTreeSitterMarkdownRenderModel> Model = FTreeSitterMarkdownRenderModel::Build(FTreeSitterSource::Create(TEXT("# Notes\n\n> Quoted **text**\n\n```js\nfoo();\n```\n")));
+
+			TArray<uint8> Bytes;
+			FMemoryWriter Writer(Bytes);
+			Model->Serialize(Writer);
+
+			FTreeSitterMarkdownRenderModel LoadedModel;
+			FMemoryReader Reader(Bytes);
+			LoadedModel.Serialize(Reader);
+
+			TestFalse("Read without error", Reader.IsError());
+			TestFalse("No document", LoadedModel.GetDocument().IsValid());
+
+			const TArray<FTreeSitterMarkdownRenderBlock>& Blocks = Model->GetBlocks();
+			const TArray<FTreeSitterMarkdownRenderBlock>& LoadedBlocks = LoadedModel.GetBlocks();
+			if (!TestEqual("Block count", LoadedBlocks.Num(), Blocks.Num()) || !TestEqual("Expected block count", Blocks.Num(), 3))
+			{
+				return;
+			}
+
+			TestEqual("Heading", LoadedBlocks[0].Text, Blocks[0].Text);
+			TestEqual("Key", LoadedBlocks[0].Key, Blocks[0].Key);
+			TestTrue("Quote kind", LoadedBlocks[1].Kind == ETreeSitterMarkdownBlockKind::BlockQuote);
+			TestEqual("Quote children", LoadedBlocks[1].Children.Num(), Blocks[1].Children.Num());
+			if (LoadedBlocks[1].Children.Num() > 0)
+			{
+				TestEqual("Quote runs", LoadedBlocks[1].Children[0].RichText, Blocks[1].Children[0].RichText);
+			}
+			TestTrue("Code language", LoadedBlocks[2].CodeLanguage == Blocks[2].CodeLanguage);
+			TestTrue("No node", ts_node_is_null(LoadedBlocks[2].Node));
+		});
+	});
+}
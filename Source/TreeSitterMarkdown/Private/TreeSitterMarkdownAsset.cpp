@@ -0,0 +1,115 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterMarkdownAsset.h"
+
+#include "STreeSitterMarkdown.h"
+#include "TreeSitterMarkdownRenderModel.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Widgets/SNullWidget.h"
+
+#if WITH_EDITOR
+#include "ITreeSitterMarkdownModule.h"
+#include "TreeSitterMarkdownDocument.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "TreeSitterSource.h"
+#include "UObject/ObjectSaveContext.h"
+#endif
+
+void UTreeSitterMarkdownAsset::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+
+	// The model goes in a sized blob so that one from an older format can be skipped (and recompiled in the editor)
+	int32 Version = FTreeSitterMarkdownRenderModel::SerializationVersion;
+	TArray<uint8> CompiledModel;
+
+	if (Ar.IsSaving() && RenderModel.IsValid())
+	{
+		FMemoryWriter Writer(CompiledModel);
+		ConstCastSharedPtr<FTreeSitterMarkdownRenderModel>(RenderModel)->Serialize(Writer);
+	}
+
+	Ar << Version;
+	Ar << CompiledModel;
+
+	if (Ar.IsLoading())
+	{
+		RenderModel.Reset();
+
+		if (Version == FTreeSitterMarkdownRenderModel::SerializationVersion && !CompiledModel.IsEmpty())
+		{
+			const TSharedRef<FTreeSitterMarkdownRenderModel> LoadedModel = MakeShared<FTreeSitterMarkdownRenderModel>();
+
+			FMemoryReader Reader(CompiledModel);
+			LoadedModel->Serialize(Reader);
+			if (!Reader.IsError())
+			{
+				RenderModel = LoadedModel;
+			}
+		}
+	}
+}
+
+#if WITH_EDITOR
+void UTreeSitterMarkdownAsset::PostLoad()
+{
+	Super::PostLoad();
+
+	// Saved with an older format
+	if (!RenderModel.IsValid())
+	{
+		Compile();
+	}
+}
+
+void UTreeSitterMarkdownAsset::PreSave(FObjectPreSaveContext SaveContext)
+{
+	Super::PreSave(SaveContext);
+
+	// Source file may have changed since, the cooked model is always the latest
+	Compile();
+}
+
+void UTreeSitterMarkdownAsset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	Compile();
+}
+
+void UTreeSitterMarkdownAsset::Compile()
+{
+	FString MarkdownSource = Markdown;
+	if (!SourceFile.FilePath.IsEmpty())
+	{
+		const FString FilePath = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir(), SourceFile.FilePath);
+		if (!FFileHelper::LoadFileToString(MarkdownSource, *FilePath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UTreeSitterMarkdownAsset: Could not read %s for %s, keeping the previously compiled model"), *FilePath, *GetPathName());
+			return;
+		}
+	}
+
+	// Factories are left out on purpose: custom widgets need nodes, and there are none once serialized
+	const TSharedRef<const FTreeSitterWidgetFactoryTable> NoFactories = MakeShared<FTreeSitterWidgetFactoryTable>();
+	RenderModel = FTreeSitterMarkdownRenderModel::Build(FTreeSitterSource::Create(MoveTemp(MarkdownSource)), nullptr, FTreeSitterMarkdownLanguages::Resolve(), NoFactories);
+}
+#endif
+
+TSharedRef<SWidget> UTreeSitterMarkdownAsset::MakeWidget(const bool bInVirtualized) const
+{
+	if (!RenderModel.IsValid())
+	{
+		return SNullWidget::NullWidget;
+	}
+
+	return SNew(STreeSitterMarkdown)
+		.RenderModel(RenderModel)
+		.Virtualized(bInVirtualized);
+}
+
+bool UTreeSitterMarkdownAsset::HasRenderModel() const
+{
+	return RenderModel.IsValid();
+}
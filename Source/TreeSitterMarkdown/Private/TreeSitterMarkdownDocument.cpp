@@ -0,0 +1,360 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterMarkdownDocument.h"
+
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+#include "ITreeSitterModule.h"
+#include "TreeSitterMarkdownInline.h"
+#include "TreeSitterMarkdownModule.h"
+#include "TreeSitterMarkdownRenderModel.h"
+#include "TreeSitterParser.h"
+#include "TreeSitterParserPool.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+
+TRACE_DECLARE_INT_COUNTER(TreeSitter_QueryMatches, TEXT("TreeSitter/Query/Matches"));
+TRACE_DECLARE_INT_COUNTER(TreeSitter_QueryCaptures, TEXT("TreeSitter/Query/Captures"));
+
+namespace UE::TreeSitter::Private
+{
+	/** Below this, the cost of waking up workers outweighs the sub-parses themselves */
+	static constexpr int32 InjectionsMinBatchSize = 8;
+
+	static TSRange MakeRange(const TSNode& InNode)
+	{
+		return TSRange({
+			.start_point = ts_node_start_point(InNode),
+			.end_point = ts_node_end_point(InNode),
+			.start_byte = ts_node_start_byte(InNode),
+			.end_byte = ts_node_end_byte(InNode)
+		});
+	}
+}
+
+FTreeSitterMarkdownDocument::~FTreeSitterMarkdownDocument()
+{
+	for (const FTreeSitterMarkdownInjection& Injection : Injections)
+	{
+		if (Injection.Tree)
+		{
+			ts_tree_delete(Injection.Tree);
+		}
+	}
+
+	if (BlockTree)
+	{
+		ts_tree_delete(BlockTree);
+	}
+}
+
+FTreeSitterMarkdownLanguages FTreeSitterMarkdownLanguages::Resolve()
+{
+	ITreeSitterModule& TreeSitterModule = ITreeSitterModule::Get();
+	auto GetLanguage = [&TreeSitterModule](const ETreeSitterLanguage InLanguage) -> const TSLanguage*
+	{
+		ITreeSitterModule::FGetLanguageParser* LanguageParser = TreeSitterModule.GetLanguageParser(InLanguage);
+		return LanguageParser ? LanguageParser() : nullptr;
+	};
+
+	FTreeSitterMarkdownLanguages Languages;
+	Languages.Markdown = GetLanguage(ETreeSitterLanguage::Markdown);
+	Languages.MarkdownInline = GetLanguage(ETreeSitterLanguage::MarkdownInline);
+	Languages.JavaScript = GetLanguage(ETreeSitterLanguage::JavaScript);
+	Languages.Json = GetLanguage(ETreeSitterLanguage::Json);
+
+	// Queries are owned by the TreeSitter module, and symbols by this one, rather than function statics outliving them
+	if (Languages.Markdown)
+	{
+		Languages.InjectionsQuery = TreeSitterModule.FindQuery(ETreeSitterLanguage::Markdown, TEXT("injections"));
+		ensureMsgf(Languages.InjectionsQuery.IsValid(), TEXT("Missing or invalid Resources/Queries/Markdown/injections.scm, markdown inline content and code blocks won't be parsed"));
+
+		Languages.TableQuery = TreeSitterModule.FindQuery(ETreeSitterLanguage::Markdown, TEXT("table"));
+		ensureMsgf(Languages.TableQuery.IsValid(), TEXT("Missing or invalid Resources/Queries/Markdown/table.scm, markdown tables won't be rendered"));
+
+		Languages.BlockSymbols = FTreeSitterMarkdownModule::Get().GetBlockSymbols(Languages.Markdown);
+	}
+
+	if (Languages.MarkdownInline)
+	{
+		Languages.InlineSymbols = FTreeSitterMarkdownModule::Get().GetInlineSymbols(Languages.MarkdownInline);
+	}
+
+	return Languages;
+}
+
+const TSLanguage* FTreeSitterMarkdownLanguages::Get(const ETreeSitterLanguage InLanguage) const
+{
+	switch (InLanguage)
+	{
+	case ETreeSitterLanguage::JavaScript:
+		return JavaScript;
+	case ETreeSitterLanguage::Json:
+		return Json;
+	case ETreeSitterLanguage::Markdown:
+		return Markdown;
+	case ETreeSitterLanguage::MarkdownInline:
+		return MarkdownInline;
+	default:
+		return nullptr;
+	}
+}
+
+TSharedRef<FTreeSitterMarkdownDocument> FTreeSitterMarkdownDocument::Parse(const TSharedRef<const FTreeSitterSource>& InSource, const FTreeSitterMarkdownDocument* InPreviousDocument)
+{
+	return Parse(InSource, InPreviousDocument, FTreeSitterMarkdownLanguages::Resolve());
+}
+
+TSharedRef<FTreeSitterMarkdownDocument> FTreeSitterMarkdownDocument::Parse(const TSharedRef<const FTreeSitterSource>& InSource, const FTreeSitterMarkdownDocument* InPreviousDocument, const FTreeSitterMarkdownLanguages& InLanguages)
+{
+	using namespace UE::TreeSitter::Private;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterMarkdownDocument::Parse);
+	CSV_SCOPED_TIMING_STAT(TreeSitter, MarkdownParse);
+
+	TSharedRef<FTreeSitterMarkdownDocument> Document = MakeShared<FTreeSitterMarkdownDocument>();
+	Document->Source = InSource;
+	Document->Languages = InLanguages;
+
+	// Every sub-parse reads from the same UTF-8 buffer, with its own included range
+	const ANSICHAR* Code = InSource->GetUTF8();
+	const uint32 Length = InSource->GetUTF8Length();
+
+	const TSLanguage* MarkdownLanguage = InLanguages.Markdown;
+	if (!MarkdownLanguage)
+	{
+		return Document;
+	}
+
+	// Edit a copy of the previous tree (copies are cheap, nodes are shared) so that it can be reused by the parser
+	TSTree* OldTree = nullptr;
+	if (InPreviousDocument && InPreviousDocument->BlockTree && InPreviousDocument->Source.IsValid())
+	{
+		OldTree = ts_tree_copy(InPreviousDocument->BlockTree);
+
+		TSInputEdit Edit;
+		if (InSource->ComputeEdit(*InPreviousDocument->Source, Edit))
+		{
+			ts_tree_edit(OldTree, &Edit);
+		}
+	}
+
+	{
+		const FTreeSitterPooledParser Parser(MarkdownLanguage);
+		Document->BlockTree = Parser->Parse(Code, Length, OldTree);
+	}
+
+	if (OldTree)
+	{
+		ts_tree_delete(OldTree);
+	}
+
+	if (!Document->BlockTree)
+	{
+		return Document;
+	}
+
+	Document->CollectInjections(Code);
+
+	TArray<FTreeSitterMarkdownInjection>& Injections = Document->Injections;
+
+	ParallelFor(TEXT("TreeSitter.MarkdownInjections"), Injections.Num(), InjectionsMinBatchSize, [&Injections, &InLanguages, Code, Length](const int32 Index)
+	{
+		const TSLanguage* Language = InLanguages.Get(Injections[Index].Language);
+		if (!Language)
+		{
+			return;
+		}
+
+		FTreeSitterMarkdownInjection& Injection = Injections[Index];
+
+		const FTreeSitterPooledParser Parser(Language);
+		const bool bRangesSet = Injection.IncludedRanges.IsEmpty() ? Parser->SetIncludedRanges({ Injection.Range }) : Parser->SetIncludedRanges(Injection.IncludedRanges);
+		if (bRangesSet)
+		{
+			Injection.Tree = Parser->Parse(Code, Length);
+		}
+	});
+
+	return Document;
+}
+
+const TSharedPtr<const FTreeSitterSource>& FTreeSitterMarkdownDocument::GetSource() const
+{
+	return Source;
+}
+
+const FTreeSitterMarkdownLanguages& FTreeSitterMarkdownDocument::GetLanguages() const
+{
+	return Languages;
+}
+
+TSTree* FTreeSitterMarkdownDocument::GetBlockTree() const
+{
+	return BlockTree;
+}
+
+TSNode FTreeSitterMarkdownDocument::GetRootNode() const
+{
+	check(BlockTree);
+	return ts_tree_root_node(BlockTree);
+}
+
+const TArray<FTreeSitterMarkdownInjection>& FTreeSitterMarkdownDocument::GetInjections() const
+{
+	return Injections;
+}
+
+const FTreeSitterMarkdownInjection* FTreeSitterMarkdownDocument::FindInjection(const uint32 InStartByte) const
+{
+	const int32 Index = Algo::BinarySearchBy(Injections, InStartByte, [](const FTreeSitterMarkdownInjection& Injection)
+	{
+		return Injection.Range.start_byte;
+	});
+
+	return Injections.IsValidIndex(Index) ? &Injections[Index] : nullptr;
+}
+
+void FTreeSitterMarkdownDocument::GetInjectionRanges(const TSNode& InNode, TArray<TSRange>& OutRanges)
+{
+	uint32 CursorByte = ts_node_start_byte(InNode);
+	TSPoint CursorPoint = ts_node_start_point(InNode);
+
+	const uint32 ChildCount = ts_node_child_count(InNode);
+	for (uint32 Index = 0; Index <= ChildCount; ++Index)
+	{
+		const bool bIsEnd = Index == ChildCount;
+		const TSNode Child = bIsEnd ? InNode : ts_node_child(InNode, Index);
+		const uint32 EndByte = bIsEnd ? ts_node_end_byte(Child) : ts_node_start_byte(Child);
+		const TSPoint EndPoint = bIsEnd ? ts_node_end_point(Child) : ts_node_start_point(Child);
+
+		if (CursorByte < EndByte)
+		{
+			OutRanges.Add({ .start_point = CursorPoint, .end_point = EndPoint, .start_byte = CursorByte, .end_byte = EndByte });
+		}
+
+		CursorByte = ts_node_end_byte(Child);
+		CursorPoint = ts_node_end_point(Child);
+	}
+}
+
+bool FTreeSitterMarkdownDocument::GetLanguageForInfoString(const FStringView InInfoString, ETreeSitterLanguage& OutLanguage)
+{
+	if (InInfoString.Equals(TEXT("js"), ESearchCase::IgnoreCase) || InInfoString.Equals(TEXT("javascript"), ESearchCase::IgnoreCase))
+	{
+		OutLanguage = ETreeSitterLanguage::JavaScript;
+		return true;
+	}
+
+	if (InInfoString.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+	{
+		OutLanguage = ETreeSitterLanguage::Json;
+		return true;
+	}
+
+	if (InInfoString.Equals(TEXT("md"), ESearchCase::IgnoreCase) || InInfoString.Equals(TEXT("markdown"), ESearchCase::IgnoreCase))
+	{
+		OutLanguage = ETreeSitterLanguage::Markdown;
+		return true;
+	}
+
+	return false;
+}
+
+void FTreeSitterMarkdownDocument::CollectInjections(const ANSICHAR* InUTF8Source)
+{
+	using namespace UE::TreeSitter::Private;
+
+	// Null when compiled for another grammar than the document's
+	const TSharedPtr<const FTreeSitterQuery>& InjectionsQuery = Languages.InjectionsQuery;
+	if (!InjectionsQuery || InjectionsQuery->GetLanguage() != ts_tree_language(BlockTree))
+	{
+		return;
+	}
+	const FTreeSitterQuery& Query = *InjectionsQuery;
+
+	static const FName NAME_Inline = TEXT("inline");
+	static const FName NAME_Language = TEXT("language");
+	static const FName NAME_Code = TEXT("code");
+
+	const int32 InlineCaptureIndex = Query.FindCaptureIndex(NAME_Inline);
+	const int32 LanguageCaptureIndex = Query.FindCaptureIndex(NAME_Language);
+	const int32 CodeCaptureIndex = Query.FindCaptureIndex(NAME_Code);
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterMarkdownDocument::CollectInjections);
+	CSV_SCOPED_TIMING_STAT(TreeSitter, Query);
+
+	int32 MatchCount = 0;
+	int32 CaptureCount = 0;
+
+	// Block continuations within an injection are left out of its included ranges, following the tree-sitter injection
+	// convention of not including children
+	const auto AddInjection = [this](const TSNode& InNode, const ETreeSitterLanguage InLanguage)
+	{
+		FTreeSitterMarkdownInjection& Injection = Injections.Add_GetRef({ MakeRange(InNode), InLanguage });
+		if (ts_node_child_count(InNode) > 0)
+		{
+			GetInjectionRanges(InNode, Injection.IncludedRanges);
+			if (Injection.IncludedRanges.IsEmpty())
+			{
+				Injections.Pop();
+			}
+		}
+	};
+
+	TSQueryCursor* Cursor = ts_query_cursor_new();
+	ts_query_cursor_exec(Cursor, Query.Get(), GetRootNode());
+
+	TSQueryMatch Match;
+	while (ts_query_cursor_next_match(Cursor, &Match))
+	{
+		++MatchCount;
+		CaptureCount += Match.capture_count;
+
+		TSNode CodeNode = {};
+		FString InfoString;
+
+		for (uint16 i = 0; i < Match.capture_count; ++i)
+		{
+			const TSQueryCapture& Capture = Match.captures[i];
+			const int32 CaptureIndex = static_cast<int32>(Capture.index);
+
+			if (CaptureIndex == InlineCaptureIndex)
+			{
+				AddInjection(Capture.node, ETreeSitterLanguage::MarkdownInline);
+			}
+			else if (CaptureIndex == CodeCaptureIndex)
+			{
+				CodeNode = Capture.node;
+			}
+			else if (CaptureIndex == LanguageCaptureIndex)
+			{
+				const uint32 StartByte = ts_node_start_byte(Capture.node);
+				const uint32 EndByte = ts_node_end_byte(Capture.node);
+				const FUTF8ToTCHAR Converted(InUTF8Source + StartByte, EndByte - StartByte);
+				InfoString = FString(Converted.Length(), Converted.Get());
+			}
+		}
+
+		ETreeSitterLanguage CodeLanguage;
+		if (CodeNode.id && GetLanguageForInfoString(InfoString, CodeLanguage))
+		{
+			AddInjection(CodeNode, CodeLanguage);
+		}
+	}
+
+	ts_query_cursor_delete(Cursor);
+
+	TRACE_COUNTER_SET(TreeSitter_QueryMatches, MatchCount);
+	TRACE_COUNTER_SET(TreeSitter_QueryCaptures, CaptureCount);
+	CSV_CUSTOM_STAT(TreeSitter, QueryMatches, MatchCount, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(TreeSitter, QueryCaptures, CaptureCount, ECsvCustomStatOp::Accumulate);
+
+	// Matches come out roughly but not strictly in document order, sub-parses and lookups rely on it
+	Algo::SortBy(Injections, [](const FTreeSitterMarkdownInjection& Injection)
+	{
+		return Injection.Range.start_byte;
+	});
+}
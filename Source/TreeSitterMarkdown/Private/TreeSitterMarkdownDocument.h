@@ -0,0 +1,117 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Templates/SharedPointer.h"
+#include "tree_sitter/api.h"
+
+class FTreeSitterQuery;
+class FTreeSitterSource;
+enum class ETreeSitterLanguage : uint8;
+
+namespace UE::TreeSitter::Private
+{
+	struct FMarkdownBlockSymbols;
+	struct FMarkdownInlineSymbols;
+}
+
+/**
+ * Grammars a markdown document may be parsed with, and what parsing and rendering derive from them.
+ *
+ * Resolved on the game thread (module lookups aren't meant to happen on workers), after which parsing can run anywhere.
+ */
+struct FTreeSitterMarkdownLanguages
+{
+	const TSLanguage* Markdown = nullptr;
+	const TSLanguage* MarkdownInline = nullptr;
+	const TSLanguage* JavaScript = nullptr;
+	const TSLanguage* Json = nullptr;
+
+	/** Bundled Resources/Queries/Markdown/injections.scm and table.scm, null without the markdown grammar */
+	TSharedPtr<const FTreeSitterQuery> InjectionsQuery;
+	TSharedPtr<const FTreeSitterQuery> TableQuery;
+
+	/** Symbols of the markdown and markdown_inline grammars, null when they couldn't be loaded */
+	TSharedPtr<const UE::TreeSitter::Private::FMarkdownBlockSymbols> BlockSymbols;
+	TSharedPtr<const UE::TreeSitter::Private::FMarkdownInlineSymbols> InlineSymbols;
+
+	/** Looks up every grammar from the TreeSitter module, either as the block grammar or as an injection, and the queries and symbols of the markdown ones */
+	static FTreeSitterMarkdownLanguages Resolve();
+
+	const TSLanguage* Get(const ETreeSitterLanguage InLanguage) const;
+};
+
+/** A range of the document parsed with its own grammar: inline content or a fenced code block */
+struct FTreeSitterMarkdownInjection
+{
+	/** Range of the injected content within the document */
+	TSRange Range;
+
+	/** Language the range is parsed with */
+	ETreeSitterLanguage Language;
+
+	/** Resulting tree, owned by the document */
+	TSTree* Tree = nullptr;
+
+	/**
+	 * Ranges of Range actually parsed, without what belongs to the block grammar (e.g. the "> " continuations of a
+	 * block quote). Empty when the whole of Range is parsed.
+	 */
+	TArray<TSRange> IncludedRanges;
+};
+
+/**
+ * Layered parse of a markdown document.
+ *
+ * The block grammar is parsed first, then every injection found in the block tree (inline ranges, fenced code blocks
+ * with a known language) is parsed on its own with a pooled parser. Those sub-parses are independent from one another
+ * and are fanned out across worker threads, each one writing to its own slot so the result doesn't depend on scheduling.
+ */
+class FTreeSitterMarkdownDocument
+{
+public:
+	FTreeSitterMarkdownDocument() = default;
+	~FTreeSitterMarkdownDocument();
+
+	FTreeSitterMarkdownDocument(const FTreeSitterMarkdownDocument&) = delete;
+	FTreeSitterMarkdownDocument& operator=(const FTreeSitterMarkdownDocument&) = delete;
+
+	/**
+	 * Parses the given source. When a previous document is given, the block tree is reparsed incrementally from it
+	 * (the previous document itself is left untouched).
+	 */
+	static TSharedRef<FTreeSitterMarkdownDocument> Parse(const TSharedRef<const FTreeSitterSource>& InSource, const FTreeSitterMarkdownDocument* InPreviousDocument = nullptr);
+
+	/** Same as above with already resolved languages, safe to call from any thread */
+	static TSharedRef<FTreeSitterMarkdownDocument> Parse(const TSharedRef<const FTreeSitterSource>& InSource, const FTreeSitterMarkdownDocument* InPreviousDocument, const FTreeSitterMarkdownLanguages& InLanguages);
+
+	/** Source buffer this document was parsed from */
+	const TSharedPtr<const FTreeSitterSource>& GetSource() const;
+
+	/** Languages this document was parsed with, for the rendering passes that follow it on the same thread */
+	const FTreeSitterMarkdownLanguages& GetLanguages() const;
+
+	TSTree* GetBlockTree() const;
+	TSNode GetRootNode() const;
+
+	/** Injections, sorted by start byte */
+	const TArray<FTreeSitterMarkdownInjection>& GetInjections() const;
+
+	/** Finds the injection starting at the given byte, if any */
+	const FTreeSitterMarkdownInjection* FindInjection(const uint32 InStartByte) const;
+
+	/** Ranges of an injection node left to the injected grammar: the node minus its children (block continuations) */
+	static void GetInjectionRanges(const TSNode& InNode, TArray<TSRange>& OutRanges);
+
+	/** Maps a fenced code block info string (js, json, ...) to a language, returns false if there's no grammar for it */
+	static bool GetLanguageForInfoString(const FStringView InInfoString, ETreeSitterLanguage& OutLanguage);
+
+private:
+	TSharedPtr<const FTreeSitterSource> Source;
+	FTreeSitterMarkdownLanguages Languages;
+	TSTree* BlockTree = nullptr;
+	TArray<FTreeSitterMarkdownInjection> Injections;
+
+	/** Runs the injection query over the block tree and fills Injections (without parsing them) */
+	void CollectInjections(const ANSICHAR* InUTF8Source);
+};
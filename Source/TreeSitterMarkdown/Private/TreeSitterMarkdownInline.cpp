@@ -0,0 +1,395 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterMarkdownInline.h"
+
+#include "Framework/Text/RichTextMarkupProcessing.h"
+#include "TreeSitterMarkdownDocument.h"
+#include "TreeSitterSource.h"
+#include "tree_sitter/api.h"
+
+namespace UE::TreeSitter::Private
+{
+	enum class EMarkdownInlineStyle : uint8
+	{
+		None = 0,
+		Italic = 1 << 0,
+		Bold = 1 << 1,
+		Code = 1 << 2,
+	};
+	ENUM_CLASS_FLAGS(EMarkdownInlineStyle)
+
+	static const TCHAR* GetStyleName(const EMarkdownInlineStyle InStyle)
+	{
+		if (EnumHasAnyFlags(InStyle, EMarkdownInlineStyle::Code))
+		{
+			return TEXT("MessageLog");
+		}
+
+		if (EnumHasAnyFlags(InStyle, EMarkdownInlineStyle::Bold))
+		{
+			return TEXT("RichTextBlock.Bold");
+		}
+
+		if (EnumHasAnyFlags(InStyle, EMarkdownInlineStyle::Italic))
+		{
+			return TEXT("RichTextBlock.Italic");
+		}
+
+		return nullptr;
+	}
+
+	FMarkdownInlineSymbols::FMarkdownInlineSymbols(const TSLanguage* InLanguage)
+		: Language(InLanguage)
+	{
+		auto Find = [InLanguage](const ANSICHAR* InName)
+		{
+			return ts_language_symbol_for_name(InLanguage, InName, FCStringAnsi::Strlen(InName), true);
+		};
+
+		Emphasis = Find("emphasis");
+		StrongEmphasis = Find("strong_emphasis");
+		EmphasisDelimiter = Find("emphasis_delimiter");
+		CodeSpan = Find("code_span");
+		CodeSpanDelimiter = Find("code_span_delimiter");
+		InlineLink = Find("inline_link");
+		FullReferenceLink = Find("full_reference_link");
+		CollapsedReferenceLink = Find("collapsed_reference_link");
+		ShortcutLink = Find("shortcut_link");
+		Image = Find("image");
+		LinkText = Find("link_text");
+		LinkDestination = Find("link_destination");
+		ImageDescription = Find("image_description");
+		UriAutolink = Find("uri_autolink");
+		EmailAutolink = Find("email_autolink");
+		HardLineBreak = Find("hard_line_break");
+		BackslashEscape = Find("backslash_escape");
+	}
+
+	/**
+	 * Walks an inline tree and accumulates rich text markup. Adjacent text with the same style is merged into a single
+	 * run, and only the bytes within the included ranges are emitted (block quote markers and such are left out).
+	 */
+	class FMarkdownRichTextWriter
+	{
+	public:
+		explicit FMarkdownRichTextWriter(const FTreeSitterSource& InSource)
+			: Source(InSource)
+		{
+		}
+
+		/** Restricts the text emitted from here on to the given ranges */
+		void SetRanges(TArray<TSRange>&& InRanges)
+		{
+			Ranges = MoveTemp(InRanges);
+		}
+
+		/** Symbols of the inline tree being visited, kept alive by the caller */
+		void SetSymbols(const FMarkdownInlineSymbols* InSymbols)
+		{
+			Symbols = InSymbols;
+		}
+
+		FString Finish()
+		{
+			Flush();
+			return MoveTemp(Markup);
+		}
+
+		/** Emits the text of a node between its children, and the children themselves */
+		void VisitChildren(const TSNode& InNode, const uint32 InStartByte, const uint32 InEndByte, const EMarkdownInlineStyle InStyle)
+		{
+			uint32 Cursor = InStartByte;
+			const uint32 ChildCount = ts_node_child_count(InNode);
+			for (uint32 Index = 0; Index < ChildCount; ++Index)
+			{
+				const TSNode Child = ts_node_child(InNode, Index);
+				AppendText(Cursor, ts_node_start_byte(Child), InStyle);
+				VisitNode(Child, InStyle);
+				Cursor = ts_node_end_byte(Child);
+			}
+
+			AppendText(Cursor, InEndByte, InStyle);
+		}
+
+		/** Plain text within [InStartByte, InEndByte), with soft line breaks collapsed into spaces */
+		void AppendText(const uint32 InStartByte, const uint32 InEndByte, const EMarkdownInlineStyle InStyle)
+		{
+			if (InStartByte >= InEndByte)
+			{
+				return;
+			}
+
+			if (InStyle != PendingStyle)
+			{
+				Flush();
+				PendingStyle = InStyle;
+			}
+
+			GetText(InStartByte, InEndByte, Pending);
+		}
+
+	private:
+		const FTreeSitterSource& Source;
+		TArray<TSRange> Ranges;
+		const FMarkdownInlineSymbols* Symbols = nullptr;
+
+		FString Markup;
+
+		/** Text of the current run, not escaped yet */
+		FString Pending;
+		EMarkdownInlineStyle PendingStyle = EMarkdownInlineStyle::None;
+
+		/** Last character emitted, across runs, to collapse line breaks without doubling spaces */
+		TCHAR LastChar = 0;
+
+		/** Set after a line break, so that the indentation of the next line is dropped */
+		bool bSkipWhitespace = false;
+
+		void VisitNode(const TSNode& InNode, const EMarkdownInlineStyle InStyle)
+		{
+			check(Symbols);
+			const TSSymbol Symbol = ts_node_symbol(InNode);
+			const uint32 StartByte = ts_node_start_byte(InNode);
+			const uint32 EndByte = ts_node_end_byte(InNode);
+
+			if (Symbol == Symbols->EmphasisDelimiter || Symbol == Symbols->CodeSpanDelimiter)
+			{
+				return;
+			}
+
+			if (Symbol == Symbols->Emphasis)
+			{
+				VisitChildren(InNode, StartByte, EndByte, InStyle | EMarkdownInlineStyle::Italic);
+			}
+			else if (Symbol == Symbols->StrongEmphasis)
+			{
+				VisitChildren(InNode, StartByte, EndByte, InStyle | EMarkdownInlineStyle::Bold);
+			}
+			else if (Symbol == Symbols->CodeSpan)
+			{
+				// Content is everything between the opening and closing delimiters
+				const uint32 ChildCount = ts_node_child_count(InNode);
+				const uint32 ContentStart = ChildCount > 0 ? ts_node_end_byte(ts_node_child(InNode, 0)) : StartByte;
+				const uint32 ContentEnd = ChildCount > 1 ? ts_node_start_byte(ts_node_child(InNode, ChildCount - 1)) : EndByte;
+				AppendText(ContentStart, ContentEnd, InStyle | EMarkdownInlineStyle::Code);
+			}
+			else if (Symbol == Symbols->HardLineBreak)
+			{
+				Pending.AppendChar(TEXT('\n'));
+				LastChar = TEXT('\n');
+				bSkipWhitespace = true;
+			}
+			else if (Symbol == Symbols->BackslashEscape)
+			{
+				AppendText(StartByte + 1, EndByte, InStyle);
+			}
+			else if (Symbol == Symbols->UriAutolink || Symbol == Symbols->EmailAutolink)
+			{
+				// Autolinks are wrapped in angle brackets
+				FString Url;
+				GetText(StartByte + 1, EndByte - 1, Url);
+				AppendLink(Url, Symbol == Symbols->EmailAutolink ? TEXT("mailto:") + Url : Url);
+			}
+			else if (Symbol == Symbols->InlineLink || Symbol == Symbols->FullReferenceLink || Symbol == Symbols->CollapsedReferenceLink || Symbol == Symbols->ShortcutLink || Symbol == Symbols->Image)
+			{
+				VisitLink(InNode, Symbol == Symbols->Image, InStyle);
+			}
+			else
+			{
+				// Anything else (html tags, entities, ...) is displayed as written
+				VisitChildren(InNode, StartByte, EndByte, InStyle);
+			}
+		}
+
+		void VisitLink(const TSNode& InNode, const bool bInIsImage, const EMarkdownInlineStyle InStyle)
+		{
+			FString Label;
+			FString Url;
+
+			const uint32 ChildCount = ts_node_child_count(InNode);
+			for (uint32 Index = 0; Index < ChildCount; ++Index)
+			{
+				const TSNode Child = ts_node_child(InNode, Index);
+				const TSSymbol Symbol = ts_node_symbol(Child);
+				if (Symbol == Symbols->LinkText || Symbol == Symbols->ImageDescription)
+				{
+					GetText(ts_node_start_byte(Child), ts_node_end_byte(Child), Label);
+				}
+				else if (Symbol == Symbols->LinkDestination)
+				{
+					GetText(ts_node_start_byte(Child), ts_node_end_byte(Child), Url);
+					Url.TrimCharInline(TEXT('<'), nullptr);
+					Url.TrimCharInline(TEXT('>'), nullptr);
+				}
+			}
+
+			// Images aren't loaded, and reference links aren't resolved: both fall back to their text
+			if (bInIsImage || Url.IsEmpty())
+			{
+				AppendString(Label, InStyle);
+				return;
+			}
+
+			AppendLink(Label, Url);
+		}
+
+		void AppendString(const FString& InText, const EMarkdownInlineStyle InStyle)
+		{
+			if (InStyle != PendingStyle)
+			{
+				Flush();
+				PendingStyle = InStyle;
+			}
+
+			Pending += InText;
+		}
+
+		void AppendLink(FString InLabel, FString InUrl)
+		{
+			if (InLabel.IsEmpty())
+			{
+				InLabel = InUrl;
+			}
+
+			if (InLabel.IsEmpty())
+			{
+				return;
+			}
+
+			// Hyperlink runs carry their own style
+			Flush();
+			LastChar = InLabel[InLabel.Len() - 1];
+			FDefaultRichTextMarkupWriter::EscapeText(InLabel);
+			FDefaultRichTextMarkupWriter::EscapeText(InUrl);
+			Markup += FString::Printf(TEXT("<a id=\"%s\" href=\"%s\">%s</>"), MarkdownLinkDecoratorId, *InUrl, *InLabel);
+		}
+
+		void GetText(const uint32 InStartByte, const uint32 InEndByte, FString& OutText)
+		{
+			for (const TSRange& Range : Ranges)
+			{
+				const uint32 StartByte = FMath::Max(InStartByte, Range.start_byte);
+				const uint32 EndByte = FMath::Min(InEndByte, Range.end_byte);
+				if (StartByte >= EndByte)
+				{
+					continue;
+				}
+
+				for (const TCHAR Char : Source.GetView(StartByte, EndByte))
+				{
+					if (Char == TEXT('\r'))
+					{
+						continue;
+					}
+
+					if (Char == TEXT('\n'))
+					{
+						if (LastChar != 0 && LastChar != TEXT(' ') && LastChar != TEXT('\n'))
+						{
+							OutText.AppendChar(TEXT(' '));
+							LastChar = TEXT(' ');
+						}
+
+						bSkipWhitespace = true;
+						continue;
+					}
+
+					if (bSkipWhitespace && (Char == TEXT(' ') || Char == TEXT('\t')))
+					{
+						continue;
+					}
+
+					bSkipWhitespace = false;
+					OutText.AppendChar(Char);
+					LastChar = Char;
+				}
+			}
+		}
+
+		void Flush()
+		{
+			if (Pending.IsEmpty())
+			{
+				return;
+			}
+
+			FDefaultRichTextMarkupWriter::EscapeText(Pending);
+			if (const TCHAR* StyleName = GetStyleName(PendingStyle))
+			{
+				Markup += FString::Printf(TEXT("<%s>%s</>"), StyleName, *Pending);
+			}
+			else
+			{
+				Markup += Pending;
+			}
+
+			Pending.Reset();
+		}
+	};
+
+	static TSRange MakeRange(const uint32 InStartByte, const TSPoint InStartPoint, const uint32 InEndByte, const TSPoint InEndPoint)
+	{
+		return TSRange({
+			.start_point = InStartPoint,
+			.end_point = InEndPoint,
+			.start_byte = InStartByte,
+			.end_byte = InEndByte
+		});
+	}
+}
+
+FString UE::TreeSitter::MakeMarkdownRichText(const TSNode& InBlockNode, const FTreeSitterMarkdownDocument& InDocument)
+{
+	using namespace UE::TreeSitter::Private;
+
+	check(InDocument.GetSource().IsValid());
+	FMarkdownRichTextWriter Writer(*InDocument.GetSource());
+	// Resolved along with the document languages, the worker this may run on never looks up modules
+	const FMarkdownInlineSymbols* InlineSymbols = InDocument.GetLanguages().InlineSymbols.Get();
+
+	bool bHasInlineContent = false;
+
+	const uint32 ChildCount = ts_node_child_count(InBlockNode);
+	for (uint32 Index = 0; Index < ChildCount; ++Index)
+	{
+		const TSNode InlineNode = ts_node_child(InBlockNode, Index);
+		if (FCStringAnsi::Strcmp(ts_node_type(InlineNode), "inline") != 0)
+		{
+			continue;
+		}
+
+		TArray<TSRange> Ranges;
+		FTreeSitterMarkdownDocument::GetInjectionRanges(InlineNode, Ranges);
+		if (Ranges.IsEmpty())
+		{
+			continue;
+		}
+
+		bHasInlineContent = true;
+		const uint32 StartByte = Ranges[0].start_byte;
+		const uint32 EndByte = Ranges.Last().end_byte;
+		Writer.SetRanges(MoveTemp(Ranges));
+
+		// Inline trees are parsed as injections along with the document, without one (no grammar) text is displayed as written
+		const FTreeSitterMarkdownInjection* Injection = InDocument.FindInjection(ts_node_start_byte(InlineNode));
+		if (Injection && Injection->Tree && InlineSymbols && InlineSymbols->Language == ts_tree_language(Injection->Tree))
+		{
+			Writer.SetSymbols(InlineSymbols);
+			Writer.VisitChildren(ts_tree_root_node(Injection->Tree), StartByte, EndByte, EMarkdownInlineStyle::None);
+		}
+		else
+		{
+			Writer.AppendText(StartByte, EndByte, EMarkdownInlineStyle::None);
+		}
+	}
+
+	if (!bHasInlineContent)
+	{
+		const uint32 StartByte = ts_node_start_byte(InBlockNode);
+		const uint32 EndByte = ts_node_end_byte(InBlockNode);
+		Writer.SetRanges({ MakeRange(StartByte, ts_node_start_point(InBlockNode), EndByte, ts_node_end_point(InBlockNode)) });
+		Writer.AppendText(StartByte, EndByte, EMarkdownInlineStyle::None);
+	}
+
+	return Writer.Finish();
+}
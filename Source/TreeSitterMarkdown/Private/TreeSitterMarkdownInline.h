@@ -0,0 +1,53 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Containers/UnrealString.h"
+#include "tree_sitter/api.h"
+
+class FTreeSitterMarkdownDocument;
+
+namespace UE::TreeSitter
+{
+	/** Id of the hyperlink decorator links are marked up with, see SRichTextBlock::HyperlinkDecorator() */
+	inline const TCHAR* MarkdownLinkDecoratorId = TEXT("markdown");
+
+	/**
+	 * Converts the inline content of a block node (paragraph, heading, ...) into SRichTextBlock markup, out of the
+	 * inline trees the document already parsed with the markdown_inline grammar. Doesn't parse anything itself, and
+	 * doesn't touch Slate, so it can run on any thread.
+	 *
+	 * Emphasis, strong emphasis and code spans become style runs (RichTextBlock.Italic, RichTextBlock.Bold, MessageLog),
+	 * links become hyperlink runs. Runs don't nest: overlapping styles collapse to one (code, then bold, then italic).
+	 */
+	FString MakeMarkdownRichText(const TSNode& InBlockNode, const FTreeSitterMarkdownDocument& InDocument);
+}
+
+namespace UE::TreeSitter::Private
+{
+	/** Symbols of the markdown_inline grammar handled by the rich text writer, 0 when not found */
+	struct FMarkdownInlineSymbols
+	{
+		const TSLanguage* Language = nullptr;
+
+		TSSymbol Emphasis = 0;
+		TSSymbol StrongEmphasis = 0;
+		TSSymbol EmphasisDelimiter = 0;
+		TSSymbol CodeSpan = 0;
+		TSSymbol CodeSpanDelimiter = 0;
+		TSSymbol InlineLink = 0;
+		TSSymbol FullReferenceLink = 0;
+		TSSymbol CollapsedReferenceLink = 0;
+		TSSymbol ShortcutLink = 0;
+		TSSymbol Image = 0;
+		TSSymbol LinkText = 0;
+		TSSymbol LinkDestination = 0;
+		TSSymbol ImageDescription = 0;
+		TSSymbol UriAutolink = 0;
+		TSSymbol EmailAutolink = 0;
+		TSSymbol HardLineBreak = 0;
+		TSSymbol BackslashEscape = 0;
+
+		explicit FMarkdownInlineSymbols(const TSLanguage* InLanguage);
+	};
+}
@@ -0,0 +1,145 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterMarkdownModule.h"
+
+#include "Misc/ScopeLock.h"
+#include "Modules/ModuleManager.h"
+#include "TreeSitterMarkdownInline.h"
+#include "TreeSitterMarkdownRenderModel.h"
+#include "TreeSitterMemory.h"
+#include "Widgets/Text/STextBlock.h"
+#include "tree_sitter/api.h"
+
+#define LOCTEXT_NAMESPACE "TreeSitterMarkdown"
+
+void FTreeSitterMarkdownModule::StartupModule()
+{
+	// Documents copy, query and delete trees with this module's copy of the library
+	UE::TreeSitter::InstallAllocator();
+}
+
+void FTreeSitterMarkdownModule::ShutdownModule()
+{
+	NodeNameToWidgetFactories.Reset();
+	WidgetFactoryTables.Reset();
+
+	FScopeLock Lock(&SymbolsCriticalSection);
+	BlockSymbols.Reset();
+	InlineSymbols.Reset();
+}
+
+void FTreeSitterMarkdownModule::RegisterCustomWidget(const ETreeSitterLanguage InLanguage, const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate)
+{
+	if (InNodeName != NAME_None)
+	{
+		NodeNameToWidgetFactories.FindOrAdd(InLanguage).Add(InNodeName, InCustomWidgetDelegate);
+		WidgetFactoryTables.Remove(InLanguage);
+	}
+}
+
+void FTreeSitterMarkdownModule::UnregisterCustomWidget(const ETreeSitterLanguage InLanguage, const FName& InNodeName)
+{
+	if (InNodeName != NAME_None)
+	{
+		if (TMap<FName, FTreeSitterOnGetCustomWidgetInstance>* Factories = NodeNameToWidgetFactories.Find(InLanguage))
+		{
+			Factories->Remove(InNodeName);
+		}
+
+		WidgetFactoryTables.Remove(InLanguage);
+	}
+}
+
+TSharedRef<const FTreeSitterWidgetFactoryTable> FTreeSitterMarkdownModule::GetWidgetFactoryTable(const ETreeSitterLanguage InLanguage)
+{
+	if (const TSharedRef<const FTreeSitterWidgetFactoryTable>* ExistingTable = WidgetFactoryTables.Find(InLanguage))
+	{
+		return *ExistingTable;
+	}
+
+	const TSharedRef<FTreeSitterWidgetFactoryTable> Table = MakeShared<FTreeSitterWidgetFactoryTable>();
+
+	ITreeSitterModule::FGetLanguageParser* LanguageParser = ITreeSitterModule::Get().GetLanguageParser(InLanguage);
+	const TMap<FName, FTreeSitterOnGetCustomWidgetInstance>* Factories = NodeNameToWidgetFactories.Find(InLanguage);
+	if (LanguageParser)
+	{
+		Table->Language = LanguageParser();
+	}
+
+	if (Table->Language && Factories)
+	{
+		// Several symbols can share the same name (aliases), resolve every named one rather than ts_language_symbol_for_name
+		const uint32 SymbolCount = ts_language_symbol_count(Table->Language);
+		Table->Factories.SetNum(SymbolCount);
+		for (uint32 SymbolIndex = 0; SymbolIndex < SymbolCount; ++SymbolIndex)
+		{
+			const TSSymbol Symbol = static_cast<TSSymbol>(SymbolIndex);
+			if (ts_language_symbol_type(Table->Language, Symbol) != TSSymbolTypeRegular)
+			{
+				continue;
+			}
+
+			if (const FTreeSitterOnGetCustomWidgetInstance* Factory = Factories->Find(FName(ts_language_symbol_name(Table->Language, Symbol), FNAME_Find)))
+			{
+				Table->Factories[Symbol] = *Factory;
+			}
+		}
+	}
+
+	WidgetFactoryTables.Add(InLanguage, Table);
+	return Table;
+}
+
+void FTreeSitterMarkdownModule::RegisterCustomMarkdownWidget(const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate)
+{
+	RegisterCustomWidget(ETreeSitterLanguage::Markdown, InNodeName, InCustomWidgetDelegate);
+}
+
+void FTreeSitterMarkdownModule::UnregisterCustomMarkdownWidget(const FName& InNodeName)
+{
+	UnregisterCustomWidget(ETreeSitterLanguage::Markdown, InNodeName);
+}
+
+TSharedRef<SWidget> FTreeSitterMarkdownModule::CreateWidgetForNodeType(const ::FName& InNodeType, const TSharedRef<FTreeSitterNode>& InNode, const TSharedRef<const FTreeSitterSource>& InSource)
+{
+	const TMap<FName, FTreeSitterOnGetCustomWidgetInstance>* Factories = NodeNameToWidgetFactories.Find(ETreeSitterLanguage::Markdown);
+	if (const FTreeSitterOnGetCustomWidgetInstance* Factory = Factories ? Factories->Find(InNodeType) : nullptr)
+	{
+		// Call the delegate to create the widget
+		return Factory->Execute(InNode, InSource);
+	}
+
+	// Fallback: Return default widget
+	return SNew(STextBlock)
+		.Text(FText::Format(LOCTEXT("UnknownNodeType", "Unknown Node Type: {0}"), FText::FromString(InNodeType.ToString())));
+}
+
+bool FTreeSitterMarkdownModule::HasCustomWidgetForNodeType(const FName& InNodeType)
+{
+	const TMap<FName, FTreeSitterOnGetCustomWidgetInstance>* Factories = NodeNameToWidgetFactories.Find(ETreeSitterLanguage::Markdown);
+	return Factories && Factories->Contains(InNodeType);
+}
+
+TSharedRef<const UE::TreeSitter::Private::FMarkdownBlockSymbols> FTreeSitterMarkdownModule::GetBlockSymbols(const TSLanguage* InLanguage)
+{
+	FScopeLock Lock(&SymbolsCriticalSection);
+	if (const TSharedRef<const UE::TreeSitter::Private::FMarkdownBlockSymbols>* Symbols = BlockSymbols.Find(InLanguage))
+	{
+		return *Symbols;
+	}
+	return BlockSymbols.Add(InLanguage, MakeShared<UE::TreeSitter::Private::FMarkdownBlockSymbols>(InLanguage));
+}
+
+TSharedRef<const UE::TreeSitter::Private::FMarkdownInlineSymbols> FTreeSitterMarkdownModule::GetInlineSymbols(const TSLanguage* InLanguage)
+{
+	FScopeLock Lock(&SymbolsCriticalSection);
+	if (const TSharedRef<const UE::TreeSitter::Private::FMarkdownInlineSymbols>* Symbols = InlineSymbols.Find(InLanguage))
+	{
+		return *Symbols;
+	}
+	return InlineSymbols.Add(InLanguage, MakeShared<UE::TreeSitter::Private::FMarkdownInlineSymbols>(InLanguage));
+}
+
+IMPLEMENT_MODULE(FTreeSitterMarkdownModule, TreeSitterMarkdown);
+
+#undef LOCTEXT_NAMESPACE
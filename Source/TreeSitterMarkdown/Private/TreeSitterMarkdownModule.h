@@ -0,0 +1,55 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "ITreeSitterMarkdownModule.h"
+#include "HAL/CriticalSection.h"
+
+namespace UE::TreeSitter::Private
+{
+	struct FMarkdownBlockSymbols;
+	struct FMarkdownInlineSymbols;
+}
+
+class FTreeSitterMarkdownModule : public ITreeSitterMarkdownModule
+{
+public:
+	static FTreeSitterMarkdownModule& Get()
+	{
+		return static_cast<FTreeSitterMarkdownModule&>(ITreeSitterMarkdownModule::Get());
+	}
+
+	//~ Begin IModuleInterface
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+	//~ End IModuleInterface
+	
+	//~ Begin ITreeSitterMarkdownModule
+	virtual void RegisterCustomWidget(const ETreeSitterLanguage InLanguage, const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate) override;
+	virtual void UnregisterCustomWidget(const ETreeSitterLanguage InLanguage, const FName& InNodeName) override;
+	virtual TSharedRef<const FTreeSitterWidgetFactoryTable> GetWidgetFactoryTable(const ETreeSitterLanguage InLanguage) override;
+	virtual void RegisterCustomMarkdownWidget(const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate) override;
+	virtual void UnregisterCustomMarkdownWidget(const FName& InNodeName) override;
+	virtual TSharedRef<SWidget> CreateWidgetForNodeType(const FName& InNodeType, const TSharedRef<FTreeSitterNode>& InNode, const TSharedRef<const FTreeSitterSource>& InSource) override;
+	virtual bool HasCustomWidgetForNodeType(const FName& InNodeType) override;
+	//~ End ITreeSitterMarkdownModule
+
+	/**
+	 * Symbols of a markdown or markdown_inline grammar, resolved on first request and shared. Keyed by TSLanguage so that
+	 * a reloaded grammar gets its own, and owned by the module so that they don't outlive it. Safe to call from any thread.
+	 */
+	TSharedRef<const UE::TreeSitter::Private::FMarkdownBlockSymbols> GetBlockSymbols(const TSLanguage* InLanguage);
+	TSharedRef<const UE::TreeSitter::Private::FMarkdownInlineSymbols> GetInlineSymbols(const TSLanguage* InLanguage);
+
+private:
+	/** Registered widget factories per language, keyed by node name */
+	TMap<ETreeSitterLanguage, TMap<FName, FTreeSitterOnGetCustomWidgetInstance>> NodeNameToWidgetFactories;
+
+	/** Lazily built symbol indexed tables, reset for a language whenever its factories change */
+	TMap<ETreeSitterLanguage, TSharedRef<const FTreeSitterWidgetFactoryTable>> WidgetFactoryTables;
+
+	/** Grammar symbols per language, see GetBlockSymbols() and GetInlineSymbols() */
+	FCriticalSection SymbolsCriticalSection;
+	TMap<const TSLanguage*, TSharedRef<const UE::TreeSitter::Private::FMarkdownBlockSymbols>> BlockSymbols;
+	TMap<const TSLanguage*, TSharedRef<const UE::TreeSitter::Private::FMarkdownInlineSymbols>> InlineSymbols;
+};
@@ -0,0 +1,457 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterMarkdownRenderModel.h"
+
+#include "Async/Async.h"
+#include "Hash/CityHash.h"
+#include "ITreeSitterMarkdownModule.h"
+#include "TreeSitterMarkdownDocument.h"
+#include "TreeSitterMarkdownInline.h"
+#include "TreeSitterQuery.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+
+TRACE_DECLARE_INT_COUNTER(TreeSitter_MarkdownBlocks, TEXT("TreeSitter/Markdown/Blocks"));
+
+namespace UE::TreeSitter::Private
+{
+	FMarkdownBlockSymbols::FMarkdownBlockSymbols(const TSLanguage* InLanguage)
+		: Language(InLanguage)
+	{
+		auto Find = [InLanguage](const ANSICHAR* InName)
+		{
+			return ts_language_symbol_for_name(InLanguage, InName, FCStringAnsi::Strlen(InName), true);
+		};
+
+		Section = Find("section");
+		Paragraph = Find("paragraph");
+		AtxHeading = Find("atx_heading");
+		SetextHeading = Find("setext_heading");
+		SetextH1Underline = Find("setext_h1_underline");
+		BlockQuote = Find("block_quote");
+		List = Find("list");
+		ListItem = Find("list_item");
+		FencedCodeBlock = Find("fenced_code_block");
+		IndentedCodeBlock = Find("indented_code_block");
+		InfoString = Find("info_string");
+		LanguageTag = Find("language");
+		CodeFenceContent = Find("code_fence_content");
+		PipeTable = Find("pipe_table");
+		PipeTableHeader = Find("pipe_table_header");
+		PipeTableRow = Find("pipe_table_row");
+		PipeTableCell = Find("pipe_table_cell");
+		ThematicBreak = Find("thematic_break");
+
+		const uint32 SymbolCount = ts_language_symbol_count(InLanguage);
+		SyntaxSymbols.Init(false, SymbolCount);
+		for (uint32 Symbol = 0; Symbol < SymbolCount; ++Symbol)
+		{
+			const ANSICHAR* Name = ts_language_symbol_name(InLanguage, static_cast<TSSymbol>(Symbol));
+			SyntaxSymbols[Symbol] = Name && (FCStringAnsi::Strstr(Name, "marker") || FCStringAnsi::Strstr(Name, "delimiter") || FCStringAnsi::Strcmp(Name, "block_continuation") == 0);
+		}
+	}
+
+	static FString GetTrimmedText(const TSNode& InNode, const FTreeSitterSource& InSource)
+	{
+		if (ts_node_is_null(InNode))
+		{
+			return FString();
+		}
+
+		return FString(InSource.GetView(InNode).TrimStartAndEnd());
+	}
+
+	static TSNode GetChildByFieldName(const TSNode& InNode, const ANSICHAR* InFieldName)
+	{
+		return ts_node_child_by_field_name(InNode, InFieldName, FCStringAnsi::Strlen(InFieldName));
+	}
+
+	/** Walks the block tree once, extracting what each block needs to be displayed */
+	class FMarkdownRenderModelBuilder
+	{
+	public:
+		FMarkdownRenderModelBuilder(const FTreeSitterMarkdownDocument& InDocument, const FMarkdownBlockSymbols& InSymbols, const FTreeSitterWidgetFactoryTable& InFactories)
+			: Document(InDocument)
+			, Source(*InDocument.GetSource())
+			, Symbols(InSymbols)
+			, Factories(InFactories)
+		{
+			// Null when compiled for another grammar than the document's
+			const TSharedPtr<const FTreeSitterQuery>& DocumentTableQuery = InDocument.GetLanguages().TableQuery;
+			if (DocumentTableQuery && DocumentTableQuery->GetLanguage() == InSymbols.Language)
+			{
+				TableQuery = DocumentTableQuery;
+			}
+
+			static const FName NAME_Header = TEXT("header");
+			static const FName NAME_Row = TEXT("row");
+			static const FName NAME_Cell = TEXT("cell");
+			if (TableQuery)
+			{
+				HeaderCaptureIndex = TableQuery->FindCaptureIndex(NAME_Header);
+				RowCaptureIndex = TableQuery->FindCaptureIndex(NAME_Row);
+				CellCaptureIndex = TableQuery->FindCaptureIndex(NAME_Cell);
+			}
+		}
+
+		/** Adds the blocks found below a node, looking through sections (they only group a heading with the blocks below it) */
+		void AddBlocks(const TSNode& InParentNode, TArray<FTreeSitterMarkdownRenderBlock>& OutBlocks) const
+		{
+			const uint32 ChildCount = ts_node_named_child_count(InParentNode);
+			for (uint32 Index = 0; Index < ChildCount; ++Index)
+			{
+				const TSNode Child = ts_node_named_child(InParentNode, Index);
+				const TSSymbol Symbol = ts_node_symbol(Child);
+
+				if (Symbol == Symbols.Section)
+				{
+					AddBlocks(Child, OutBlocks);
+				}
+				else if (!Symbols.IsSyntax(Symbol))
+				{
+					BuildBlock(Child, OutBlocks.AddDefaulted_GetRef());
+				}
+			}
+		}
+
+	private:
+		const FTreeSitterMarkdownDocument& Document;
+		const FTreeSitterSource& Source;
+		const FMarkdownBlockSymbols& Symbols;
+		const FTreeSitterWidgetFactoryTable& Factories;
+
+		TSharedPtr<const FTreeSitterQuery> TableQuery;
+		int32 HeaderCaptureIndex = INDEX_NONE;
+		int32 RowCaptureIndex = INDEX_NONE;
+		int32 CellCaptureIndex = INDEX_NONE;
+
+		void BuildBlock(const TSNode& InNode, FTreeSitterMarkdownRenderBlock& OutBlock) const
+		{
+			const TSSymbol Symbol = ts_node_symbol(InNode);
+
+			OutBlock.Node = InNode;
+			OutBlock.StartByte = ts_node_start_byte(InNode);
+			OutBlock.EndByte = ts_node_end_byte(InNode);
+
+			// Custom factories take precedence over builtin blocks, the widget is entirely up to them
+			if (Factories.Find(Symbol))
+			{
+				OutBlock.Kind = ETreeSitterMarkdownBlockKind::Custom;
+			}
+			else if (Symbol == Symbols.Paragraph)
+			{
+				OutBlock.Kind = ETreeSitterMarkdownBlockKind::Paragraph;
+				OutBlock.RichText = MakeMarkdownRichText(InNode, Document);
+			}
+			else if (Symbol == Symbols.AtxHeading || Symbol == Symbols.SetextHeading)
+			{
+				BuildHeading(InNode, OutBlock);
+			}
+			else if (Symbol == Symbols.BlockQuote)
+			{
+				OutBlock.Kind = ETreeSitterMarkdownBlockKind::BlockQuote;
+				AddBlocks(InNode, OutBlock.Children);
+			}
+			else if (Symbol == Symbols.List)
+			{
+				OutBlock.Kind = ETreeSitterMarkdownBlockKind::List;
+				AddBlocks(InNode, OutBlock.Children);
+			}
+			else if (Symbol == Symbols.ListItem)
+			{
+				BuildListItem(InNode, OutBlock);
+			}
+			else if (Symbol == Symbols.FencedCodeBlock || Symbol == Symbols.IndentedCodeBlock)
+			{
+				BuildCodeBlock(InNode, OutBlock);
+			}
+			else if (Symbol == Symbols.PipeTable)
+			{
+				BuildTable(InNode, OutBlock);
+			}
+			else if (Symbol == Symbols.ThematicBreak)
+			{
+				OutBlock.Kind = ETreeSitterMarkdownBlockKind::ThematicBreak;
+			}
+			else
+			{
+				OutBlock.Kind = ETreeSitterMarkdownBlockKind::Other;
+				OutBlock.Text = GetTrimmedText(InNode, Source);
+			}
+		}
+
+		void BuildHeading(const TSNode& InNode, FTreeSitterMarkdownRenderBlock& OutBlock) const
+		{
+			OutBlock.Kind = ETreeSitterMarkdownBlockKind::Heading;
+			OutBlock.Text = GetTrimmedText(GetChildByFieldName(InNode, "heading_content"), Source);
+
+			if (ts_node_symbol(InNode) == Symbols.SetextHeading)
+			{
+				// Underlined with either = (level 1) or - (level 2)
+				const TSNode Underline = ts_node_child(InNode, ts_node_child_count(InNode) - 1);
+				OutBlock.HeadingLevel = ts_node_symbol(Underline) == Symbols.SetextH1Underline ? 1 : 2;
+				return;
+			}
+
+			// First child is expected to be an atx_h[1-6]_marker
+			const TSNode Marker = ts_node_child(InNode, 0);
+			const ANSICHAR* MarkerType = ts_node_is_null(Marker) ? nullptr : ts_node_type(Marker);
+			const bool bIsLevelMarker = MarkerType && FCStringAnsi::Strlen(MarkerType) > 5 && FCharAnsi::IsDigit(MarkerType[5]);
+			OutBlock.HeadingLevel = bIsLevelMarker ? FMath::Clamp(MarkerType[5] - '0', 1, 6) : 1;
+		}
+
+		void BuildListItem(const TSNode& InNode, FTreeSitterMarkdownRenderBlock& OutBlock) const
+		{
+			OutBlock.Kind = ETreeSitterMarkdownBlockKind::ListItem;
+
+			// List marker (-, *, 1. ...) followed by the optional task marker ([ ], [x])
+			const uint32 ChildCount = ts_node_named_child_count(InNode);
+			for (uint32 Index = 0; Index < ChildCount; ++Index)
+			{
+				const TSNode Child = ts_node_named_child(InNode, Index);
+				if (Symbols.IsSyntax(ts_node_symbol(Child)))
+				{
+					const FString Marker = GetTrimmedText(Child, Source);
+					if (!Marker.IsEmpty())
+					{
+						OutBlock.Text += OutBlock.Text.IsEmpty() ? Marker : TEXT(" ") + Marker;
+					}
+				}
+			}
+
+			AddBlocks(InNode, OutBlock.Children);
+		}
+
+		void BuildCodeBlock(const TSNode& InNode, FTreeSitterMarkdownRenderBlock& OutBlock) const
+		{
+			OutBlock.Kind = ETreeSitterMarkdownBlockKind::CodeBlock;
+
+			if (ts_node_symbol(InNode) == Symbols.IndentedCodeBlock)
+			{
+				OutBlock.Text = FString(Source.GetView(InNode)).TrimEnd();
+				return;
+			}
+
+			const uint32 ChildCount = ts_node_named_child_count(InNode);
+			for (uint32 Index = 0; Index < ChildCount; ++Index)
+			{
+				const TSNode Child = ts_node_named_child(InNode, Index);
+				const TSSymbol Symbol = ts_node_symbol(Child);
+
+				if (Symbol == Symbols.CodeFenceContent)
+				{
+					OutBlock.Text = FString(Source.GetView(Child)).TrimEnd();
+				}
+				else if (Symbol == Symbols.InfoString)
+				{
+					OutBlock.CodeInfoString = GetTrimmedText(Child, Source);
+
+					const TSNode LanguageNode = ts_node_named_child(Child, 0);
+					ETreeSitterLanguage CodeLanguage;
+					if (!ts_node_is_null(LanguageNode) && ts_node_symbol(LanguageNode) == Symbols.LanguageTag && FTreeSitterMarkdownDocument::GetLanguageForInfoString(Source.GetView(LanguageNode), CodeLanguage))
+					{
+						OutBlock.CodeLanguage = CodeLanguage;
+					}
+				}
+			}
+		}
+
+		void BuildTable(const TSNode& InNode, FTreeSitterMarkdownRenderBlock& OutBlock) const
+		{
+			OutBlock.Kind = ETreeSitterMarkdownBlockKind::Table;
+			if (!TableQuery)
+			{
+				return;
+			}
+
+			FTreeSitterMarkdownTable& Table = OutBlock.Table;
+
+			// Captures come in document order: the header, then every row (the delimiter row has no pipe_table_cell),
+			// each one followed by its cells
+			bool bIsHeader = false;
+			int32 RowCellCount = INDEX_NONE;
+			const auto FinishRow = [&Table, &bIsHeader, &RowCellCount]()
+			{
+				if (bIsHeader)
+				{
+					Table.ColumnCount = RowCellCount;
+				}
+				else
+				{
+					// Missing cells are left empty
+					for (; RowCellCount >= 0 && RowCellCount < Table.ColumnCount; ++RowCellCount)
+					{
+						Table.AddCell(FStringView());
+					}
+				}
+			};
+
+			TSQueryCursor* Cursor = ts_query_cursor_new();
+			ts_query_cursor_exec(Cursor, TableQuery->Get(), InNode);
+
+			TSQueryMatch Match;
+			uint32 CaptureIndex = 0;
+			while (ts_query_cursor_next_capture(Cursor, &Match, &CaptureIndex))
+			{
+				const TSQueryCapture& Capture = Match.captures[CaptureIndex];
+				const int32 CaptureId = static_cast<int32>(Capture.index);
+
+				if (CaptureId == HeaderCaptureIndex || CaptureId == RowCaptureIndex)
+				{
+					FinishRow();
+					bIsHeader = CaptureId == HeaderCaptureIndex;
+					RowCellCount = 0;
+				}
+				// Header defines the column count, extra cells in a row are dropped
+				else if (CaptureId == CellCaptureIndex && RowCellCount != INDEX_NONE && (bIsHeader || RowCellCount < Table.ColumnCount))
+				{
+					Table.AddCell(Source.GetView(Capture.node).TrimStartAndEnd());
+					++RowCellCount;
+				}
+			}
+			FinishRow();
+
+			ts_query_cursor_delete(Cursor);
+		}
+	};
+}
+
+FArchive& operator<<(FArchive& Ar, FTreeSitterMarkdownRenderBlock& Block)
+{
+	uint8 Kind = static_cast<uint8>(Block.Kind);
+	Ar << Kind;
+	Block.Kind = static_cast<ETreeSitterMarkdownBlockKind>(Kind);
+
+	Ar << Block.Key;
+	Ar << Block.StartByte;
+	Ar << Block.EndByte;
+	Ar << Block.HeadingLevel;
+	Ar << Block.RichText;
+	Ar << Block.Text;
+	Ar << Block.CodeInfoString;
+
+	bool bHasCodeLanguage = Block.CodeLanguage.IsSet();
+	uint8 CodeLanguage = bHasCodeLanguage ? static_cast<uint8>(Block.CodeLanguage.GetValue()) : 0;
+	Ar << bHasCodeLanguage;
+	Ar << CodeLanguage;
+	if (Ar.IsLoading())
+	{
+		Block.Node = {};
+		Block.CodeLanguage = bHasCodeLanguage ? TOptional<ETreeSitterLanguage>(static_cast<ETreeSitterLanguage>(CodeLanguage)) : TOptional<ETreeSitterLanguage>();
+	}
+
+	Ar << Block.Table;
+	Ar << Block.Children;
+
+	return Ar;
+}
+
+FTreeSitterMarkdownRenderModel::FTreeSitterMarkdownRenderModel()
+	: Source(FTreeSitterSource::Create(FString()))
+	, Factories(MakeShared<FTreeSitterWidgetFactoryTable>())
+{
+}
+
+FTreeSitterMarkdownRenderModel::FTreeSitterMarkdownRenderModel(const TSharedRef<const FTreeSitterMarkdownDocument>& InDocument, const TSharedRef<const FTreeSitterWidgetFactoryTable>& InFactories)
+	: Document(InDocument)
+	, Source(InDocument->GetSource().ToSharedRef())
+	, Factories(InFactories)
+{
+}
+
+TSharedRef<FTreeSitterMarkdownRenderModel> FTreeSitterMarkdownRenderModel::Build(
+	const TSharedRef<const FTreeSitterSource>& InSource,
+	const FTreeSitterMarkdownRenderModel* InPreviousModel,
+	const FTreeSitterMarkdownLanguages& InLanguages,
+	const TSharedRef<const FTreeSitterWidgetFactoryTable>& InFactories
+)
+{
+	using namespace UE::TreeSitter::Private;
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterMarkdownRenderModel::Build);
+	CSV_SCOPED_TIMING_STAT(TreeSitter, MarkdownBuild);
+
+	const FTreeSitterMarkdownDocument* PreviousDocument = InPreviousModel ? InPreviousModel->GetDocument().Get() : nullptr;
+	const TSharedRef<const FTreeSitterMarkdownDocument> Document = FTreeSitterMarkdownDocument::Parse(InSource, PreviousDocument, InLanguages);
+
+	TSharedRef<FTreeSitterMarkdownRenderModel> Model = MakeShared<FTreeSitterMarkdownRenderModel>(Document, InFactories);
+	if (!Document->GetBlockTree())
+	{
+		return Model;
+	}
+
+	// Resolved along with the languages, the worker this may run on never looks up modules
+	const TSharedPtr<const FMarkdownBlockSymbols>& Symbols = InLanguages.BlockSymbols;
+	if (!Symbols || Symbols->Language != ts_tree_language(Document->GetBlockTree()))
+	{
+		return Model;
+	}
+
+	const FMarkdownRenderModelBuilder Builder(*Document, *Symbols, *InFactories);
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FTreeSitterMarkdownRenderModel::AddBlocks);
+		Builder.AddBlocks(Document->GetRootNode(), Model->Blocks);
+	}
+
+	TRACE_COUNTER_SET(TreeSitter_MarkdownBlocks, Model->Blocks.Num());
+
+	for (FTreeSitterMarkdownRenderBlock& Block : Model->Blocks)
+	{
+		Block.Key = UE::TreeSitter::GetMarkdownBlockKey(Block.Node, *InSource);
+	}
+
+	return Model;
+}
+
+TSharedRef<FTreeSitterMarkdownRenderModel> FTreeSitterMarkdownRenderModel::Build(const TSharedRef<const FTreeSitterSource>& InSource, const FTreeSitterMarkdownRenderModel* InPreviousModel)
+{
+	return Build(InSource, InPreviousModel, FTreeSitterMarkdownLanguages::Resolve(), ITreeSitterMarkdownModule::Get().GetWidgetFactoryTable(ETreeSitterLanguage::Markdown));
+}
+
+TFuture<TSharedPtr<FTreeSitterMarkdownRenderModel>> FTreeSitterMarkdownRenderModel::BuildAsync(const TSharedRef<const FTreeSitterSource>& InSource, const TSharedPtr<const FTreeSitterMarkdownRenderModel>& InPreviousModel)
+{
+	check(IsInGameThread());
+
+	const FTreeSitterMarkdownLanguages Languages = FTreeSitterMarkdownLanguages::Resolve();
+	const TSharedRef<const FTreeSitterWidgetFactoryTable> Factories = ITreeSitterMarkdownModule::Get().GetWidgetFactoryTable(ETreeSitterLanguage::Markdown);
+
+	// The previous model is kept alive by the task, its tree is only copied from
+	return Async(EAsyncExecution::TaskGraph, [InSource, InPreviousModel, Languages, Factories]() -> TSharedPtr<FTreeSitterMarkdownRenderModel>
+	{
+		return Build(InSource, InPreviousModel.Get(), Languages, Factories);
+	});
+}
+
+void FTreeSitterMarkdownRenderModel::Serialize(FArchive& Ar)
+{
+	Ar << Blocks;
+}
+
+const TSharedPtr<const FTreeSitterMarkdownDocument>& FTreeSitterMarkdownRenderModel::GetDocument() const
+{
+	return Document;
+}
+
+const TSharedRef<const FTreeSitterSource>& FTreeSitterMarkdownRenderModel::GetSource() const
+{
+	return Source;
+}
+
+const TSharedRef<const FTreeSitterWidgetFactoryTable>& FTreeSitterMarkdownRenderModel::GetFactories() const
+{
+	return Factories;
+}
+
+const TArray<FTreeSitterMarkdownRenderBlock>& FTreeSitterMarkdownRenderModel::GetBlocks() const
+{
+	return Blocks;
+}
+
+uint64 UE::TreeSitter::GetMarkdownBlockKey(const TSNode& InNode, const FTreeSitterSource& InSource)
+{
+	const uint32 StartByte = ts_node_start_byte(InNode);
+	const uint32 EndByte = FMath::Min(ts_node_end_byte(InNode), InSource.GetUTF8Length());
+	const uint32 Length = EndByte > StartByte ? EndByte - StartByte : 0;
+
+	return CityHash64WithSeed(InSource.GetUTF8() + StartByte, Length, ts_node_symbol(InNode));
+}
@@ -0,0 +1,205 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Async/Future.h"
+#include "Containers/BitArray.h"
+#include "Containers/StringView.h"
+#include "Misc/Optional.h"
+#include "Templates/SharedPointer.h"
+#include "tree_sitter/api.h"
+
+class FTreeSitterMarkdownDocument;
+class FTreeSitterSource;
+enum class ETreeSitterLanguage : uint8;
+struct FTreeSitterMarkdownLanguages;
+struct FTreeSitterWidgetFactoryTable;
+
+enum class ETreeSitterMarkdownBlockKind : uint8
+{
+	/** Handed over to a widget factory registered with ITreeSitterMarkdownModule */
+	Custom,
+	Paragraph,
+	Heading,
+	BlockQuote,
+	List,
+	ListItem,
+	CodeBlock,
+	Table,
+	ThematicBreak,
+	/** Anything else (html blocks, link reference definitions, ...), displayed as written */
+	Other,
+};
+
+/**
+ * Cells of a pipe table in row major order, header row first, packed into a single buffer. Rows are padded or cut to
+ * the header column count.
+ */
+struct FTreeSitterMarkdownTable
+{
+	int32 ColumnCount = 0;
+
+	/** Trimmed text of every cell, back to back */
+	FString Text;
+
+	/** End of each cell in Text, a cell starting where the previous one ends */
+	TArray<int32> CellEnds;
+
+	/** Rows, including the header one */
+	int32 GetRowCount() const { return ColumnCount > 0 ? CellEnds.Num() / ColumnCount : 0; }
+
+	/** Only valid as long as the table is alive and unchanged */
+	FStringView GetCell(const int32 InRow, const int32 InColumn) const
+	{
+		const int32 CellIndex = InRow * ColumnCount + InColumn;
+		const int32 CellStart = CellIndex > 0 ? CellEnds[CellIndex - 1] : 0;
+		return FStringView(Text).Mid(CellStart, CellEnds[CellIndex] - CellStart);
+	}
+
+	void AddCell(const FStringView InText)
+	{
+		Text.Append(InText.GetData(), InText.Len());
+		CellEnds.Add(Text.Len());
+	}
+
+	friend FArchive& operator<<(FArchive& Ar, FTreeSitterMarkdownTable& Table)
+	{
+		return Ar << Table.ColumnCount << Table.Text << Table.CellEnds;
+	}
+};
+
+/** Everything needed to display a block, extracted from the trees ahead of widget creation */
+struct FTreeSitterMarkdownRenderBlock
+{
+	ETreeSitterMarkdownBlockKind Kind = ETreeSitterMarkdownBlockKind::Other;
+
+	/** Block grammar node, for custom widget factories. Valid for as long as the model is. */
+	TSNode Node = {};
+
+	/** See UE::TreeSitter::GetMarkdownBlockKey() */
+	uint64 Key = 0;
+
+	uint32 StartByte = 0;
+	uint32 EndByte = 0;
+
+	/** Headings only, 1 to 6 */
+	int32 HeadingLevel = 0;
+
+	/** Paragraphs: SRichTextBlock markup, see UE::TreeSitter::MakeMarkdownRichText() */
+	FString RichText;
+
+	/** Headings: content, code blocks: code, list items: markers, other blocks: source text */
+	FString Text;
+
+	/** Fenced code blocks: language tag as written, and the matching grammar if there's one */
+	FString CodeInfoString;
+	TOptional<ETreeSitterLanguage> CodeLanguage;
+
+	/** Tables only */
+	FTreeSitterMarkdownTable Table;
+
+	/** Block quotes, lists and list items: nested blocks */
+	TArray<FTreeSitterMarkdownRenderBlock> Children;
+
+	/** Everything but the node, which only lives as long as its tree */
+	friend FArchive& operator<<(FArchive& Ar, FTreeSitterMarkdownRenderBlock& Block);
+};
+
+/**
+ * Intermediate model of a markdown document between its trees and its widgets.
+ *
+ * Parsing, injections and text extraction all happen while building the model, which doesn't touch Slate or the
+ * module and can run on a worker thread. The game thread is left with instantiating widgets out of finished blocks.
+ *
+ * Models can also be serialized (see UTreeSitterMarkdownAsset), in which case they come back without document or
+ * source and can be displayed without parsing anything.
+ */
+class FTreeSitterMarkdownRenderModel
+{
+public:
+	/** Binary format of Serialize(), bump on any change to it or to the blocks */
+	static constexpr int32 SerializationVersion = 2;
+
+	/** Empty model, meant to be filled by Serialize() */
+	FTreeSitterMarkdownRenderModel();
+
+	FTreeSitterMarkdownRenderModel(const TSharedRef<const FTreeSitterMarkdownDocument>& InDocument, const TSharedRef<const FTreeSitterWidgetFactoryTable>& InFactories);
+
+	/**
+	 * Parses the source (incrementally from the previous model when given) and builds its blocks. Safe to call from
+	 * any thread, languages and factories being resolved ahead of time.
+	 */
+	static TSharedRef<FTreeSitterMarkdownRenderModel> Build(
+		const TSharedRef<const FTreeSitterSource>& InSource,
+		const FTreeSitterMarkdownRenderModel* InPreviousModel,
+		const FTreeSitterMarkdownLanguages& InLanguages,
+		const TSharedRef<const FTreeSitterWidgetFactoryTable>& InFactories
+	);
+
+	/** Same as above, resolving languages and factories on the calling (game) thread */
+	static TSharedRef<FTreeSitterMarkdownRenderModel> Build(const TSharedRef<const FTreeSitterSource>& InSource, const FTreeSitterMarkdownRenderModel* InPreviousModel = nullptr);
+
+	/** Resolves languages and factories on the calling (game) thread, then builds the model on a worker */
+	static TFuture<TSharedPtr<FTreeSitterMarkdownRenderModel>> BuildAsync(const TSharedRef<const FTreeSitterSource>& InSource, const TSharedPtr<const FTreeSitterMarkdownRenderModel>& InPreviousModel);
+
+	/** Blocks only, deserialized models have no document to reference nodes from */
+	void Serialize(FArchive& Ar);
+
+	/** Parsed document, null for deserialized models */
+	const TSharedPtr<const FTreeSitterMarkdownDocument>& GetDocument() const;
+	const TSharedRef<const FTreeSitterSource>& GetSource() const;
+	const TSharedRef<const FTreeSitterWidgetFactoryTable>& GetFactories() const;
+
+	/** Top-level blocks, in document order (sections are flattened) */
+	const TArray<FTreeSitterMarkdownRenderBlock>& GetBlocks() const;
+
+private:
+	TSharedPtr<const FTreeSitterMarkdownDocument> Document;
+	TSharedRef<const FTreeSitterSource> Source;
+	TSharedRef<const FTreeSitterWidgetFactoryTable> Factories;
+	TArray<FTreeSitterMarkdownRenderBlock> Blocks;
+};
+
+namespace UE::TreeSitter
+{
+	/** Identity of a block for widget reuse: its symbol and source text, independent of where it sits in the document */
+	uint64 GetMarkdownBlockKey(const TSNode& InNode, const FTreeSitterSource& InSource);
+}
+
+namespace UE::TreeSitter::Private
+{
+	/** Symbols of the block grammar the model is built from, 0 when not found */
+	struct FMarkdownBlockSymbols
+	{
+		const TSLanguage* Language = nullptr;
+
+		TSSymbol Section = 0;
+		TSSymbol Paragraph = 0;
+		TSSymbol AtxHeading = 0;
+		TSSymbol SetextHeading = 0;
+		TSSymbol SetextH1Underline = 0;
+		TSSymbol BlockQuote = 0;
+		TSSymbol List = 0;
+		TSSymbol ListItem = 0;
+		TSSymbol FencedCodeBlock = 0;
+		TSSymbol IndentedCodeBlock = 0;
+		TSSymbol InfoString = 0;
+		TSSymbol LanguageTag = 0;
+		TSSymbol CodeFenceContent = 0;
+		TSSymbol PipeTable = 0;
+		TSSymbol PipeTableHeader = 0;
+		TSSymbol PipeTableRow = 0;
+		TSSymbol PipeTableCell = 0;
+		TSSymbol ThematicBreak = 0;
+
+		/** Markers, delimiters and continuations: syntax only, never displayed as blocks */
+		TBitArray<> SyntaxSymbols;
+
+		explicit FMarkdownBlockSymbols(const TSLanguage* InLanguage);
+
+		bool IsSyntax(const TSSymbol InSymbol) const
+		{
+			return SyntaxSymbols.IsValidIndex(InSymbol) && SyntaxSymbols[InSymbol];
+		}
+	};
+}
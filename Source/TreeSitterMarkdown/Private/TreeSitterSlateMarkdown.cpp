@@ -0,0 +1,157 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#include "TreeSitterSlateMarkdown.h"
+
+#include "ITreeSitterMarkdownModule.h"
+#include "Nodes/STreeSitterMarkdownBlockquote.h"
+#include "Nodes/STreeSitterMarkdownHeading.h"
+#include "Nodes/STreeSitterMarkdownParagraph.h"
+#include "Nodes/STreeSitterMarkdownTable.h"
+#include "TreeSitterMarkdownRenderModel.h"
+#include "TreeSitterNode.h"
+#include "TreeSitterSource.h"
+#include "TreeSitterStats.h"
+#include "Widgets/Layout/SBorder.h"
+#include "Widgets/Layout/SSeparator.h"
+#include "Widgets/SBoxPanel.h"
+#include "Widgets/Text/STextBlock.h"
+#include "tree_sitter/api.h"
+
+TRACE_DECLARE_INT_COUNTER(TreeSitter_MarkdownWidgets, TEXT("TreeSitter/Markdown/Widgets"));
+
+namespace UE::TreeSitter::Private
+{
+	static TSharedRef<SVerticalBox> MakeChildrenWidget(const FTreeSitterMarkdownRenderBlock& InBlock, const FTreeSitterMarkdownRenderModel& InModel, const uint32 InDepth)
+	{
+		TSharedRef<SVerticalBox> Container = SNew(SVerticalBox);
+		for (const FTreeSitterMarkdownRenderBlock& Child : InBlock.Children)
+		{
+			Container->AddSlot()
+			.AutoHeight()
+			[
+				MakeMarkdownBlockWidget(Child, InModel, InDepth + 1)
+			];
+		}
+
+		return Container;
+	}
+
+	/** Unordered list markers are displayed as bullets, ordered ones (and task markers) as written */
+	static FString GetListItemBullet(const FString& InMarkers)
+	{
+		if (InMarkers.StartsWith(TEXT("-")) || InMarkers.StartsWith(TEXT("*")) || InMarkers.StartsWith(TEXT("+")))
+		{
+			return TEXT("•") + InMarkers.RightChop(1);
+		}
+
+		return InMarkers;
+	}
+}
+
+FStringView UE::TreeSitter::ExtractNodeText(const TSNode& InNode, const FTreeSitterSource& InSource)
+{
+	return InSource.GetView(InNode);
+}
+
+TSharedRef<SWidget> UE::TreeSitter::MakeMarkdownBlockWidget(const FTreeSitterMarkdownRenderBlock& InBlock, const FTreeSitterMarkdownRenderModel& InModel, const uint32 InDepth)
+{
+	using namespace UE::TreeSitter::Private;
+
+	TRACE_COUNTER_INCREMENT(TreeSitter_MarkdownWidgets);
+	CSV_CUSTOM_STAT(TreeSitter, MarkdownWidgets, 1, ECsvCustomStatOp::Accumulate);
+
+	switch (InBlock.Kind)
+	{
+	case ETreeSitterMarkdownBlockKind::Custom:
+		// Deserialized models have no nodes to hand over
+		if (ts_node_is_null(InBlock.Node))
+		{
+			return SNullWidget::NullWidget;
+		}
+
+		if (const FTreeSitterOnGetCustomWidgetInstance* Factory = InModel.GetFactories()->Find(ts_node_symbol(InBlock.Node)))
+		{
+			// Only nodes handed over to a factory pay for the FTreeSitterNode copy (and its name lookups)
+			const TSharedRef<FTreeSitterNode> NewNode = MakeShared<FTreeSitterNode>(InBlock.Node, InDepth);
+			return Factory->Execute(NewNode, InModel.GetSource());
+		}
+		return SNullWidget::NullWidget;
+
+	case ETreeSitterMarkdownBlockKind::Paragraph:
+		return SNew(STreeSitterMarkdownParagraph, InBlock);
+
+	case ETreeSitterMarkdownBlockKind::Heading:
+		return SNew(STreeSitterMarkdownHeading, InBlock);
+
+	case ETreeSitterMarkdownBlockKind::BlockQuote:
+		return SNew(STreeSitterMarkdownBlockquote)
+		[
+			MakeChildrenWidget(InBlock, InModel, InDepth)
+		];
+
+	case ETreeSitterMarkdownBlockKind::List:
+		return MakeChildrenWidget(InBlock, InModel, InDepth);
+
+	case ETreeSitterMarkdownBlockKind::ListItem:
+		return SNew(SHorizontalBox)
+			+ SHorizontalBox::Slot()
+			.AutoWidth()
+			.Padding(0.f, 0.f, 6.f, 0.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(GetListItemBullet(InBlock.Text)))
+			]
+			+ SHorizontalBox::Slot()
+			.FillWidth(1.f)
+			[
+				MakeChildrenWidget(InBlock, InModel, InDepth)
+			];
+
+	case ETreeSitterMarkdownBlockKind::CodeBlock:
+		return SNew(SBorder)
+			.BorderImage(FAppStyle::GetBrush("ToolPanel.GroupBorder"))
+			.Padding(8.f)
+			[
+				SNew(STextBlock)
+				.Text(FText::FromString(InBlock.Text))
+				.TextStyle(FAppStyle::Get(), "MessageLog")
+				.ToolTipText(FText::FromString(InBlock.CodeInfoString))
+			];
+
+	case ETreeSitterMarkdownBlockKind::Table:
+		return SNew(STreeSitterMarkdownTable, InBlock);
+
+	case ETreeSitterMarkdownBlockKind::ThematicBreak:
+		return SNew(SSeparator)
+			.Thickness(2.f);
+
+	case ETreeSitterMarkdownBlockKind::Other:
+	default:
+		if (InBlock.Text.IsEmpty())
+		{
+			return SNullWidget::NullWidget;
+		}
+
+		return SNew(STextBlock)
+			.Text(FText::FromString(InBlock.Text))
+			.AutoWrapText(true);
+	}
+}
+
+TSharedRef<SWidget> UE::TreeSitter::GenerateMarkdownSlateWidget(const FTreeSitterMarkdownRenderModel& InModel)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UE::TreeSitter::GenerateMarkdownSlateWidget);
+	CSV_SCOPED_TIMING_STAT(TreeSitter, MarkdownGenerateWidgets);
+
+	TSharedRef<SVerticalBox> Container = SNew(SVerticalBox);
+	for (const FTreeSitterMarkdownRenderBlock& Block : InModel.GetBlocks())
+	{
+		Container->AddSlot()
+		.AutoHeight()
+		[
+			MakeMarkdownBlockWidget(Block, InModel)
+		];
+	}
+
+	return Container;
+}
@@ -0,0 +1,23 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Templates/SharedPointer.h"
+
+class FTreeSitterMarkdownRenderModel;
+class FTreeSitterSource;
+class SWidget;
+struct FTreeSitterMarkdownRenderBlock;
+struct TSNode;
+
+namespace UE::TreeSitter
+{
+	/** Helper Function to Extract Text from a Node, as a view into the source buffer */
+	FStringView ExtractNodeText(const TSNode& InNode, const FTreeSitterSource& InSource);
+
+	/** Creates the widget of a block, along with its nested blocks. Everything is already extracted, this only instantiates widgets. */
+	TSharedRef<SWidget> MakeMarkdownBlockWidget(const FTreeSitterMarkdownRenderBlock& InBlock, const FTreeSitterMarkdownRenderModel& InModel, const uint32 InDepth = 0);
+
+	/** Wrap every block of the model in a container (like SVerticalBox) to display Markdown content */
+	TSharedRef<SWidget> GenerateMarkdownSlateWidget(const FTreeSitterMarkdownRenderModel& InModel);
+}
@@ -0,0 +1,76 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "ITreeSitterModule.h"
+
+class FTreeSitterSource;
+class SWidget;
+struct FTreeSitterNode;
+
+DECLARE_DELEGATE_RetVal_TwoParams(TSharedRef<SWidget>, FTreeSitterOnGetCustomWidgetInstance, const TSharedRef<FTreeSitterNode>&, const TSharedRef<const FTreeSitterSource>&);
+
+/**
+ * Widget factories registered for a language, resolved to a flat array indexed by TSSymbol.
+ *
+ * Built once per language (and rebuilt whenever a factory is registered or unregistered) so that per node dispatch
+ * is a single array load instead of a node name lookup.
+ */
+struct FTreeSitterWidgetFactoryTable
+{
+	/** Language symbols are resolved against */
+	const TSLanguage* Language = nullptr;
+
+	/** Factories indexed by symbol, unbound for symbols without a custom widget */
+	TArray<FTreeSitterOnGetCustomWidgetInstance> Factories;
+
+	const FTreeSitterOnGetCustomWidgetInstance* Find(const TSSymbol InSymbol) const
+	{
+		return Factories.IsValidIndex(InSymbol) && Factories[InSymbol].IsBound() ? &Factories[InSymbol] : nullptr;
+	}
+};
+
+/**
+ * Interface for the markdown to Slate rendering module, and its registry of custom node widgets.
+ */
+class ITreeSitterMarkdownModule : public IModuleInterface
+{
+public:
+	/**
+	 * Singleton-like access to this module's interface.  This is just for convenience!
+	 * Beware of calling this during the shutdown phase, though.  Your module might have been unloaded already.
+	 *
+	 * @return Returns singleton instance, loading the module on demand if needed
+	 */
+	static inline ITreeSitterMarkdownModule& Get()
+	{
+		static const FName ModuleName = "TreeSitterMarkdown";
+		return FModuleManager::LoadModuleChecked<ITreeSitterMarkdownModule>(ModuleName);
+	}
+
+	/**
+	 * Checks to see if this module is loaded and ready.  It is only valid to call Get() during shutdown if IsAvailable() returns true.
+	 *
+	 * @return True if the module is loaded and ready to use
+	 */
+	static inline bool IsAvailable()
+	{
+		static const FName ModuleName = "TreeSitterMarkdown";
+		return FModuleManager::Get().IsModuleLoaded(ModuleName);
+	}
+
+	/** Registers a widget factory for nodes of the given type, in the given language */
+	virtual void RegisterCustomWidget(const ETreeSitterLanguage InLanguage, const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate) = 0;
+	virtual void UnregisterCustomWidget(const ETreeSitterLanguage InLanguage, const FName& InNodeName) = 0;
+
+	/** Returns the symbol indexed factory table for a language. Meant to be fetched once per document, not per node. */
+	virtual TSharedRef<const FTreeSitterWidgetFactoryTable> GetWidgetFactoryTable(const ETreeSitterLanguage InLanguage) = 0;
+
+	virtual void RegisterCustomMarkdownWidget(const FName& InNodeName, const FTreeSitterOnGetCustomWidgetInstance& InCustomWidgetDelegate) = 0;
+	virtual void UnregisterCustomMarkdownWidget(const FName& InNodeName) = 0;
+
+	/** Create widget for a given node type */
+    virtual TSharedRef<SWidget> CreateWidgetForNodeType(const FName& InNodeType, const TSharedRef<FTreeSitterNode>& InNode, const TSharedRef<const FTreeSitterSource>& InSource) = 0;
+
+	virtual bool HasCustomWidgetForNodeType(const FName& InNodeType) = 0;
+};
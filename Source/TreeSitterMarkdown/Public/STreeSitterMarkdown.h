@@ -0,0 +1,96 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SListView.h"
+
+class FTreeSitterMarkdownRenderModel;
+class FTreeSitterSource;
+class SBorder;
+class SVerticalBox;
+struct FTreeSitterMarkdownRenderBlock;
+
+/** Top-level block of the rendered document, keyed by content so that its widget survives unrelated edits */
+struct FTreeSitterMarkdownBlock
+{
+	/** See UE::TreeSitter::GetMarkdownBlockKey() */
+	uint64 Key = 0;
+
+	/** Block of the current render model, refreshed whenever a new model is applied */
+	const FTreeSitterMarkdownRenderBlock* RenderBlock = nullptr;
+
+	/** Generated widget, created on demand in virtualized mode and kept when the block scrolls out of view */
+	TSharedPtr<SWidget> Widget;
+};
+
+class TREESITTERMARKDOWN_API STreeSitterMarkdown : public SCompoundWidget
+{
+public:
+	SLATE_BEGIN_ARGS(STreeSitterMarkdown)
+		: _Virtualized(false)
+		{
+		}
+
+		SLATE_ARGUMENT(FString, InitialMarkdown)
+
+		/** Already built (or deserialized) model to display instead of InitialMarkdown, nothing gets parsed then */
+		SLATE_ARGUMENT(TSharedPtr<const FTreeSitterMarkdownRenderModel>, RenderModel)
+
+		/**
+		 * Document mode: top-level blocks are displayed in a list view and their widgets only built when scrolled
+		 * into view, making large documents (changelogs, docs) cost proportional to what's on screen.
+		 */
+		SLATE_ARGUMENT(bool, Virtualized)
+
+	SLATE_END_ARGS()
+	
+	virtual ~STreeSitterMarkdown() override;
+
+	void Construct(const FArguments& InArgs);
+
+	const TSharedPtr<const FTreeSitterSource>& GetMarkdownSource() const;
+
+	/**
+	 * Reparses the document incrementally on a worker thread, and rebuilds only the blocks that changed once done.
+	 * The previous content stays displayed in the meantime.
+	 */
+	void SetMarkdownSource(const FString& InMarkdownSource);
+	
+	FString GetMarkdownSourceText() const;
+
+	/** Displays an already built model, dropping any build still in flight */
+	void SetRenderModel(const TSharedRef<const FTreeSitterMarkdownRenderModel>& InModel);
+
+private:
+	using SBlockListView = SListView<TSharedPtr<FTreeSitterMarkdownBlock>>;
+
+	/** Last applied render model, keeping its document and trees alive */
+	TSharedPtr<const FTreeSitterMarkdownRenderModel> Model;
+
+	/** Id of the last requested build, results of any earlier one are dropped */
+	uint32 LatestBuildId = 0;
+
+	TSharedPtr<SBorder> Container;
+
+	/** Block container, depending on whether the view is virtualized or not */
+	TSharedPtr<SVerticalBox> BlocksBox;
+	TSharedPtr<SBlockListView> BlocksListView;
+
+	/** Immutable source buffer, shared with (and kept alive by) every generated widget */
+	TSharedPtr<const FTreeSitterSource> MarkdownSource;
+
+	/** Blocks of the current document, in order */
+	TArray<TSharedPtr<FTreeSitterMarkdownBlock>> Blocks;
+
+	bool bVirtualized = false;
+
+	/** Builds the render model of the current source in the background */
+	void RequestBuild();
+
+	/** Updates Blocks out of a finished model, reusing the blocks (and widgets) whose key didn't change */
+	void ApplyModel(const TSharedRef<const FTreeSitterMarkdownRenderModel>& InModel);
+
+	TSharedRef<SWidget> GetOrCreateBlockWidget(FTreeSitterMarkdownBlock& InBlock) const;
+	TSharedRef<ITableRow> GenerateBlockRow(TSharedPtr<FTreeSitterMarkdownBlock> InBlock, const TSharedRef<STableViewBase>& InOwnerTable) const;
+};
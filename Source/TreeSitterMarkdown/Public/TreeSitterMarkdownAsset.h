@@ -0,0 +1,57 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+#pragma once
+
+#include "Engine/EngineTypes.h"
+#include "UObject/Object.h"
+#include "TreeSitterMarkdownAsset.generated.h"
+
+class FTreeSitterMarkdownRenderModel;
+class SWidget;
+
+/**
+ * Markdown document (in-game help, patch notes, ...) compiled ahead of time.
+ *
+ * The markdown source only exists in the editor. Whenever the asset is edited or saved (cooking included), it is parsed
+ * into a render model and that model alone is serialized. At runtime the model is deserialized along with the asset,
+ * and displayed without any grammar or parsing involved.
+ */
+UCLASS(BlueprintType)
+class TREESITTERMARKDOWN_API UTreeSitterMarkdownAsset : public UObject
+{
+	GENERATED_BODY()
+
+public:
+#if WITH_EDITORONLY_DATA
+	/** Markdown file to compile from, relative to the project directory. Takes precedence over Markdown when set. */
+	UPROPERTY(EditAnywhere, Category = "Markdown", meta = (FilePathFilter = "md", RelativeToGameDir))
+	FFilePath SourceFile;
+
+	/** Inline markdown source, used when there's no SourceFile */
+	UPROPERTY(EditAnywhere, Category = "Markdown", meta = (MultiLine = true))
+	FString Markdown;
+#endif
+
+	//~ Begin UObject
+	virtual void Serialize(FArchive& Ar) override;
+#if WITH_EDITOR
+	virtual void PostLoad() override;
+	virtual void PreSave(FObjectPreSaveContext SaveContext) override;
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+	//~ End UObject
+
+#if WITH_EDITOR
+	/** Parses the markdown source and replaces the compiled model with it */
+	void Compile();
+#endif
+
+	/** Creates a widget displaying the compiled document */
+	TSharedRef<SWidget> MakeWidget(const bool bInVirtualized = false) const;
+
+	bool HasRenderModel() const;
+
+private:
+	/** Compiled model, null until compiled or if the serialized one is from an older format */
+	TSharedPtr<const FTreeSitterMarkdownRenderModel> RenderModel;
+};
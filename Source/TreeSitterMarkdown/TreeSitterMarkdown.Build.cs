@@ -0,0 +1,22 @@
+﻿// Copyright 2025 Mickael Daniel. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class TreeSitterMarkdown : ModuleRules
+{
+	public TreeSitterMarkdown(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+				"CoreUObject",
+				"Engine",
+				"Slate",
+				"SlateCore",
+				"TreeSitter",
+				"TreeSitterLibrary", 
+			}
+		);
+	}
+}